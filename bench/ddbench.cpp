@@ -0,0 +1,554 @@
+/**
+ * Standalone benchmark of decision diagram construction and Lagrangian oracle throughput, without the MIP solver
+ */
+
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <sstream>
+#include <sys/resource.h>
+
+#include "getopt.h"
+#include "../src/util/graph.hpp"
+#include "../src/util/options.hpp"
+#include "../src/util/event_counters.hpp"
+#include "../src/bdd/bdd_frozen.hpp"
+#include "../src/core/solver.hpp"
+#include "../src/core/solver_telemetry.hpp"
+#include "../src/problem/indepset/indepset_instance.hpp"
+#include "../src/problem/cliquetable/cliquetable_problem.hpp"
+#include "../src/problem/bp/bp_mergers.hpp"
+#include "../src/lagrangian/lagrangian.hpp"
+#include "../src/lagrangian/lg_subprob_bdd.hpp"
+#include "../src/lagrangian/lg_subprob_std.hpp"
+
+#ifdef SOLVER_SCIP
+#include "../src/problem/bp/bp_problem.hpp"
+#include "../src/problem/bp/bp_reader_scip.hpp"
+#include "../src/problem/bp/prop_linearcons.hpp"
+#endif
+
+using namespace std;
+
+
+/** Wall clock time in seconds since an arbitrary point */
+static double wall_time()
+{
+	return chrono::duration<double>(chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+
+/** Peak resident set size of the process in kilobytes */
+static long peak_rss_kb()
+{
+	struct rusage usage;
+	getrusage(RUSAGE_SELF, &usage);
+	return usage.ru_maxrss;
+}
+
+
+/** Escape a string for a JSON string literal */
+static string json_escape(const string& s)
+{
+	string escaped;
+	for (char c : s) {
+		if (c == '"' || c == '\\') {
+			escaped += '\\';
+			escaped += c;
+		} else if ((unsigned char) c < 0x20) {
+			escaped += ' ';
+		} else {
+			escaped += c;
+		}
+	}
+	return escaped;
+}
+
+
+/** Print a double as a JSON number (null if not finite) */
+static string json_number(double value)
+{
+	if (value != value || value == numeric_limits<double>::infinity() || value == -numeric_limits<double>::infinity()) {
+		return "null";
+	}
+	ostringstream os;
+	os.precision(12);
+	os << value;
+	return os.str();
+}
+
+
+/** Oracle wrapper counting calls and their wall time */
+class CountingOracle : public LagrangianSubproblemOracle
+{
+public:
+	LagrangianSubproblemOracle* oracle;
+	long                        ncalls;
+	double                      time;
+
+	CountingOracle(LagrangianSubproblemOracle* _oracle) : oracle(_oracle), ncalls(0), time(0) {}
+
+	~CountingOracle()
+	{
+		delete oracle;
+	}
+
+	double solve(const vector<double>& obj, vector<int>& optsol)
+	{
+		double start = wall_time();
+		double value = oracle->solve(obj, optsol);
+		time += wall_time() - start;
+		ncalls++;
+		return value;
+	}
+
+	double solve_inexact(const vector<double>& obj, vector<int>& optsol, double& sol_value)
+	{
+		double start = wall_time();
+		double value = oracle->solve_inexact(obj, optsol, sol_value);
+		time += wall_time() - start;
+		ncalls++;
+		return value;
+	}
+
+	double solve_multiple(const vector<double>& obj, int max_nsols, vector<vector<int>>& sols, vector<double>& sol_values)
+	{
+		double start = wall_time();
+		double value = oracle->solve_multiple(obj, max_nsols, sols, sol_values);
+		time += wall_time() - start;
+		ncalls++;
+		return value;
+	}
+};
+
+
+/** Instance loaded for the benchmark, with the constraints that are relaxed in the Lagrangian relaxation */
+struct BenchInstance {
+	string                        problem_type;
+	IndepSetInstance*             indepset_inst;
+	CliqueTableInstance*          ct_inst;
+#ifdef SOLVER_SCIP
+	BPInstance*                   bp_inst;
+#endif
+	vector<double>                obj;
+	vector<LagrangianConstraint>  relaxed_constrs;
+
+	BenchInstance() : indepset_inst(NULL), ct_inst(NULL)
+#ifdef SOLVER_SCIP
+		, bp_inst(NULL)
+#endif
+	{}
+
+	~BenchInstance()
+	{
+		delete ct_inst;
+		delete indepset_inst;
+#ifdef SOLVER_SCIP
+		delete bp_inst;
+#endif
+	}
+
+	/** Create a problem with the ordering and merger from the options */
+	Problem* create_problem(Options* options)
+	{
+		Problem* problem;
+		if (ct_inst != NULL) {
+			problem = new CliqueTableProblem(ct_inst, options);
+			delete problem->ordering;
+			problem->ordering = get_ordering_by_id_ct(options->order_id, ct_inst, *options);
+			if (problem->ordering == NULL) {
+				cout << "Error: invalid variable ordering" << endl;
+				exit(1);
+			}
+			if (options->merge_id >= 0) {
+				delete problem->merger;
+				problem->merger = get_merger_by_id_bp(options->merge_id, options->width);
+				if (problem->merger == NULL) {
+					cout << "Error: invalid merging scheme" << endl;
+					exit(1);
+				}
+			}
+		} else {
+#ifdef SOLVER_SCIP
+			problem = new BinaryProblem(bp_inst, new BPPropLinearcons(bp_inst->rows), options);
+#else
+			problem = NULL;
+#endif
+		}
+		return problem;
+	}
+};
+
+
+/** Read an independent set (.clq) or binary problem (.mps) instance; clique covers or rows are relaxed, respectively */
+static void read_bench_instance(const string& path, bool use_cache, BenchInstance& bench_inst)
+{
+	string extension = path.substr(path.find_last_of(".") + 1);
+
+	if (extension == "clq") {
+		bench_inst.problem_type = "cliquetable";
+		bench_inst.indepset_inst = new IndepSetInstance();
+		bench_inst.indepset_inst->read_DIMACS(path.c_str(), NULL, use_cache);
+		Graph* graph = bench_inst.indepset_inst->graph;
+		bench_inst.ct_inst = new CliqueTableInstance(graph, bench_inst.indepset_inst->weights);
+		bench_inst.obj.assign(bench_inst.indepset_inst->weights, bench_inst.indepset_inst->weights + graph->n_vertices);
+
+		// Clique inequalities of a clique cover are implied by the DD if exact but tighten relaxed DDs
+		vector<vector<int>> cliques;
+		clique_decomposition(graph, cliques);
+		for (const vector<int>& clique : cliques) {
+			if (clique.size() >= 2) {
+				bench_inst.relaxed_constrs.push_back(LagrangianConstraint(clique, vector<double>(clique.size(), 1), 1,
+				                                     LINSENSE_LE));
+			}
+		}
+
+	} else if (extension == "mps") {
+#ifdef SOLVER_SCIP
+		bench_inst.problem_type = "bp";
+		bench_inst.bp_inst = read_bp_instance_scip_mps(path);
+		BPInstance* inst = bench_inst.bp_inst;
+		bench_inst.obj.assign(inst->weights, inst->weights + inst->nvars);
+
+		// Rows are propagated in the DD and relaxed in the Lagrangian relaxation
+		for (BPRow* row : inst->rows) {
+			bench_inst.relaxed_constrs.push_back(LagrangianConstraint(row->ind, row->coeffs, row->rhs,
+			                                     (row->sense == SENSE_LE) ? LINSENSE_LE : LINSENSE_GE));
+		}
+#else
+		cout << "Error: Compilation was done without SCIP; cannot read MPS file" << endl;
+		exit(1);
+#endif
+
+	} else {
+		cout << "Error: Problem type (" << extension << ") not identified" << endl;
+		exit(1);
+	}
+}
+
+
+int main(int argc, char* argv[])
+{
+	Options options;
+	options.quiet = true;
+	int nrepeats = 1;
+	int lag_iters = 0;
+	string json_filename;
+	string save_dd_filename;
+	string load_dd_filename;
+	bool use_cache = false;
+
+	if (argc < 2) {
+		cout << "\nUsage: " << argv[0] << " [options] [instance file]\n";
+		cout << endl;
+		cout << "Builds a decision diagram for an independent set (.clq) or binary problem (.mps) instance without the" << endl;
+		cout << "MIP solver and reports construction and Lagrangian oracle statistics in JSON." << endl;
+		cout << endl;
+		cout << "    -w [width]                maximum decision diagram width (default: no limit)" << endl;
+		cout << "    -o [ordering]             variable ordering id (default: problem default)" << endl;
+		cout << "    -m [merger]               merger id (default: problem default)" << endl;
+		cout << "    --no-long-arcs            do not use long arcs in the construction" << endl;
+		cout << "    --repeat [n]              number of times the decision diagram is built (default: 1)" << endl;
+		cout << "    --lag-iters [n]           oracle calls of a Lagrangian relaxation over clique covers (.clq) or rows (.mps) (default: 0)" << endl;
+		cout << "    --lag-bundle              solve the Lagrangian dual with the built-in bundle method instead of ConicBundle" << endl;
+		cout << "    --lag-time-limit [t]      time limit for the Lagrangian relaxation in seconds (default: 10)" << endl;
+		cout << "    --lag-coarse-width [w]    width of a coarsened DD answering early Lagrangian iterations inexactly" << endl;
+		cout << "    --lag-nsubgradients [n]   number of best DD paths returned as subgradients per oracle call" << endl;
+		cout << "    --instance-cache          read independent set instances from a binary cache next to the instance file" << endl;
+		cout << "    --json [file]             write statistics to a file instead of standard output" << endl;
+		cout << "    --telemetry [file]        write statistics of every layer of every DD built (CSV if .csv, NDJSON otherwise)" << endl;
+		cout << "    --save-dd [file]          write the final DD to a binary file" << endl;
+		cout << "    --load-dd [file]          map a DD written with --save-dd instead of building one; the Lagrangian" << endl;
+		cout << "                              relaxation runs over it as is (no coarsening, one subgradient per call)" << endl;
+		cout << "    -v                        print DD construction information" << endl;
+		cout << endl;
+		exit(1);
+	}
+
+	static struct option long_options[] = {
+#define OPT_NO_LONG_ARCS           0
+#define OPT_REPEAT                 1
+#define OPT_LAG_ITERS              2
+#define OPT_LAG_BUNDLE             3
+#define OPT_LAG_TIME_LIMIT         4
+#define OPT_LAG_COARSE_WIDTH       5
+#define OPT_LAG_NSUBGRADIENTS      6
+#define OPT_INSTANCE_CACHE         7
+#define OPT_JSON                   8
+#define OPT_TELEMETRY              9
+#define OPT_SAVE_DD               10
+#define OPT_LOAD_DD               11
+		{"ordering",               required_argument, 0, 'o'},
+		{"merger",                 required_argument, 0, 'm'},
+		{"width",                  required_argument, 0, 'w'},
+		{"no-long-arcs",           no_argument,       0, OPT_NO_LONG_ARCS},
+		{"repeat",                 required_argument, 0, OPT_REPEAT},
+		{"lag-iters",              required_argument, 0, OPT_LAG_ITERS},
+		{"lag-bundle",             no_argument,       0, OPT_LAG_BUNDLE},
+		{"lag-time-limit",         required_argument, 0, OPT_LAG_TIME_LIMIT},
+		{"lag-coarse-width",       required_argument, 0, OPT_LAG_COARSE_WIDTH},
+		{"lag-nsubgradients",      required_argument, 0, OPT_LAG_NSUBGRADIENTS},
+		{"instance-cache",         no_argument,       0, OPT_INSTANCE_CACHE},
+		{"json",                   required_argument, 0, OPT_JSON},
+		{"telemetry",              required_argument, 0, OPT_TELEMETRY},
+		{"save-dd",                required_argument, 0, OPT_SAVE_DD},
+		{"load-dd",                required_argument, 0, OPT_LOAD_DD},
+		{0, 0, 0, 0}
+	};
+
+	int c;
+	int option_index = 0;
+	while ((c = getopt_long(argc, argv, "m:o:w:v", long_options, &option_index)) != -1) {
+		switch (c) {
+		case 'm':
+			options.merge_id = atoi(optarg);
+			break;
+		case 'o':
+			options.order_id = atoi(optarg);
+			break;
+		case 'w':
+			options.width = atoi(optarg);
+			break;
+		case 'v':
+			options.quiet = false;
+			break;
+		case OPT_NO_LONG_ARCS:
+			options.use_long_arcs = false;
+			break;
+		case OPT_REPEAT:
+			nrepeats = atoi(optarg);
+			if (nrepeats < 1) {
+				cout << "Error: Invalid parameter - number of repetitions must be positive" << endl;
+				exit(1);
+			}
+			break;
+		case OPT_LAG_ITERS:
+			lag_iters = atoi(optarg);
+			break;
+		case OPT_LAG_BUNDLE:
+			options.lag_bundle = true;
+			break;
+		case OPT_LAG_TIME_LIMIT:
+			options.lag_cb_time_limit = atof(optarg);
+			break;
+		case OPT_LAG_COARSE_WIDTH:
+			options.lag_coarse_width = atoi(optarg);
+			break;
+		case OPT_LAG_NSUBGRADIENTS:
+			options.lag_nsubgradients = atoi(optarg);
+			if (options.lag_nsubgradients < 1) {
+				cout << "Error: Invalid parameter - number of subgradients must be positive" << endl;
+				exit(1);
+			}
+			break;
+		case OPT_INSTANCE_CACHE:
+			use_cache = true;
+			break;
+		case OPT_JSON:
+			json_filename = optarg;
+			break;
+		case OPT_TELEMETRY:
+			dd_telemetry = new DDTelemetrySink(optarg);
+			if (!dd_telemetry->is_open()) {
+				cout << "Error: Telemetry file cannot be opened" << endl;
+				exit(1);
+			}
+			break;
+		case OPT_SAVE_DD:
+			save_dd_filename = optarg;
+			break;
+		case OPT_LOAD_DD:
+			load_dd_filename = optarg;
+			break;
+		default:
+			exit(1);
+		}
+	}
+
+	// Multiple subgradients require exact subproblem solves, while the coarse DD only solves them inexactly
+	if (options.lag_nsubgradients > 1 && options.lag_coarse_width > 0) {
+		cout << "Error: Cannot use both multiple subgradients and a coarse DD in the Lagrangian relaxation" << endl;
+		exit(1);
+	}
+
+	// A loaded DD is frozen and its oracle only returns a single solution per subproblem
+	if (options.lag_nsubgradients > 1 && !load_dd_filename.empty()) {
+		cout << "Error: Cannot use both multiple subgradients and a loaded DD in the Lagrangian relaxation" << endl;
+		exit(1);
+	}
+
+	if (optind >= argc) {
+		cout << "Error: Input file not specified" << endl;
+		exit(1);
+	}
+	string instance_path = string(argv[optind]);
+
+	// Progress goes to stderr so that standard output only holds the JSON
+	streambuf* cout_buffer = cout.rdbuf();
+	if (json_filename.empty()) {
+		cout.rdbuf(cerr.rdbuf());
+	}
+
+	double read_start = wall_time();
+	BenchInstance bench_inst;
+	read_bench_instance(instance_path, use_cache, bench_inst);
+	double read_time = wall_time() - read_start;
+
+	// Construction; every repetition builds the DD from a fresh problem since orderings and mergers keep state
+	BDD* bdd = NULL;
+	Problem* problem = NULL;
+	DDSolver* solver = NULL;
+	double total_time = 0;
+	double min_time = numeric_limits<double>::infinity();
+	string ordering_name;
+	string merger_name;
+	for (int r = 0; r < nrepeats && load_dd_filename.empty(); ++r) {
+		delete bdd;
+		delete solver;
+		delete problem;
+		problem = bench_inst.create_problem(&options);
+		ordering_name = problem->ordering->name;
+		merger_name = problem->merger->name;
+		solver = new DDSolver(problem, &options);
+
+		double start = wall_time();
+		bdd = solver->construct_decision_diagram(NULL);
+		double elapsed = wall_time() - start;
+
+		total_time += elapsed;
+		min_time = MIN(min_time, elapsed);
+		if (bdd == NULL) {
+			break;
+		}
+	}
+
+	if (bdd != NULL && !save_dd_filename.empty() && !write_bdd_binary(bdd, save_dd_filename.c_str())) {
+		cout << "Error: DD cannot be written to " << save_dd_filename << endl;
+		exit(1);
+	}
+
+	// Loading replaces construction; the DD is used in place from the mapped file
+	FrozenBDD* frozen_bdd = NULL;
+	double load_time = 0;
+	if (!load_dd_filename.empty()) {
+		double start = wall_time();
+		frozen_bdd = read_bdd_binary(load_dd_filename.c_str());
+		load_time = wall_time() - start;
+		if (frozen_bdd == NULL) {
+			cout << "Error: " << load_dd_filename << " is not a valid DD file" << endl;
+			exit(1);
+		}
+		if (frozen_bdd->nvars() != (int) bench_inst.obj.size()) {
+			cout << "Error: DD in " << load_dd_filename << " has " << frozen_bdd->nvars() << " variables but instance has "
+			     << bench_inst.obj.size() << endl;
+			exit(1);
+		}
+	}
+
+	// Lagrangian relaxation over the final DD
+	long oracle_calls = 0;
+	double oracle_time = 0;
+	double lag_time = 0;
+	double lag_bound = numeric_limits<double>::infinity();
+	if ((bdd != NULL || frozen_bdd != NULL) && lag_iters > 0 && !bench_inst.relaxed_constrs.empty()) {
+		CountingOracle* oracle;
+		if (frozen_bdd != NULL) {
+			oracle = new CountingOracle(new LagrangianSubproblemOracleFrozenBDD(frozen_bdd));
+		} else {
+			oracle = new CountingOracle(create_bdd_oracle(bdd, options.lag_coarse_width));
+		}
+		LagrangianSubproblemStandard* subproblem = new LagrangianSubproblemStandard(bench_inst.obj.size(),
+		        bench_inst.obj, bench_inst.relaxed_constrs, oracle);
+
+		LagrangianRelaxationParams params;
+		params.max_noracleiters = lag_iters;
+		vector<double> multipliers;
+		double start = wall_time();
+		lag_bound = solve_lagrangian_dual(bench_inst.relaxed_constrs, subproblem, &options, params, multipliers);
+		lag_time = wall_time() - start;
+		oracle_calls = oracle->ncalls;
+		oracle_time = oracle->time;
+
+		delete subproblem;
+		delete oracle;
+	}
+
+	// Report
+	ostringstream json;
+	json << "{" << endl;
+	json << "  \"instance\": \"" << json_escape(instance_path) << "\"," << endl;
+	json << "  \"problem\": \"" << bench_inst.problem_type << "\"," << endl;
+	json << "  \"nvars\": " << bench_inst.obj.size() << "," << endl;
+	json << "  \"width_limit\": " << options.width << "," << endl;
+	json << "  \"ordering\": \"" << json_escape(ordering_name) << "\"," << endl;
+	json << "  \"merger\": \"" << json_escape(merger_name) << "\"," << endl;
+	json << "  \"long_arcs\": " << (options.use_long_arcs ? "true" : "false") << "," << endl;
+	json << "  \"read_time\": " << json_number(read_time) << "," << endl;
+	json << "  \"construction\": {" << endl;
+	if (frozen_bdd != NULL) {
+		json << "    \"loaded_from\": \"" << json_escape(load_dd_filename) << "\"," << endl;
+		json << "    \"load_time\": " << json_number(load_time) << "," << endl;
+		json << "    \"relaxed\": " << (frozen_bdd->relaxed ? "true" : "false") << "," << endl;
+		json << "    \"nodes\": " << frozen_bdd->nnodes << "," << endl;
+		json << "    \"arcs\": " << frozen_bdd->count_number_of_arcs() << "," << endl;
+		json << "    \"width\": " << frozen_bdd->get_width() << "," << endl;
+		json << "    \"bound\": " << json_number(frozen_bdd->bound) << endl;
+	} else {
+		json << "    \"repeats\": " << nrepeats << "," << endl;
+		json << "    \"wall_time_mean\": " << json_number(total_time / nrepeats) << "," << endl;
+		json << "    \"wall_time_min\": " << json_number(min_time) << "," << endl;
+		json << "    \"infeasible\": " << (bdd == NULL ? "true" : "false") << "," << endl;
+		if (bdd != NULL) {
+			json << "    \"exact\": " << (solver->final_exact ? "true" : "false") << "," << endl;
+			json << "    \"nodes\": " << bdd->count_number_of_nodes() << "," << endl;
+			json << "    \"arcs\": " << bdd->count_number_of_arcs() << "," << endl;
+			json << "    \"width\": " << bdd->get_width() << "," << endl;
+			json << "    \"final_bytes\": " << solver->final_memory.live() << "," << endl;
+		}
+		json << "    \"peak_bytes\": " << solver->final_peak_memory.live() << "," << endl;
+		json << "    \"bound\": " << json_number(bdd != NULL ? bdd->bound : -numeric_limits<double>::infinity()) << endl;
+	}
+	json << "  }," << endl;
+	json << "  \"lagrangian\": {" << endl;
+	json << "    \"relaxed_constraints\": " << bench_inst.relaxed_constrs.size() << "," << endl;
+	json << "    \"oracle_call_limit\": " << lag_iters << "," << endl;
+	json << "    \"oracle_calls\": " << oracle_calls << "," << endl;
+	json << "    \"oracle_time\": " << json_number(oracle_time) << "," << endl;
+	json << "    \"oracle_time_per_call\": " << json_number(oracle_calls > 0 ? oracle_time / oracle_calls : 0) << "," << endl;
+	json << "    \"wall_time\": " << json_number(lag_time) << "," << endl;
+	json << "    \"bound\": " << json_number(lag_bound) << endl;
+	json << "  }," << endl;
+	if (event_counters_enabled()) {
+		long long counts[NUM_EVENT_COUNTERS];
+		event_counters_collect(counts);
+		json << "  \"events\": {" << endl;
+		for (int i = 0; i < NUM_EVENT_COUNTERS; ++i) {
+			json << "    \"" << event_counter_name((EventCounter) i) << "\": " << counts[i]
+			     << (i < NUM_EVENT_COUNTERS - 1 ? "," : "") << endl;
+		}
+		json << "  }," << endl;
+	}
+	json << "  \"peak_rss_kb\": " << peak_rss_kb() << endl;
+	json << "}" << endl;
+
+	cout.rdbuf(cout_buffer);
+	if (json_filename.empty()) {
+		cout << json.str();
+	} else {
+		ofstream output(json_filename.c_str());
+		if (!output.good()) {
+			cout << "Error: could not write " << json_filename << endl;
+			exit(1);
+		}
+		output << json.str();
+	}
+
+	delete frozen_bdd;
+	delete bdd;
+	delete solver;
+	delete problem;
+	delete dd_telemetry;
+
+	return 0;
+}
@@ -0,0 +1,876 @@
+/**
+ * Micro-benchmarks of the hot kernels of decision diagram construction and Lagrangian oracles
+ */
+
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <new>
+#include <random>
+#include <sstream>
+
+#include "getopt.h"
+#include "../src/util/graph.hpp"
+#include "../src/util/intset.hpp"
+#include "../src/util/options.hpp"
+#include "../src/core/solver.hpp"
+#include "../src/core/solver_callback.hpp"
+#include "../src/bdd/bdd_pass.hpp"
+#include "../src/problem/indepset/indepset_instance.hpp"
+#include "../src/problem/cliquetable/cliquetable_problem.hpp"
+#include "../src/problem/bp/bp_problem.hpp"
+#include "../src/problem/bp/bp_mergers.hpp"
+#include "../src/problem/bp/prop_linearcons.hpp"
+#include "../src/lagrangian/lg_subprob_bdd.hpp"
+#include "../src/lagrangian/lg_subprob_std.hpp"
+
+using namespace std;
+
+
+/*
+ * Allocation counting: every allocation of the process goes through these operators
+ */
+
+static long nallocs = 0;
+
+void* operator new(size_t size)
+{
+	nallocs++;
+	void* p = malloc(size == 0 ? 1 : size);
+	if (p == NULL) {
+		throw bad_alloc();
+	}
+	return p;
+}
+
+void* operator new[](size_t size)
+{
+	return operator new(size);
+}
+
+void operator delete(void* p) noexcept
+{
+	free(p);
+}
+
+void operator delete[](void* p) noexcept
+{
+	free(p);
+}
+
+void operator delete(void* p, size_t) noexcept
+{
+	free(p);
+}
+
+void operator delete[](void* p, size_t) noexcept
+{
+	free(p);
+}
+
+
+/** Wall clock time in seconds since an arbitrary point */
+static double wall_time()
+{
+	return chrono::duration<double>(chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+
+/** Time and allocations of a measured section */
+struct Measurement {
+	double start_time;
+	long   start_nallocs;
+	double time;
+	long   allocs;
+
+	Measurement() : start_time(0), start_nallocs(0), time(0), allocs(0) {}
+
+	void start()
+	{
+		start_nallocs = nallocs;
+		start_time = wall_time();
+	}
+
+	void stop()
+	{
+		time += wall_time() - start_time;
+		allocs += nallocs - start_nallocs;
+	}
+};
+
+
+/** Result of a benchmark: best time per operation over the rounds */
+struct BenchResult {
+	string kernel;
+	string input;
+	int    width;
+	long   nops;
+	double ns_per_op;
+	double allocs_per_op;
+
+	string key() const
+	{
+		return kernel + "\t" + input + "\t" + to_string(width);
+	}
+};
+
+
+/** Benchmark settings */
+struct BenchSettings {
+	int    nrounds      = 5;               /**< rounds per benchmark; the fastest round is reported */
+	double min_time     = 0.05;            /**< minimum time per round (operations are repeated until reached) */
+	int    seed         = 1;               /**< seed for generated inputs and objectives */
+};
+
+
+/** Run body (which performs nops operations and records its measured sections) for a number of rounds */
+template<class Body>
+static BenchResult run_benchmark(const BenchSettings& settings, const string& kernel, const string& input, int width,
+                                 Body body)
+{
+	BenchResult result;
+	result.kernel = kernel;
+	result.input = input;
+	result.width = width;
+	result.nops = 0;
+	result.ns_per_op = numeric_limits<double>::infinity();
+	result.allocs_per_op = 0;
+
+	for (int round = 0; round < settings.nrounds; ++round) {
+		Measurement measurement;
+		long nops = 0;
+		do {
+			nops += body(measurement);
+		} while (nops > 0 && measurement.time < settings.min_time);
+
+		if (nops == 0) {
+			return result;
+		}
+		double ns_per_op = 1e9 * measurement.time / nops;
+		if (ns_per_op < result.ns_per_op) {
+			result.ns_per_op = ns_per_op;
+			result.allocs_per_op = (double) measurement.allocs / nops;
+			result.nops = nops;
+		}
+	}
+	return result;
+}
+
+
+/*
+ * Inputs
+ */
+
+/** Graph with weights; a clique table problem and a binary problem (with a clique cover and a knapsack) are built on it */
+struct BenchInput {
+	string                 name;
+	Graph*                 graph;
+	vector<double>         weights;
+
+	CliqueTableInstance*   ct_inst;
+	BPInstance*            bp_inst;
+	vector<LagrangianConstraint> cover_constrs;   /**< clique cover relaxed in the Lagrangian subproblem */
+
+	BenchInput() : graph(NULL), ct_inst(NULL), bp_inst(NULL) {}
+
+	~BenchInput()
+	{
+		delete ct_inst;
+		delete bp_inst;
+		delete graph;
+	}
+
+	/** Build the problem instances from graph and weights */
+	void create_instances(int seed)
+	{
+		ct_inst = new CliqueTableInstance(graph, weights.data());
+
+		vector<vector<int>> cliques;
+		clique_decomposition(graph, cliques);
+
+		vector<BPVar*> vars;
+		for (int i = 0; i < graph->n_vertices; ++i) {
+			vars.push_back(new BPVar(weights[i], i));
+		}
+		vector<BPRow*> rows;
+		for (const vector<int>& clique : cliques) {
+			if (clique.size() >= 2) {
+				rows.push_back(new BPRow(1, SENSE_LE, vector<double>(clique.size(), 1), clique));
+				cover_constrs.push_back(LagrangianConstraint(clique, vector<double>(clique.size(), 1), 1, LINSENSE_LE));
+			}
+		}
+
+		// A knapsack row so that linear propagation is not limited to set packing rows
+		mt19937 rng(seed);
+		uniform_int_distribution<int> coeff_dist(1, 20);
+		vector<double> coeffs;
+		vector<int> ind;
+		double sum = 0;
+		for (int i = 0; i < graph->n_vertices; ++i) {
+			coeffs.push_back(coeff_dist(rng));
+			ind.push_back(i);
+			sum += coeffs.back();
+		}
+		rows.push_back(new BPRow(floor(sum / 10), SENSE_LE, coeffs, ind));
+
+		for (BPVar* var : vars) {
+			var->init_rows(rows);
+		}
+		bp_inst = new BPInstance(vars, rows);
+	}
+};
+
+
+/** Generate a random graph with integer weights in [1, 100] */
+static BenchInput* generate_input(int n, double density, int seed)
+{
+	BenchInput* input = new BenchInput();
+	ostringstream name;
+	name << "rand_n" << n << "_d" << (int)(100 * density);
+	input->name = name.str();
+
+	mt19937 rng(seed);
+	uniform_real_distribution<double> unif(0, 1);
+	uniform_int_distribution<int> weight_dist(1, 100);
+	input->graph = new Graph(n);
+	for (int i = 0; i < n; ++i) {
+		for (int j = i + 1; j < n; ++j) {
+			if (unif(rng) < density) {
+				input->graph->add_edge(i, j);
+			}
+		}
+	}
+	for (int i = 0; i < n; ++i) {
+		input->weights.push_back(weight_dist(rng));
+	}
+
+	input->create_instances(seed);
+	return input;
+}
+
+
+/** Read a DIMACS graph (.clq) as an input */
+static BenchInput* read_input(const string& path, int seed)
+{
+	BenchInput* input = new BenchInput();
+	input->name = path.substr(path.find_last_of("\\/") + 1);
+
+	IndepSetInstance indepset_inst;
+	indepset_inst.read_DIMACS(path.c_str());
+	input->graph = indepset_inst.graph;
+	input->weights.assign(indepset_inst.weights, indepset_inst.weights + indepset_inst.graph->n_vertices);
+	indepset_inst.graph = NULL;
+
+	input->create_instances(seed);
+	return input;
+}
+
+
+/*
+ * Construction helpers
+ */
+
+/** Copies of the states of each layer taken during construction, with the variable branched on */
+template<class S>
+class StateHarvestCallback : public DDSolverCallback
+{
+public:
+	vector<int>                vars;               /**< variable of each harvested layer */
+	vector<vector<S*>>         states;             /**< copies of the states branched on in each layer */
+	vector<vector<double>>     minactivity;        /**< binary problems only: activities when branching on each layer */
+	vector<vector<double>>     maxactivity;
+	BinaryProblem*             bp_problem;
+
+	StateHarvestCallback(BinaryProblem* _bp_problem = NULL) : bp_problem(_bp_problem) {}
+
+	~StateHarvestCallback()
+	{
+		for (vector<S*>& layer_states : states) {
+			for (S* state : layer_states) {
+				delete state;
+			}
+		}
+	}
+
+	void cb_layer_end(BDD* bdd, const vector<Node*>& nodes_layer, NodeMap& node_list, int width, int current_layer,
+	                  Options* options)
+	{
+		int var = bdd->layer_to_var[current_layer];
+		vars.push_back(var);
+		states.push_back(vector<S*>());
+		for (Node* node : nodes_layer) {
+			states.back().push_back(new S(*dynamic_cast<S*>(node->state)));
+		}
+
+		// Undo the update of the activities at the end of the layer to recover the ones used for branching
+		if (bp_problem != NULL) {
+			minactivity.push_back(bp_problem->minactivity);
+			maxactivity.push_back(bp_problem->maxactivity);
+			BPVar* bpvar = bp_problem->instance->vars[var];
+			for (int i = 0; i < (int) bpvar->rows.size(); ++i) {
+				if (bpvar->row_coeffs[i] < 0) {
+					minactivity.back()[bpvar->rows[i]] += bpvar->row_coeffs[i];
+				} else {
+					maxactivity.back()[bpvar->rows[i]] += bpvar->row_coeffs[i];
+				}
+			}
+		}
+	}
+};
+
+
+/** Merger wrapper measuring the merges of another merger */
+struct MeasuredMerger : Merger {
+	Merger*      merger;
+	Measurement* measurement;
+	long         nnodes;             /**< number of nodes passed to the merger */
+
+	MeasuredMerger(Merger* _merger, Measurement* _measurement) : Merger(_merger->width, _merger->name),
+		merger(_merger), measurement(_measurement), nnodes(0) {}
+
+	~MeasuredMerger()
+	{
+		delete merger;
+	}
+
+	void merge_layer(Problem* prob, int layer, vector<Node*>& nodes_layer)
+	{
+		nnodes += nodes_layer.size();
+		measurement->start();
+		merger->merge_layer(prob, layer, nodes_layer);
+		measurement->stop();
+	}
+};
+
+
+/** Build a clique table DD with the given width; states are kept if a callback is given */
+static BDD* construct_ct(BenchInput* input, int width, DDSolverCallback* callback = NULL, Merger* merger = NULL)
+{
+	Options options;
+	options.quiet = true;
+	options.width = width;
+	options.delete_old_states = (callback == NULL);
+
+	CliqueTableProblem problem(input->ct_inst, &options);
+	if (merger != NULL) {
+		delete problem.merger;
+		problem.merger = merger;
+	}
+	DDSolver solver(&problem, &options);
+	solver.solver_callback = callback;
+	BDD* bdd = solver.construct_decision_diagram(NULL);
+	if (merger != NULL) {
+		problem.merger = NULL;
+	}
+	return bdd;
+}
+
+
+/*
+ * Benchmarks
+ */
+
+/** CliqueTableState::transition on the states of a relaxed DD */
+static BenchResult bench_ct_transition(const BenchSettings& settings, BenchInput* input, int width)
+{
+	Options options;
+	options.width = width;
+	CliqueTableProblem problem(input->ct_inst, &options);
+
+	StateHarvestCallback<CliqueTableState> harvest;
+	delete construct_ct(input, width, &harvest);
+
+	vector<State*> results;
+	return run_benchmark(settings, "ct_transition", input->name, width, [&](Measurement& measurement) {
+		long nops = 0;
+		for (int l = 0; l < (int) harvest.vars.size(); ++l) {
+			results.clear();
+			measurement.start();
+			for (CliqueTableState* state : harvest.states[l]) {
+				for (int val = 0; val <= 1; ++val) {
+					results.push_back(state->transition(&problem, harvest.vars[l], val));
+				}
+			}
+			measurement.stop();
+			nops += 2 * harvest.states[l].size();
+			for (State* result : results) {
+				delete result;
+			}
+		}
+		return nops;
+	});
+}
+
+
+/** BPState::transition with BPPropLinearcons on the states of a relaxed DD */
+static BenchResult bench_bp_transition(const BenchSettings& settings, BenchInput* input, int width)
+{
+	Options options;
+	options.quiet = true;
+	options.width = width;
+	options.delete_old_states = false;
+	BinaryProblem problem(input->bp_inst, new BPPropLinearcons(input->bp_inst->rows), &options);
+
+	StateHarvestCallback<BPState> harvest(&problem);
+	DDSolver solver(&problem, &options);
+	solver.solver_callback = &harvest;
+	delete solver.construct_decision_diagram(NULL);
+
+	vector<State*> results;
+	return run_benchmark(settings, "bp_transition", input->name, width, [&](Measurement& measurement) {
+		long nops = 0;
+		for (int l = 0; l < (int) harvest.vars.size(); ++l) {
+			problem.minactivity = harvest.minactivity[l];
+			problem.maxactivity = harvest.maxactivity[l];
+			results.clear();
+			measurement.start();
+			for (BPState* state : harvest.states[l]) {
+				for (int val = 0; val <= 1; ++val) {
+					results.push_back(state->transition(&problem, harvest.vars[l], val));
+				}
+			}
+			measurement.stop();
+			nops += 2 * harvest.states[l].size();
+			for (State* result : results) {
+				delete result;
+			}
+		}
+		return nops;
+	});
+}
+
+
+/** IntSet::union_with or IntSet::intersect_with on random sets over the literals of the input */
+static BenchResult bench_intset(const BenchSettings& settings, BenchInput* input, bool intersect)
+{
+	int nelems = 2 * input->graph->n_vertices;
+	int nsets = 256;
+	mt19937 rng(settings.seed);
+	uniform_real_distribution<double> unif(0, 1);
+	vector<IntSet> sets(nsets);
+	for (IntSet& set : sets) {
+		set.resize(0, nelems - 1, false);
+		for (int i = 0; i < nelems; ++i) {
+			if (unif(rng) < 0.5) {
+				set.add(i);
+			}
+		}
+	}
+
+	vector<IntSet> targets;
+	return run_benchmark(settings, intersect ? "intset_intersect" : "intset_union", input->name, 0,
+	[&](Measurement& measurement) {
+		targets = sets;
+		measurement.start();
+		for (int i = 0; i < nsets; ++i) {
+			if (intersect) {
+				targets[i].intersect_with(sets[(i + 1) % nsets]);
+			} else {
+				targets[i].union_with(sets[(i + 1) % nsets]);
+			}
+		}
+		measurement.stop();
+		return (long) nsets;
+	});
+}
+
+
+/** NodeMap find and insert on the states created from each layer of a relaxed DD, as in construction */
+static BenchResult bench_nodemap(const BenchSettings& settings, BenchInput* input, int width)
+{
+	Options options;
+	options.width = width;
+	CliqueTableProblem problem(input->ct_inst, &options);
+
+	StateHarvestCallback<CliqueTableState> harvest;
+	delete construct_ct(input, width, &harvest);
+
+	// Children of each layer, including the duplicates that construction finds in the node map
+	vector<vector<State*>> children(harvest.vars.size());
+	for (int l = 0; l < (int) harvest.vars.size(); ++l) {
+		for (CliqueTableState* state : harvest.states[l]) {
+			for (int val = 0; val <= 1; ++val) {
+				State* child = state->transition(&problem, harvest.vars[l], val);
+				if (child != NULL) {
+					children[l].push_back(child);
+				}
+			}
+		}
+	}
+
+	BenchResult result = run_benchmark(settings, "nodemap_find_insert", input->name, width,
+	[&](Measurement& measurement) {
+		long nops = 0;
+		for (int l = 0; l < (int) children.size(); ++l) {
+			NodeMap node_list;
+			measurement.start();
+			for (State* child : children[l]) {
+				if (node_list.find(child) == node_list.end()) {
+					node_list[child] = NULL;
+				}
+			}
+			measurement.stop();
+			nops += children[l].size();
+		}
+		return nops;
+	});
+
+	for (vector<State*>& layer_children : children) {
+		for (State* child : layer_children) {
+			delete child;
+		}
+	}
+	return result;
+}
+
+
+/** Merger given by id (as in get_merger_by_id_bp) in clique table construction; time per node passed to the merger */
+static BenchResult bench_merger(const BenchSettings& settings, BenchInput* input, int width, int merger_id)
+{
+	Merger* named_merger = get_merger_by_id_bp(merger_id, width);
+	string name = named_merger->name;
+	delete named_merger;
+	return run_benchmark(settings, "merge_" + name, input->name, width, [&](Measurement& measurement) {
+		MeasuredMerger* merger = new MeasuredMerger(get_merger_by_id_bp(merger_id, width), &measurement);
+		delete construct_ct(input, width, NULL, merger);
+		long nnodes = merger->nnodes;
+		delete merger;
+		return nnodes;
+	});
+}
+
+
+/** Random objective for the oracle benchmarks */
+static vector<double> random_objective(int nvars, int seed)
+{
+	mt19937 rng(seed);
+	uniform_real_distribution<double> unif(-1, 1);
+	vector<double> obj(nvars);
+	for (double& c : obj) {
+		c = unif(rng);
+	}
+	return obj;
+}
+
+
+/** BDD::get_optimal_sol on a relaxed DD; time per arc */
+static BenchResult bench_optimal_sol(const BenchSettings& settings, BenchInput* input, int width, BDD* bdd)
+{
+	vector<double> obj = random_objective(input->graph->n_vertices, settings.seed);
+	long narcs = bdd->count_number_of_arcs();
+	vector<int> sol;
+	return run_benchmark(settings, "bdd_get_optimal_sol", input->name, width, [&](Measurement& measurement) {
+		measurement.start();
+		bdd->get_optimal_sol(obj, sol, true);
+		measurement.stop();
+		return narcs;
+	});
+}
+
+
+/** Top-down bdd_pass computing longest paths on a relaxed DD; time per arc */
+static BenchResult bench_pass(const BenchSettings& settings, BenchInput* input, int width, BDD* bdd)
+{
+	vector<double> obj = random_objective(input->graph->n_vertices, settings.seed);
+	long narcs = bdd->count_number_of_arcs();
+	LongestPathPassFunc func(obj);
+	return run_benchmark(settings, "bdd_pass", input->name, width, [&](Measurement& measurement) {
+		measurement.start();
+		bdd_pass(bdd, &func, NULL);
+		bdd_pass_clean_up(bdd);
+		measurement.stop();
+		return narcs;
+	});
+}
+
+
+/** LagrangianSubproblemStandard::solve relaxing a clique cover over a relaxed DD; time per arc */
+static BenchResult bench_lagrangian_solve(const BenchSettings& settings, BenchInput* input, int width, BDD* bdd)
+{
+	LagrangianSubproblemOracleBDD oracle(bdd);
+	LagrangianSubproblemStandard subproblem(input->graph->n_vertices, input->weights, input->cover_constrs, &oracle);
+
+	mt19937 rng(settings.seed);
+	uniform_real_distribution<double> unif(0, 1);
+	vector<double> lambdas(input->cover_constrs.size());
+	for (double& lambda : lambdas) {
+		lambda = unif(rng);
+	}
+
+	long narcs = bdd->count_number_of_arcs();
+	vector<int> sol;
+	return run_benchmark(settings, "lagrangian_solve", input->name, width, [&](Measurement& measurement) {
+		measurement.start();
+		subproblem.solve(lambdas, sol);
+		measurement.stop();
+		return narcs;
+	});
+}
+
+
+/*
+ * Baseline comparison
+ */
+
+/** Write results as tab-separated values */
+static void write_results(ostream& os, const vector<BenchResult>& results)
+{
+	os << "kernel\tinput\twidth\tns_per_op\tallocs_per_op\tnops" << endl;
+	for (const BenchResult& result : results) {
+		os << result.key() << "\t" << fixed << setprecision(3) << result.ns_per_op << "\t" << result.allocs_per_op
+		   << "\t" << result.nops << endl;
+	}
+}
+
+
+/** Compare results against a baseline file; return the number of regressions */
+static int compare_with_baseline(const string& filename, const vector<BenchResult>& results, double tolerance)
+{
+	ifstream input(filename.c_str());
+	if (!input.good()) {
+		cout << "Error: could not open baseline file " << filename << endl;
+		exit(1);
+	}
+
+	map<string, pair<double, double>> baseline;
+	string line;
+	getline(input, line); // header
+	while (getline(input, line)) {
+		istringstream fields(line);
+		string kernel, input_name, width;
+		double ns_per_op, allocs_per_op;
+		getline(fields, kernel, '\t');
+		getline(fields, input_name, '\t');
+		getline(fields, width, '\t');
+		if (fields >> ns_per_op >> allocs_per_op) {
+			baseline[kernel + "\t" + input_name + "\t" + width] = make_pair(ns_per_op, allocs_per_op);
+		}
+	}
+
+	int nregressions = 0;
+	cout << endl << "Comparison with baseline " << filename << " (tolerance " << fixed << setprecision(1) << 100 * tolerance
+	     << "%):" << endl;
+	for (const BenchResult& result : results) {
+		auto it = baseline.find(result.key());
+		if (it == baseline.end()) {
+			continue;
+		}
+		double ratio = result.ns_per_op / it->second.first;
+		bool slower = (ratio > 1 + tolerance);
+		bool more_allocs = (result.allocs_per_op > it->second.second * (1 + tolerance) + 1e-9);
+		cout << "  " << left << setw(28) << result.kernel << setw(28) << result.input << right << setw(6) << result.width
+		     << "  time x" << fixed << setprecision(3) << ratio
+		     << "  allocs " << it->second.second << " -> " << result.allocs_per_op;
+		if (slower || more_allocs) {
+			cout << "  REGRESSION";
+			nregressions++;
+		}
+		cout << endl;
+	}
+	return nregressions;
+}
+
+
+/** Parse a comma-separated list of integers */
+static vector<int> parse_int_list(const char* list)
+{
+	vector<int> values;
+	istringstream stream(list);
+	string token;
+	while (getline(stream, token, ',')) {
+		values.push_back(atoi(token.c_str()));
+	}
+	return values;
+}
+
+
+int main(int argc, char* argv[])
+{
+	BenchSettings settings;
+	vector<int> widths = {10, 100};
+	string kernel_filter;
+	string save_filename;
+	string baseline_filename;
+	double tolerance = 0.1;
+	bool generated = true;
+
+	static struct option long_options[] = {
+#define OPT_WIDTHS                 0
+#define OPT_ROUNDS                 1
+#define OPT_MIN_TIME               2
+#define OPT_SEED                   3
+#define OPT_FILTER                 4
+#define OPT_SAVE                   5
+#define OPT_BASELINE               6
+#define OPT_TOLERANCE              7
+#define OPT_NO_GENERATED           8
+#define OPT_HELP                   9
+		{"widths",                 required_argument, 0, OPT_WIDTHS},
+		{"rounds",                 required_argument, 0, OPT_ROUNDS},
+		{"min-time",               required_argument, 0, OPT_MIN_TIME},
+		{"seed",                   required_argument, 0, OPT_SEED},
+		{"filter",                 required_argument, 0, OPT_FILTER},
+		{"save",                   required_argument, 0, OPT_SAVE},
+		{"baseline",               required_argument, 0, OPT_BASELINE},
+		{"tolerance",              required_argument, 0, OPT_TOLERANCE},
+		{"no-generated",           no_argument,       0, OPT_NO_GENERATED},
+		{"help",                   no_argument,       0, OPT_HELP},
+		{0, 0, 0, 0}
+	};
+
+	int c;
+	int option_index = 0;
+	while ((c = getopt_long(argc, argv, "", long_options, &option_index)) != -1) {
+		switch (c) {
+		case OPT_WIDTHS:
+			widths = parse_int_list(optarg);
+			break;
+		case OPT_ROUNDS:
+			settings.nrounds = atoi(optarg);
+			break;
+		case OPT_MIN_TIME:
+			settings.min_time = atof(optarg);
+			break;
+		case OPT_SEED:
+			settings.seed = atoi(optarg);
+			break;
+		case OPT_FILTER:
+			kernel_filter = optarg;
+			break;
+		case OPT_SAVE:
+			save_filename = optarg;
+			break;
+		case OPT_BASELINE:
+			baseline_filename = optarg;
+			break;
+		case OPT_TOLERANCE:
+			tolerance = atof(optarg);
+			break;
+		case OPT_NO_GENERATED:
+			generated = false;
+			break;
+		case OPT_HELP:
+			cout << "\nUsage: " << argv[0] << " [options] [.clq files]\n";
+			cout << endl;
+			cout << "Runs micro-benchmarks of DD kernels on generated graphs and on the given DIMACS graphs (e.g. from" << endl;
+			cout << "experiments/instances) and reports time and allocations per operation." << endl;
+			cout << endl;
+			cout << "    --widths [w1,w2,...]      widths of the relaxed DDs benchmarked (default: 10,100)" << endl;
+			cout << "    --rounds [n]              rounds per benchmark; the fastest is reported (default: 5)" << endl;
+			cout << "    --min-time [t]            minimum time per round in seconds (default: 0.05)" << endl;
+			cout << "    --seed [s]                seed for generated inputs and objectives (default: 1)" << endl;
+			cout << "    --filter [str]            only run kernels whose name contains this string" << endl;
+			cout << "    --no-generated            do not run on generated graphs" << endl;
+			cout << "    --save [file]             write results to a tab-separated file, usable as a baseline" << endl;
+			cout << "    --baseline [file]         compare with a saved baseline; exit with status 2 on regressions" << endl;
+			cout << "    --tolerance [r]           relative slowdown or allocation increase flagged as regression (default: 0.1)" << endl;
+			cout << endl;
+			exit(1);
+		default:
+			exit(1);
+		}
+	}
+
+	if (settings.nrounds < 1 || widths.empty()) {
+		cout << "Error: Invalid parameter - rounds and widths must be positive" << endl;
+		exit(1);
+	}
+
+	// Inputs; instance reading output goes to stderr so that standard output only holds results
+	streambuf* cout_buffer = cout.rdbuf();
+	cout.rdbuf(cerr.rdbuf());
+	vector<BenchInput*> inputs;
+	if (generated) {
+		inputs.push_back(generate_input(150, 0.25, settings.seed));
+		inputs.push_back(generate_input(300, 0.1, settings.seed));
+	}
+	for (int i = optind; i < argc; ++i) {
+		inputs.push_back(read_input(argv[i], settings.seed));
+	}
+	cout.rdbuf(cout_buffer);
+
+	auto selected = [&](const string& kernel) {
+		return kernel_filter.empty() || kernel.find(kernel_filter) != string::npos;
+	};
+
+	vector<BenchResult> results;
+	auto report = [&](const BenchResult& result) {
+		// Kernels with no operations (e.g. mergers on DDs that never exceed the width) are not reported
+		if (result.nops == 0) {
+			return;
+		}
+		cout << left << setw(28) << result.kernel << setw(28) << result.input << right << setw(6) << result.width
+		     << fixed << setprecision(1) << setw(14) << result.ns_per_op << " ns/op"
+		     << setprecision(2) << setw(10) << result.allocs_per_op << " allocs/op" << endl;
+		results.push_back(result);
+	};
+
+	for (BenchInput* input : inputs) {
+		if (selected("intset_union")) {
+			report(bench_intset(settings, input, false));
+		}
+		if (selected("intset_intersect")) {
+			report(bench_intset(settings, input, true));
+		}
+
+		for (int width : widths) {
+			if (selected("ct_transition")) {
+				report(bench_ct_transition(settings, input, width));
+			}
+			if (selected("bp_transition")) {
+				report(bench_bp_transition(settings, input, width));
+			}
+			if (selected("nodemap_find_insert")) {
+				report(bench_nodemap(settings, input, width));
+			}
+			for (int merger_id = 1; merger_id <= 5; ++merger_id) {
+				Merger* merger = get_merger_by_id_bp(merger_id, width);
+				string kernel = "merge_" + merger->name;
+				delete merger;
+				if (selected(kernel)) {
+					report(bench_merger(settings, input, width, merger_id));
+				}
+			}
+
+			BDD* bdd = construct_ct(input, width);
+			if (bdd == NULL) {
+				continue;
+			}
+			if (selected("bdd_get_optimal_sol")) {
+				report(bench_optimal_sol(settings, input, width, bdd));
+			}
+			if (selected("bdd_pass")) {
+				report(bench_pass(settings, input, width, bdd));
+			}
+			if (selected("lagrangian_solve")) {
+				report(bench_lagrangian_solve(settings, input, width, bdd));
+			}
+			delete bdd;
+		}
+	}
+
+	if (!save_filename.empty()) {
+		ofstream output(save_filename.c_str());
+		if (!output.good()) {
+			cout << "Error: could not write " << save_filename << endl;
+			exit(1);
+		}
+		write_results(output, results);
+	}
+
+	int nregressions = 0;
+	if (!baseline_filename.empty()) {
+		nregressions = compare_with_baseline(baseline_filename, results, tolerance);
+		cout << nregressions << " regression(s)" << endl;
+	}
+
+	for (BenchInput* input : inputs) {
+		delete input;
+	}
+
+	return (nregressions > 0) ? 2 : 0;
+}
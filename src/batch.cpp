@@ -0,0 +1,322 @@
+/**
+ * Solving of single instances, and of batches of instances within one process
+ */
+
+#include <glob.h>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <sstream>
+#include <thread>
+
+#include "batch.hpp"
+#include "util/stats.hpp"
+#include "util/util.hpp"
+#include "util/worker_pool.hpp"
+#include "problem/indepset/indepset_instance.hpp"
+#include "problem/cliquetable/cliquetable_bb.hpp"
+
+#ifdef SOLVER_SCIP
+#include "ip/ip_scip.hpp"
+#include "problem/bp/bp_model_scip.hpp"
+#include "problem/indepset/indepset_model_scip.hpp"
+#endif
+
+using namespace std;
+
+
+/** Return the extension of an instance file */
+static
+string get_instance_extension(const string& instance_path)
+{
+	string instance_filename = instance_path.substr(instance_path.find_last_of("\\/") + 1);
+	return instance_filename.substr(instance_filename.find_last_of(".") + 1);
+}
+
+
+/** Solve an independent set instance with the parallel DD branch-and-bound */
+static
+void solve_dd_bb(IndepSetInstance* indepset_inst, Options* options, SolveResult* result)
+{
+	CliqueTableInstance* inst = new CliqueTableInstance(indepset_inst->graph, indepset_inst->weights);
+	CliqueTableBBProblemFactory factory(inst);
+	ParallelDDBranchAndBound bb(&factory, options, options->bb_nthreads);
+
+	Stats stats;
+	stats.register_name("time");
+	stats.start_timer(0);
+	double primal_bound = bb.solve();
+	stats.end_timer(0);
+
+	if (result != NULL) {
+		// Same status names as the MIP solver; if not stopped by time, subproblems were left at the memory limit
+		if (bb.solved) {
+			result->status = "optimal";
+		} else {
+			result->status = bb.time_limit_reached ? "timelimit" : "memlimit";
+		}
+		result->primal_bound = primal_bound;
+		result->dual_bound = bb.dual_bound;
+		result->time = stats.get_time(0);
+		result->nnodes = bb.nsubproblems;
+		delete inst;
+		return;
+	}
+
+	cout << endl;
+	cout << "DD branch-and-bound:" << endl;
+	cout << "  Threads: " << bb.nthreads << endl;
+	cout << "  Solved: " << (bb.solved ? "yes" : "no") << endl;
+	cout << "  Primal bound: " << primal_bound << endl;
+	cout << "  Dual bound: " << bb.dual_bound << endl;
+	cout << "  Subproblems: " << bb.nsubproblems << endl;
+	cout << "  Subproblems pruned: " << bb.nsubproblems_pruned << endl;
+	cout << "  Subproblems stolen: " << bb.nsteals << endl;
+	cout << endl;
+
+	delete inst;
+}
+
+
+void check_instance(const string& instance_path, Options* options)
+{
+	ifstream input(instance_path);
+	if (!input.good()) {
+		cout << "Error: Input file " << instance_path << " cannot be opened" << endl;
+		exit(1);
+	}
+
+	string instance_extension = get_instance_extension(instance_path);
+	if (options->run_dd_bb && instance_extension != "clq") {
+		cout << "Error: DD branch-and-bound is only supported for independent set instances (.clq)" << endl;
+		exit(1);
+	}
+	if (instance_extension != "mps" && instance_extension != "clq") {
+		cout << "Error: Problem type (" << instance_extension << ") not identified" << endl;
+		exit(1);
+	}
+#ifndef SOLVER_SCIP
+	if (instance_extension == "mps") {
+		cout << "Error: Compilation was done without SCIP; cannot read MPS file" << endl;
+		exit(1);
+	}
+	if (!options->run_dd_bb) {
+		cout << "Error: Compilation was done without SCIP; cannot run IP model" << endl;
+		exit(1);
+	}
+#endif
+}
+
+
+void solve_instance(const string& instance_path, Options* options, SolveResult* result)
+{
+	string instance_filename = instance_path.substr(instance_path.find_last_of("\\/") + 1);
+	string instance_extension = get_instance_extension(instance_path);
+
+#ifdef SOLVER_SCIP
+	SCIP_RETCODE retcode = SCIP_OKAY;
+#endif
+	if (instance_extension == "mps") {
+#ifdef SOLVER_SCIP
+		BPModelScip model_builder(instance_path);
+		retcode = solve_ip(&model_builder, options, result);
+#endif
+	} else if (instance_extension == "clq") {
+		IndepSetInstance* inst = new IndepSetInstance();
+		inst->read_DIMACS(instance_path.c_str(), NULL, options->instance_cache);
+		if (result == NULL) {
+			cout << "\n\n*** Independent set - " << instance_filename << " ***" << endl;
+		}
+		if (options->run_dd_bb) {
+			solve_dd_bb(inst, options, result);
+			delete inst;
+			return;
+		}
+#ifdef SOLVER_SCIP
+		IndepSetOptions indepset_options;
+		IndepSetModelScip model_builder(inst, &indepset_options);
+		options->max_rounds_root = 10;
+		retcode = solve_ip(&model_builder, options, result);
+#endif
+		delete inst;
+	}
+
+#ifdef SOLVER_SCIP
+	if (retcode != SCIP_OKAY && result != NULL) {
+		result->status = "error";
+	}
+#endif
+}
+
+
+void read_batch_manifest(const char* filename, vector<string>& instances, vector<BatchOptionSet>& option_sets)
+{
+	ifstream input(filename);
+	if (!input.good()) {
+		cout << "Error: Batch manifest " << filename << " cannot be opened" << endl;
+		exit(1);
+	}
+
+	string line;
+	int line_number = 0;
+	while (getline(input, line)) {
+		line_number++;
+		istringstream tokens(line);
+		string keyword;
+		if (!(tokens >> keyword) || keyword[0] == '#') {
+			continue;
+		}
+
+		if (keyword == "set") {
+			BatchOptionSet option_set;
+			if (!(tokens >> option_set.name)) {
+				cout << "Error: Batch manifest line " << line_number << " - option set without a name" << endl;
+				exit(1);
+			}
+			for (const BatchOptionSet& other : option_sets) {
+				if (other.name == option_set.name) {
+					cout << "Error: Batch manifest line " << line_number << " - option set " << option_set.name
+					     << " defined twice" << endl;
+					exit(1);
+				}
+			}
+			string arg;
+			while (tokens >> arg) {
+				option_set.args.push_back(arg);
+			}
+			option_sets.push_back(option_set);
+
+		} else if (keyword == "instance") {
+			string pattern;
+			if (!(tokens >> pattern)) {
+				cout << "Error: Batch manifest line " << line_number << " - instance without a path" << endl;
+				exit(1);
+			}
+			glob_t matches;
+			if (glob(pattern.c_str(), 0, NULL, &matches) != 0) {
+				cout << "Error: Batch manifest line " << line_number << " - no instance matches " << pattern << endl;
+				exit(1);
+			}
+			for (size_t i = 0; i < matches.gl_pathc; ++i) {
+				instances.push_back(matches.gl_pathv[i]);
+			}
+			globfree(&matches);
+
+		} else {
+			cout << "Error: Batch manifest line " << line_number << " - unknown keyword " << keyword << endl;
+			exit(1);
+		}
+	}
+}
+
+
+/** Apply the per-job limits of batch mode to the options of a job */
+static
+void apply_batch_limits(Options* options)
+{
+	if (options->batch_time_limit >= 0) {
+		options->mip_time_limit = options->batch_time_limit;
+		options->bb_time_limit = options->batch_time_limit;
+	}
+
+	// Jobs already run concurrently, so each job runs on as few threads as possible: the DD branch-and-bound and the
+	// asynchronous DD bounds use a single thread unless set otherwise, and decomposed subproblems are solved sequentially
+	if (options->run_dd_bb && options->bb_nthreads == 0) {
+		options->bb_nthreads = 1;
+	}
+	if (options->lag_async_nthreads == 0) {
+		options->lag_async_nthreads = 1;
+	}
+	if (options->lag_decompose_nthreads > 1) {
+		options->lag_decompose_nthreads = 1;
+	}
+
+	// The MIP solver and each DD construction are limited separately; the DD branch-and-bound builds one DD per thread
+	if (options->batch_memory_limit >= 0) {
+		options->mip_memory_limit = options->batch_memory_limit;
+		double dd_memory_limit = options->batch_memory_limit;
+		if (options->run_dd_bb) {
+			dd_memory_limit /= options->bb_nthreads;
+		}
+		if (options->dd_memory_limit < 0 || dd_memory_limit < options->dd_memory_limit) {
+			options->dd_memory_limit = dd_memory_limit;
+		}
+	}
+
+	// Concurrent jobs would interleave their construction output
+	options->quiet = true;
+	options->bounds_verbose = false;
+}
+
+
+/** Write a field of a CSV table, quoting it if needed */
+static
+void write_csv_field(ostream& out, const string& field)
+{
+	if (field.find_first_of(",\"") == string::npos) {
+		out << field;
+		return;
+	}
+	out << '"';
+	for (char c : field) {
+		if (c == '"') {
+			out << '"';
+		}
+		out << c;
+	}
+	out << '"';
+}
+
+
+void run_batch(vector<BatchJob>& jobs, int nthreads, const char* output_filename)
+{
+	if (nthreads <= 0) {
+		nthreads = MAX(1, (int) thread::hardware_concurrency());
+	}
+	nthreads = MIN(nthreads, MAX(1, (int) jobs.size()));
+
+	ofstream output(output_filename);
+	if (!output.good()) {
+		cout << "Error: Batch results file " << output_filename << " cannot be written" << endl;
+		exit(1);
+	}
+
+	for (BatchJob& job : jobs) {
+		apply_batch_limits(&job.options);
+	}
+
+	cout << "Running " << jobs.size() << " jobs on " << nthreads << " threads" << endl;
+
+	mutex progress_lock;
+	int nfinished = 0;
+
+	// The calling thread is one of the workers
+	WorkerPool pool(nthreads - 1);
+	pool.run(jobs.size(), [&](int i) {
+		BatchJob& job = jobs[i];
+		solve_instance(job.instance_path, &job.options, &job.result);
+
+		lock_guard<mutex> guard(progress_lock);
+		nfinished++;
+		cout << "[" << nfinished << "/" << jobs.size() << "] " << job.instance_path << " (" << job.set_name << "): "
+		     << job.result.status << ", primal " << job.result.primal_bound << ", dual " << job.result.dual_bound
+		     << ", " << job.result.time << " s" << endl;
+	});
+
+	output << setprecision(12);
+	output << "instance,set,status,primal_bound,dual_bound,time,nodes,";
+	write_output_stats_csv_header(output);
+	output << endl;
+	for (BatchJob& job : jobs) {
+		write_csv_field(output, job.instance_path);
+		output << ",";
+		write_csv_field(output, job.set_name);
+		output << "," << job.result.status << "," << job.result.primal_bound << "," << job.result.dual_bound << ","
+		       << job.result.time << "," << job.result.nnodes << ",";
+		write_output_stats_csv(output, &job.result.output_stats);
+		output << endl;
+	}
+
+	cout << "Batch results written to " << output_filename << endl;
+}
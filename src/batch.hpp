@@ -0,0 +1,56 @@
+/**
+ * Solving of single instances, and of batches of instances within one process
+ */
+
+#ifndef BATCH_HPP_
+#define BATCH_HPP_
+
+#include <string>
+#include <vector>
+
+#include "util/options.hpp"
+#include "util/output_stats.hpp"
+
+using namespace std;
+
+
+/** Named set of command line options from a batch manifest */
+struct BatchOptionSet {
+	string                        name;
+	vector<string>                args;
+};
+
+/** Job of a batch: one instance solved with one option set */
+struct BatchJob {
+	string                        instance_path;
+	string                        set_name;
+	Options                       options;        /**< options of the job (owned by job) */
+	SolveResult                   result;
+};
+
+
+/** Check that an instance file exists and that its problem type, given by the extension, can be solved with the options */
+void check_instance(const string& instance_path, Options* options);
+
+/**
+ * Solve an instance, identifying the problem through the file extension. If result is NULL, the solve prints its
+ * progress and statistics; otherwise it is silent and its summary is stored in result.
+ */
+void solve_instance(const string& instance_path, Options* options, SolveResult* result = NULL);
+
+/**
+ * Read a batch manifest. Each line either defines an option set as "set [name] [options]" or adds instances as
+ * "instance [path]", where the path may be a glob pattern relative to the current directory. Blank lines and lines
+ * starting with # are ignored.
+ */
+void read_batch_manifest(const char* filename, vector<string>& instances, vector<BatchOptionSet>& option_sets);
+
+/**
+ * Run the jobs of a batch on a pool of nthreads threads (0: number of cores), each job with its own solver, and write
+ * a table with the results of all jobs to output_filename (CSV). Per-job limits are taken from the batch options of
+ * each job.
+ */
+void run_batch(vector<BatchJob>& jobs, int nthreads, const char* output_filename);
+
+
+#endif /* BATCH_HPP_ */
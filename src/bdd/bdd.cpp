@@ -2,8 +2,11 @@
  * Main decision diagram structure
  */
 
+#include <algorithm>
 #include <iostream>
 #include <cassert>
+#include <limits>
+#include <queue>
 #include "bdd.hpp"
 #include "../util/util.hpp"
 #include "../util/stats.hpp"
@@ -301,6 +304,111 @@ void BDD::remove_pathless_nodes()
 }
 
 
+BDD* BDD::create_coarsening(int width)
+{
+	assert(width >= 1);
+	int bdd_size = layers.size();
+	int root_layer = get_root_layer();
+
+	BDD* coarse = new BDD();
+	coarse->layers.resize(bdd_size);
+	coarse->layer_to_var = layer_to_var;
+	coarse->var_to_layer = var_to_layer;
+	coarse->bound = bound;
+
+	// Each coarse node represents a set of nodes of this BDD. A member in a later layer than the coarse node stands
+	// for a long arc into it and only continues with a 0-arc.
+	vector<vector<Node*>> members(1, vector<Node*>(1, layers[root_layer][0]));
+	coarse->create_node(root_layer);
+
+	for (int layer = root_layer; layer < bdd_size - 1; ++layer) {
+
+		// Sets of children for each coarse node and arc value
+		map<vector<Node*>, int> candidate_index;
+		vector<vector<Node*>> candidates;
+		vector<vector<int>> arc_candidate(members.size(), vector<int>(2, -1));
+		for (int k = 0; k < (int) members.size(); ++k) {
+			for (int val = 0; val <= 1; ++val) {
+				vector<Node*> children;
+				for (Node* member : members[k]) {
+					Node* child;
+					if (member->layer > layer) {
+						child = (val == 0) ? member : NULL;
+					} else {
+						child = (val == 0) ? member->zero_arc : member->one_arc;
+					}
+					if (child != NULL) {
+						children.push_back(child);
+					}
+				}
+				if (children.empty()) {
+					continue;
+				}
+				sort(children.begin(), children.end());
+				children.erase(unique(children.begin(), children.end()), children.end());
+
+				map<vector<Node*>, int>::iterator it = candidate_index.find(children);
+				if (it == candidate_index.end()) {
+					it = candidate_index.insert(make_pair(children, (int) candidates.size())).first;
+					candidates.push_back(children);
+				}
+				arc_candidate[k][val] = it->second;
+			}
+		}
+
+		// Keep the sets containing the nodes with the largest longest paths and merge the rest into a single node
+		int ncandidates = candidates.size();
+		vector<int> candidate_to_node(ncandidates);
+		vector<vector<Node*>> next_members;
+		if (ncandidates <= width) {
+			for (int c = 0; c < ncandidates; ++c) {
+				candidate_to_node[c] = c;
+			}
+			next_members.swap(candidates);
+		} else {
+			vector<pair<double, int>> order(ncandidates);
+			for (int c = 0; c < ncandidates; ++c) {
+				double value = -numeric_limits<double>::infinity();
+				for (Node* member : candidates[c]) {
+					value = MAX(value, member->longest_path);
+				}
+				order[c] = make_pair(-value, c);
+			}
+			sort(order.begin(), order.end());
+
+			next_members.resize(width);
+			for (int i = 0; i < ncandidates; ++i) {
+				int c = order[i].second;
+				int node_index = MIN(i, width - 1);
+				candidate_to_node[c] = node_index;
+				next_members[node_index].insert(next_members[node_index].end(), candidates[c].begin(), candidates[c].end());
+			}
+			vector<Node*>& merged = next_members[width - 1];
+			sort(merged.begin(), merged.end());
+			merged.erase(unique(merged.begin(), merged.end()), merged.end());
+		}
+
+		for (int k = 0; k < (int) next_members.size(); ++k) {
+			Node* node = coarse->create_node(layer + 1);
+			node->relaxed_node = (ncandidates > width && k == width - 1);
+		}
+		for (int k = 0; k < (int) members.size(); ++k) {
+			for (int val = 0; val <= 1; ++val) {
+				if (arc_candidate[k][val] >= 0) {
+					Node* child = coarse->layers[layer + 1][candidate_to_node[arc_candidate[k][val]]];
+					coarse->layers[layer][k]->assign_arc(child, val);
+				}
+			}
+		}
+
+		members.swap(next_members);
+	}
+
+	coarse->constructed = true;
+	return coarse;
+}
+
+
 
 // Computation of properties
 
@@ -430,6 +538,85 @@ double BDD::get_optimal_path_zero_one_coeffs(vector<double> zero_coeffs, vector<
 }
 
 
+void BDD::get_k_best_sols(const vector<double>& coeffs_var, int k, vector<vector<int>>& sols, vector<double>& values)
+{
+	int bdd_size = layers.size();
+	assert((int) coeffs_var.size() == nvars());
+
+	sols.clear();
+	values.clear();
+
+	vector<double> one_coeffs(nvars());
+	for (int var = 0; var < nvars(); ++var) {
+		one_coeffs[var_to_layer[var]] = coeffs_var[var];
+	}
+
+	// Longest path from each node to the terminal, stored in lp_value
+	for (int layer = bdd_size - 1; layer >= 0; --layer) {
+		for (Node* node : layers[layer]) {
+			if (node->zero_arc == NULL && node->one_arc == NULL) {
+				node->lp_value = (layer == bdd_size - 1) ? 0 : -numeric_limits<double>::infinity();
+				continue;
+			}
+			node->lp_value = -numeric_limits<double>::infinity();
+			if (node->zero_arc != NULL) {
+				node->lp_value = MAX(node->lp_value, node->zero_arc->lp_value);
+			}
+			if (node->one_arc != NULL) {
+				node->lp_value = MAX(node->lp_value, one_coeffs[layer] + node->one_arc->lp_value);
+			}
+		}
+	}
+
+	Node* root = get_root_node();
+	if (root->lp_value == -numeric_limits<double>::infinity()) {
+		return;
+	}
+
+	// Partial paths from the root form a tree; each entry is (node, weight so far, parent entry, arc from parent)
+	struct PartialPath {
+		Node*  node;
+		double value;
+		int    parent;
+		int    arc_val;
+	};
+	vector<PartialPath> paths;
+	priority_queue<pair<double, int>> queue;
+
+	paths.push_back({root, 0, -1, -1});
+	queue.push(make_pair(root->lp_value, 0));
+
+	while (!queue.empty() && (int) sols.size() < k) {
+		int i = queue.top().second;
+		queue.pop();
+		Node* node = paths[i].node;
+
+		if (node->layer == bdd_size - 1) {
+			vector<int> path(bdd_size - 1, 0); // zero by default to consider long arcs
+			for (int j = i; paths[j].parent >= 0; j = paths[j].parent) {
+				path[paths[paths[j].parent].node->layer] = paths[j].arc_val;
+			}
+			sols.push_back(vector<int>(bdd_size - 1));
+			for (int layer = 0; layer < bdd_size - 1; ++layer) {
+				sols.back()[layer_to_var[layer]] = path[layer];
+			}
+			values.push_back(paths[i].value);
+			continue;
+		}
+
+		for (int val = 0; val <= 1; ++val) {
+			Node* child = (val == 0) ? node->zero_arc : node->one_arc;
+			if (child == NULL || child->lp_value == -numeric_limits<double>::infinity()) {
+				continue;
+			}
+			double value = paths[i].value + ((val == 1) ? one_coeffs[node->layer] : 0);
+			paths.push_back({child, value, i, val});
+			queue.push(make_pair(value + child->lp_value, (int) paths.size() - 1));
+		}
+	}
+}
+
+
 double BDD::compute_path_value(vector<double> zero_coeffs, vector<double> one_coeffs, vector<int>& path)
 {
 	double value = 0;
@@ -446,6 +633,29 @@ double BDD::compute_path_value(vector<double> zero_coeffs, vector<double> one_co
 }
 
 
+bool BDD::contains_path(const vector<int>& path)
+{
+	int bdd_size = layers.size();
+	assert((int) path.size() == bdd_size - 1);
+
+	Node* node = get_root_node();
+	for (int layer = get_root_layer(); layer < bdd_size - 1; ++layer) {
+		if (node->layer > layer) {
+			// Long arc: skipped layers are zero
+			if (path[layer] != 0) {
+				return false;
+			}
+			continue;
+		}
+		node = (path[layer] == 1) ? node->one_arc : node->zero_arc;
+		if (node == NULL) {
+			return false;
+		}
+	}
+	return true;
+}
+
+
 void BDD::identify_fixed_layers(vector<int>& layers_fixed_to_zero, vector<int>& layers_fixed_to_one)
 {
 	int bdd_size = layers.size();
@@ -616,3 +826,81 @@ bool BDD::empty_data_check()
 	}
 	return true;
 }
+
+
+BDD* create_product_bdd(const vector<vector<int>>& component_vars, const vector<vector<vector<int>>>& component_sols,
+                        const vector<double>& obj)
+{
+	int nvars = 0;
+	for (const vector<int>& vars : component_vars) {
+		nvars += vars.size();
+	}
+
+	BDD* bdd = new BDD();
+	bdd->layers.resize(nvars + 1);
+	bdd->layer_to_var.resize(nvars);
+	bdd->var_to_layer.resize(nvars);
+	bdd->create_node(0)->longest_path = 0;
+
+	int layer = 0;
+	for (int c = 0; c < (int) component_vars.size(); ++c) {
+		const vector<int>& vars = component_vars[c];
+		const vector<vector<int>>& sols = component_sols[c];
+		int size = vars.size();
+		if (sols.empty()) {
+			delete bdd;
+			return NULL;
+		}
+		if (size == 0) {
+			continue;
+		}
+
+		for (int k = 0; k < size; ++k) {
+			bdd->layer_to_var[layer + k] = vars[k];
+			bdd->var_to_layer[vars[k]] = layer + k;
+		}
+
+		// Trie of the solutions: each node holds the solutions with the prefix of its path in the component
+		Node* sink = bdd->create_node(layer + size);
+		sink->longest_path = -numeric_limits<double>::infinity();
+		vector<pair<Node*, vector<int>>> prefixes(1, make_pair(bdd->layers[layer][0], vector<int>()));
+		for (int s = 0; s < (int) sols.size(); ++s) {
+			prefixes[0].second.push_back(s);
+		}
+
+		for (int k = 0; k < size; ++k) {
+			vector<pair<Node*, vector<int>>> next_prefixes;
+			for (pair<Node*, vector<int>>& prefix : prefixes) {
+				Node* node = prefix.first;
+				for (int val = 0; val <= 1; ++val) {
+					vector<int> child_sols;
+					for (int s : prefix.second) {
+						if (sols[s][k] == val) {
+							child_sols.push_back(s);
+						}
+					}
+					if (child_sols.empty()) {
+						continue;
+					}
+					double value = node->longest_path + ((val == 1) ? obj[vars[k]] : 0);
+					if (k == size - 1) {
+						node->assign_arc(sink, val);
+						sink->longest_path = MAX(sink->longest_path, value);
+					} else {
+						Node* child = bdd->create_node(layer + k + 1);
+						child->longest_path = value;
+						node->assign_arc(child, val);
+						next_prefixes.push_back(make_pair(child, child_sols));
+					}
+				}
+			}
+			prefixes.swap(next_prefixes);
+		}
+
+		layer += size;
+	}
+
+	bdd->bound = bdd->layers[nvars][0]->longest_path;
+	bdd->constructed = true;
+	return bdd;
+}
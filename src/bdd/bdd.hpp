@@ -99,6 +99,13 @@ public:
 	/** Remove all nodes that are not in a path from root to terminal */
 	void remove_pathless_nodes();
 
+	/**
+	 * Create a relaxation of this BDD with at most the given width by merging sets of nodes top-down: nodes with the
+	 * largest longest path are kept separate and the remaining ones are merged. Every path of this BDD is a path of the
+	 * returned BDD, which has no long arcs. Node states and data are not copied.
+	 */
+	BDD* create_coarsening(int width);
+
 
 	// Computation of properties
 
@@ -126,9 +133,20 @@ public:
 	double get_optimal_path_zero_one_coeffs(vector<double> zero_coeffs, vector<double> one_coeffs,
 	                                        vector<int>& optimal_path, bool maximize, bool ignore_relaxed_nodes = false);
 
+	/**
+	 * Stores in sols up to k solutions of maximum weight in nonincreasing order, using as weights coeffs_var for 1-arcs,
+	 * and their weights in values. Solutions are in the variable space. Paths are enumerated lazily by a best-first search
+	 * whose priorities are exact (weight so far plus longest path to the terminal), so each solution takes at most one
+	 * expansion per layer.
+	 */
+	void get_k_best_sols(const vector<double>& coeffs_var, int k, vector<vector<int>>& sols, vector<double>& values);
+
 	/** Compute the center of a BDD */
 	void get_center(vector<double>& center); // Requires GMP
 
+	/** Return true if the path, given in layer space, is a path of the BDD */
+	bool contains_path(const vector<int>& path);
+
 	/** Identify layers that only have 0-arcs or only have 1-arcs */
 	void identify_fixed_layers(vector<int>& layers_fixed_to_zero, vector<int>& layers_fixed_to_one);
 
@@ -173,6 +191,13 @@ struct LessThanStatePointers {
 
 typedef map<State*, Node*, LessThanStatePointers> NodeMap;
 
+/** Approximate number of bytes held by a node map, excluding nodes and states */
+inline size_t nodemap_memory_size(const NodeMap& node_map)
+{
+	// Each entry is a red-black tree node: key-value pair plus three pointers and a color
+	return sizeof(NodeMap) + node_map.size() * (sizeof(NodeMap::value_type) + 4 * sizeof(void*));
+}
+
 
 /**
  * Node comparator by longest path (decreasing order)
@@ -188,4 +213,14 @@ struct CompareNodesLongestPath {
 };
 
 
+/**
+ * Create an exact BDD over components of variables that share no constraint, given all solutions of each component:
+ * component_sols[c][s][k] is the value of variable component_vars[c][k] in the s-th solution of component c. Each
+ * component becomes a trie of its solutions ending in a single node, which is the root of the next component. Longest
+ * paths and the bound are computed with respect to obj. Return NULL if some component has no solution.
+ */
+BDD* create_product_bdd(const vector<vector<int>>& component_vars, const vector<vector<vector<int>>>& component_sols,
+                        const vector<double>& obj);
+
+
 #endif /* BDD_HPP_ */
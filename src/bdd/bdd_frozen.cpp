@@ -0,0 +1,450 @@
+/**
+ * Binary serialization of decision diagrams, and read-only frozen decision diagrams mapped from binary files
+ */
+
+#include <algorithm>
+#include <cassert>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <thread>
+#include <unistd.h>
+
+#include "bdd_frozen.hpp"
+
+using namespace std;
+
+
+static const char FROZEN_BDD_MAGIC[8] = {'D', 'D', 'O', 'P', 'T', 'B', 'D', 'D'};
+static const uint32_t FROZEN_BDD_VERSION = 1;
+
+
+/** Size of an array in the binary file, including the padding up to the next array */
+static size_t padded_size(size_t size)
+{
+	return (size + 7) & ~((size_t) 7);
+}
+
+
+/** Write an array to a binary file followed by its padding; return false on failure */
+static bool write_padded(FILE* output, const void* data, size_t size)
+{
+	static const char zeros[8] = {0};
+	if (size > 0 && fwrite(data, size, 1, output) != 1) {
+		return false;
+	}
+	size_t padding = padded_size(size) - size;
+	return padding == 0 || fwrite(zeros, padding, 1, output) == 1;
+}
+
+
+bool write_bdd_binary(BDD* bdd, const char* filename)
+{
+	assert(bdd->constructed);
+
+	int bdd_size = bdd->layers.size();
+	int nvars = bdd->nvars();
+
+	FrozenBDDHeader header;
+	memset(&header, 0, sizeof(header));
+	memcpy(header.magic, FROZEN_BDD_MAGIC, sizeof(header.magic));
+	header.version = FROZEN_BDD_VERSION;
+	header.nlayers = bdd_size;
+	header.nvars = nvars;
+	header.bound = bdd->bound;
+
+	vector<uint32_t> layer_offsets(bdd_size + 1, 0);
+	for (int layer = 0; layer < bdd_size; ++layer) {
+		layer_offsets[layer + 1] = layer_offsets[layer] + bdd->layers[layer].size();
+	}
+	header.nnodes = layer_offsets[bdd_size];
+	if (header.nnodes >= FROZEN_BDD_NO_CHILD) {
+		return false;
+	}
+
+	vector<int32_t> layer_to_var(bdd->layer_to_var.begin(), bdd->layer_to_var.end());
+	vector<int32_t> var_to_layer(bdd->var_to_layer.begin(), bdd->var_to_layer.end());
+	layer_to_var.resize(nvars, -1);
+	var_to_layer.resize(nvars, -1);
+
+	// Nodes are numbered by their position in the layers; ids are consistent with positions once the DD is constructed
+	vector<uint32_t> zero_child(header.nnodes, FROZEN_BDD_NO_CHILD);
+	vector<uint32_t> one_child(header.nnodes, FROZEN_BDD_NO_CHILD);
+	vector<uint8_t> relaxed_node(header.nnodes, 0);
+	for (int layer = 0; layer < bdd_size; ++layer) {
+		int size = bdd->layers[layer].size();
+		for (int k = 0; k < size; ++k) {
+			Node* node = bdd->layers[layer][k];
+			uint32_t index = layer_offsets[layer] + k;
+			assert(node->id == k);
+			if (node->zero_arc != NULL) {
+				assert(bdd->layers[node->zero_arc->layer][node->zero_arc->id] == node->zero_arc);
+				zero_child[index] = layer_offsets[node->zero_arc->layer] + node->zero_arc->id;
+			}
+			if (node->one_arc != NULL) {
+				assert(bdd->layers[node->one_arc->layer][node->one_arc->id] == node->one_arc);
+				one_child[index] = layer_offsets[node->one_arc->layer] + node->one_arc->id;
+			}
+			if (node->relaxed_node) {
+				relaxed_node[index] = 1;
+				header.flags |= FROZEN_BDD_RELAXED;
+			}
+		}
+	}
+
+	// Write to a temporary file and rename it so that a partially written file is never read
+	string tmp_file = string(filename) + ".tmp." + to_string(getpid()) + "."
+	                  + to_string(hash<thread::id>()(this_thread::get_id()));
+	FILE* output = fopen(tmp_file.c_str(), "wb");
+	if (output == NULL) {
+		return false;
+	}
+
+	bool ok = write_padded(output, &header, sizeof(header));
+	ok = ok && write_padded(output, layer_offsets.data(), sizeof(uint32_t) * layer_offsets.size());
+	ok = ok && write_padded(output, layer_to_var.data(), sizeof(int32_t) * nvars);
+	ok = ok && write_padded(output, var_to_layer.data(), sizeof(int32_t) * nvars);
+	ok = ok && write_padded(output, zero_child.data(), sizeof(uint32_t) * header.nnodes);
+	ok = ok && write_padded(output, one_child.data(), sizeof(uint32_t) * header.nnodes);
+	ok = ok && write_padded(output, relaxed_node.data(), sizeof(uint8_t) * header.nnodes);
+	ok = (fclose(output) == 0) && ok;
+
+	if (!ok || rename(tmp_file.c_str(), filename) != 0) {
+		remove(tmp_file.c_str());
+		return false;
+	}
+	return true;
+}
+
+
+FrozenBDD* read_bdd_binary(const char* filename)
+{
+	MappedFile* input = new MappedFile(filename);
+	if (!input->is_open() || input->size() < sizeof(FrozenBDDHeader)) {
+		delete input;
+		return NULL;
+	}
+
+	FrozenBDDHeader header;
+	memcpy(&header, input->begin(), sizeof(header));
+	if (memcmp(header.magic, FROZEN_BDD_MAGIC, sizeof(header.magic)) != 0 || header.version != FROZEN_BDD_VERSION
+	        || header.nlayers == 0 || header.nvars != header.nlayers - 1 || header.nnodes >= FROZEN_BDD_NO_CHILD) {
+		delete input;
+		return NULL;
+	}
+
+	size_t nnodes = header.nnodes;
+	size_t expected_size = padded_size(sizeof(header)) + padded_size(sizeof(uint32_t) * (header.nlayers + 1))
+	                       + 2 * padded_size(sizeof(int32_t) * header.nvars) + 2 * padded_size(sizeof(uint32_t) * nnodes)
+	                       + padded_size(sizeof(uint8_t) * nnodes);
+	if (input->size() != expected_size) {
+		delete input;
+		return NULL;
+	}
+
+	// The mapping is page-aligned and every array starts at a multiple of 8 bytes, so arrays can be used in place
+	FrozenBDD* bdd = new FrozenBDD(input);
+	bdd->nlayers = header.nlayers;
+	bdd->nnodes = header.nnodes;
+	bdd->bound = header.bound;
+	bdd->relaxed = (header.flags & FROZEN_BDD_RELAXED);
+
+	const char* pos = input->begin() + padded_size(sizeof(header));
+	bdd->layer_offsets = reinterpret_cast<const uint32_t*>(pos);
+	pos += padded_size(sizeof(uint32_t) * (header.nlayers + 1));
+	bdd->layer_to_var = reinterpret_cast<const int32_t*>(pos);
+	pos += padded_size(sizeof(int32_t) * header.nvars);
+	bdd->var_to_layer = reinterpret_cast<const int32_t*>(pos);
+	pos += padded_size(sizeof(int32_t) * header.nvars);
+	bdd->zero_child = reinterpret_cast<const uint32_t*>(pos);
+	pos += padded_size(sizeof(uint32_t) * nnodes);
+	bdd->one_child = reinterpret_cast<const uint32_t*>(pos);
+	pos += padded_size(sizeof(uint32_t) * nnodes);
+	bdd->relaxed_node = reinterpret_cast<const uint8_t*>(pos);
+
+	// Validate the structure so that queries never read outside of the arrays: a single root, children in later layers.
+	// This reads every child once, which is still much cheaper than constructing the DD.
+	bool valid = (bdd->layer_offsets[0] == 0 && bdd->layer_offsets[bdd->nlayers] == nnodes);
+	for (uint32_t layer = 0; valid && layer < bdd->nlayers; ++layer) {
+		valid = (bdd->layer_offsets[layer] <= bdd->layer_offsets[layer + 1]);
+	}
+	for (int var = 0; valid && var < bdd->nvars(); ++var) {
+		int layer = bdd->var_to_layer[var];
+		valid = (layer >= 0 && layer < bdd->nvars() && bdd->layer_to_var[layer] == var);
+	}
+	valid = valid && (nnodes > 0);
+	if (valid) {
+		int root_layer = bdd->get_root_layer();
+		valid = (bdd->layer_offsets[root_layer + 1] - bdd->layer_offsets[root_layer] == 1);
+	}
+	for (uint32_t layer = 0; valid && layer < bdd->nlayers; ++layer) {
+		for (uint32_t node = bdd->layer_offsets[layer]; valid && node < bdd->layer_offsets[layer + 1]; ++node) {
+			uint32_t zero = bdd->zero_child[node];
+			uint32_t one = bdd->one_child[node];
+			valid = (zero == FROZEN_BDD_NO_CHILD || (zero >= bdd->layer_offsets[layer + 1] && zero < nnodes))
+			        && (one == FROZEN_BDD_NO_CHILD || (one >= bdd->layer_offsets[layer + 1] && one < nnodes));
+		}
+	}
+	if (!valid) {
+		delete bdd;
+		return NULL;
+	}
+
+	return bdd;
+}
+
+
+FrozenBDD::~FrozenBDD()
+{
+	delete file;
+}
+
+
+int FrozenBDD::get_node_layer(uint32_t node) const
+{
+	assert(node < nnodes);
+	return upper_bound(layer_offsets, layer_offsets + nlayers + 1, node) - layer_offsets - 1;
+}
+
+
+// Informational functions
+
+long FrozenBDD::count_number_of_arcs() const
+{
+	long narcs = 0;
+	for (uint64_t node = 0; node < nnodes; ++node) {
+		if (zero_child[node] != FROZEN_BDD_NO_CHILD) {
+			narcs++;
+		}
+		if (one_child[node] != FROZEN_BDD_NO_CHILD) {
+			narcs++;
+		}
+	}
+	return narcs;
+}
+
+
+int FrozenBDD::get_width() const
+{
+	int width = 0;
+	for (uint32_t layer = 0; layer < nlayers; ++layer) {
+		width = MAX(width, (int)(layer_offsets[layer + 1] - layer_offsets[layer]));
+	}
+	return width;
+}
+
+
+int FrozenBDD::get_root_layer() const
+{
+	int initial_layer = -1;
+	for (uint32_t layer = 0; layer < nlayers; ++layer) {
+		if (layer_offsets[layer + 1] > layer_offsets[layer]) {
+			initial_layer = layer;
+			break;
+		}
+	}
+	assert(initial_layer >= 0); // Assumes given DD is nonempty
+	return initial_layer;
+}
+
+
+// Computation of properties
+
+double FrozenBDD::get_optimal_path(const vector<double>& coeffs_layer, vector<int>& optimal_path, bool maximize,
+                                   bool ignore_relaxed_nodes /* = false */) const
+{
+	vector<double> zero_coeffs(coeffs_layer.size(), 0);
+	return get_optimal_path_zero_one_coeffs(zero_coeffs, coeffs_layer, optimal_path, maximize,
+	                                        ignore_relaxed_nodes);
+}
+
+
+double FrozenBDD::get_optimal_sol(const vector<double>& coeffs_var, vector<int>& optimal_sol, bool maximize,
+                                  bool ignore_relaxed_nodes /* = false */) const
+{
+	vector<double> zero_coeffs(coeffs_var.size(), 0);
+
+	// Convert from variable space to layer space
+	vector<double> one_coeffs(coeffs_var.size(), 0);
+	for (int var = 0; var < (int) coeffs_var.size(); ++var) {
+		one_coeffs[var_to_layer[var]] = coeffs_var[var];
+	}
+
+	// Get optimal path
+	vector<int> optimal_path;
+	double opt_val = get_optimal_path_zero_one_coeffs(zero_coeffs, one_coeffs, optimal_path, maximize,
+	                 ignore_relaxed_nodes);
+
+	// Convert path from layer space to variable space
+	int size = optimal_path.size();
+	optimal_sol.resize(size);
+	for (int layer = 0; layer < size; ++layer) {
+		optimal_sol[layer_to_var[layer]] = optimal_path[layer];
+	}
+
+	return opt_val;
+}
+
+
+double FrozenBDD::get_optimal_path_zero_one_coeffs(const vector<double>& zero_coeffs, const vector<double>& one_coeffs,
+        vector<int>& optimal_path, bool maximize, bool ignore_relaxed_nodes /* = false */) const
+{
+	assert((int) zero_coeffs.size() == nvars());
+	assert((int) one_coeffs.size() == nvars());
+
+	optimal_path.resize(0);
+	double worst = maximize ? -numeric_limits<double>::infinity() : numeric_limits<double>::infinity();
+
+	// Values and parents are kept outside of the DD so that concurrent queries do not interfere
+	vector<double> lp_value(nnodes, worst);
+	vector<uint32_t> lp_parent(nnodes, FROZEN_BDD_NO_CHILD);
+	vector<uint8_t> lp_parent_arctype(nnodes, 0);
+
+	int initial_layer = get_root_layer();
+	lp_value[layer_offsets[initial_layer]] = 0;
+
+	// Compute weights; nodes are in layer order, so every parent is processed before its children
+	for (uint32_t layer = initial_layer; layer < nlayers; ++layer) {
+		for (uint32_t node = layer_offsets[layer]; node < layer_offsets[layer + 1]; ++node) {
+			if (ignore_relaxed_nodes && relaxed_node[node]) {
+				continue;
+			}
+			uint32_t zero = zero_child[node];
+			if (zero != FROZEN_BDD_NO_CHILD) {
+				double value = lp_value[node] + zero_coeffs[layer];
+				if ((maximize && value > lp_value[zero]) || (!maximize && value < lp_value[zero])) {
+					lp_value[zero] = value;
+					lp_parent[zero] = node;
+					lp_parent_arctype[zero] = 0;
+				}
+			}
+			uint32_t one = one_child[node];
+			if (one != FROZEN_BDD_NO_CHILD) {
+				double value = lp_value[node] + one_coeffs[layer];
+				if ((maximize && value > lp_value[one]) || (!maximize && value < lp_value[one])) {
+					lp_value[one] = value;
+					lp_parent[one] = node;
+					lp_parent_arctype[one] = 1;
+				}
+			}
+		}
+	}
+
+	// Extract optimal path
+	uint32_t terminal_layer = nlayers - 1;
+	if (layer_offsets[terminal_layer] == layer_offsets[terminal_layer + 1]) {
+		return worst;
+	}
+	uint32_t node = layer_offsets[terminal_layer];
+
+	if (lp_parent[node] == FROZEN_BDD_NO_CHILD) {
+		// Terminal node was unreachable due to pruning + skipping relaxed nodes
+		return worst;
+	}
+
+	optimal_path.assign(nlayers - 1, 0); // Set everything to zero to consider long arcs
+	while (lp_parent[node] != FROZEN_BDD_NO_CHILD) {
+		optimal_path[get_node_layer(lp_parent[node])] = lp_parent_arctype[node];
+		node = lp_parent[node];
+	}
+	assert(node == layer_offsets[initial_layer]);
+
+	return lp_value[layer_offsets[terminal_layer]];
+}
+
+
+// Conversion functions
+
+BDD* FrozenBDD::create_bdd() const
+{
+	BDD* bdd = new BDD();
+	bdd->layers.resize(nlayers);
+	bdd->layer_to_var.assign(layer_to_var, layer_to_var + nvars());
+	bdd->var_to_layer.assign(var_to_layer, var_to_layer + nvars());
+	bdd->bound = bound;
+
+	vector<Node*> nodes(nnodes);
+	for (uint32_t layer = 0; layer < nlayers; ++layer) {
+		for (uint32_t node = layer_offsets[layer]; node < layer_offsets[layer + 1]; ++node) {
+			nodes[node] = bdd->create_node(layer);
+			nodes[node]->relaxed_node = relaxed_node[node];
+		}
+	}
+	for (uint64_t node = 0; node < nnodes; ++node) {
+		if (zero_child[node] != FROZEN_BDD_NO_CHILD) {
+			nodes[node]->assign_zero_arc(nodes[zero_child[node]]);
+		}
+		if (one_child[node] != FROZEN_BDD_NO_CHILD) {
+			nodes[node]->assign_one_arc(nodes[one_child[node]]);
+		}
+	}
+
+	bdd->constructed = true;
+	return bdd;
+}
+
+
+void frozen_bdd_pass(const FrozenBDD* bdd, BDDPassFunc* top_down, BDDPassFunc* bottom_up, vector<BDDPassValues>& values)
+{
+	if (top_down == NULL && bottom_up == NULL) {
+		cout << "Warning: Top-down/bottom-up pass attempted without required functions" << endl;
+		return; // Nothing needs to be done
+	}
+
+	assert(bdd->nnodes > 0);
+
+	// Initialize auxiliary variables
+	BDDPassValues init;
+	init.top_down_val = (top_down != NULL) ? top_down->init_val() : 0;
+	init.bottom_up_val = (bottom_up != NULL) ? bottom_up->init_val() : 0;
+	values.assign(bdd->nnodes, init);
+
+	// Top-down pass
+	if (top_down != NULL) {
+		values[bdd->layer_offsets[bdd->get_root_layer()]].top_down_val = top_down->start_val();
+
+		for (uint32_t layer = 0; layer < bdd->nlayers; ++layer) {
+			int var = (layer < bdd->nlayers - 1) ? bdd->layer_to_var[layer] : -1;
+			for (uint32_t node = bdd->layer_offsets[layer]; node < bdd->layer_offsets[layer + 1]; ++node) {
+				uint32_t zero = bdd->zero_child[node];
+				if (zero != FROZEN_BDD_NO_CHILD) {
+					values[zero].top_down_val = top_down->apply(layer, var, 0, values[node].top_down_val,
+					                            values[zero].top_down_val, NULL, NULL);
+				}
+				uint32_t one = bdd->one_child[node];
+				if (one != FROZEN_BDD_NO_CHILD) {
+					values[one].top_down_val = top_down->apply(layer, var, 1, values[node].top_down_val,
+					                           values[one].top_down_val, NULL, NULL);
+				}
+			}
+		}
+	}
+
+	// Bottom-up pass
+	if (bottom_up != NULL) {
+		uint32_t terminal_layer = bdd->nlayers - 1;
+		while (bdd->layer_offsets[terminal_layer] == bdd->layer_offsets[terminal_layer + 1]) {
+			terminal_layer--;
+		}
+		values[bdd->layer_offsets[terminal_layer]].bottom_up_val = bottom_up->start_val();
+
+		for (int layer = bdd->nlayers - 1; layer >= 0; --layer) {
+			int var = (layer < (int) bdd->nlayers - 1) ? bdd->layer_to_var[layer] : -1;
+			for (uint32_t node = bdd->layer_offsets[layer]; node < bdd->layer_offsets[layer + 1]; ++node) {
+				uint32_t zero = bdd->zero_child[node];
+				if (zero != FROZEN_BDD_NO_CHILD) {
+					values[node].bottom_up_val = bottom_up->apply(layer, var, 0, values[zero].bottom_up_val,
+					                             values[node].bottom_up_val, NULL, NULL);
+				}
+				uint32_t one = bdd->one_child[node];
+				if (one != FROZEN_BDD_NO_CHILD) {
+					values[node].bottom_up_val = bottom_up->apply(layer, var, 1, values[one].bottom_up_val,
+					                             values[node].bottom_up_val, NULL, NULL);
+				}
+			}
+		}
+	}
+}
@@ -0,0 +1,131 @@
+/**
+ * Binary serialization of decision diagrams, and read-only frozen decision diagrams mapped from binary files
+ */
+
+#ifndef BDD_FROZEN_HPP_
+#define BDD_FROZEN_HPP_
+
+#include <cstdint>
+#include <vector>
+#include "bdd.hpp"
+#include "bdd_pass.hpp"
+#include "../util/mapped_file.hpp"
+
+using namespace std;
+
+#define FROZEN_BDD_NO_CHILD   0xFFFFFFFFu     /**< child index of a missing arc */
+#define FROZEN_BDD_RELAXED    0x1u            /**< header flag: some node of the DD is relaxed */
+
+
+/**
+ * Header of a binary decision diagram file. It is followed by the arrays below, each starting at a multiple of 8 bytes:
+ * layer offsets (uint32, nlayers + 1), layer_to_var and var_to_layer (int32, nvars each), 0-arc and 1-arc children
+ * (uint32, nnodes each) and relaxed node flags (uint8, nnodes). Nodes are numbered layer by layer in the order of
+ * BDD::layers, so the nodes of layer k are layer_offsets[k]..layer_offsets[k+1]-1, and children are node numbers.
+ * Values are stored in the byte order of the machine that wrote the file.
+ */
+struct FrozenBDDHeader {
+	char     magic[8];
+	uint32_t version;
+	uint32_t flags;
+	uint32_t nlayers;
+	uint32_t nvars;
+	uint64_t nnodes;
+	double   bound;
+};
+
+
+/**
+ * Read-only decision diagram over a binary file mapped into memory. Arrays point directly into the mapping, so loading
+ * does not depend on the size of the DD. Node states and data are not kept. Queries do not modify the DD and may run
+ * concurrently.
+ */
+class FrozenBDD
+{
+public:
+
+	uint32_t             nlayers;             /**< number of layers, i.e. number of variables plus one */
+	uint64_t             nnodes;              /**< number of nodes */
+	double               bound;               /**< bound obtained at construction */
+	bool                 relaxed;             /**< if true, some node is relaxed */
+
+	const uint32_t*      layer_offsets;       /**< nodes of layer k are layer_offsets[k]..layer_offsets[k+1]-1 */
+	const int32_t*       layer_to_var;        /**< layer_to_var[k] is the index of the variable at layer k */
+	const int32_t*       var_to_layer;        /**< var_to_layer[k] is the layer of the k-th variable */
+	const uint32_t*      zero_child;          /**< 0-arc child of each node (FROZEN_BDD_NO_CHILD if none) */
+	const uint32_t*      one_child;           /**< 1-arc child of each node (FROZEN_BDD_NO_CHILD if none) */
+	const uint8_t*       relaxed_node;        /**< nonzero if the node was merged for relaxation */
+
+	~FrozenBDD();
+
+	int nvars() const
+	{
+		return nlayers - 1;
+	}
+
+	/** Return the layer of a node */
+	int get_node_layer(uint32_t node) const;
+
+
+	// Informational functions
+
+	/** Count number of arcs in BDD */
+	long count_number_of_arcs() const;
+
+	/** Compute width of BDD */
+	int get_width() const;
+
+	/** Get root node layer (the first nonempty layer) */
+	int get_root_layer() const;
+
+
+	// Computation of properties (see BDD for the definitions)
+
+	/** Path of maximum or minimum weight in layer space, using as weights coeffs_layer for 1-arcs. Returns total weight. */
+	double get_optimal_path(const vector<double>& coeffs_layer, vector<int>& optimal_path, bool maximize,
+	                        bool ignore_relaxed_nodes = false) const;
+
+	/** Solution of maximum or minimum weight in variable space, using as weights coeffs_var for 1-arcs. Returns total weight. */
+	double get_optimal_sol(const vector<double>& coeffs_var, vector<int>& optimal_sol, bool maximize,
+	                       bool ignore_relaxed_nodes = false) const;
+
+	/** Path of maximum or minimum weight in layer space, using zero_coeffs for 0-arcs and one_coeffs for 1-arcs. */
+	double get_optimal_path_zero_one_coeffs(const vector<double>& zero_coeffs, const vector<double>& one_coeffs,
+	                                        vector<int>& optimal_path, bool maximize,
+	                                        bool ignore_relaxed_nodes = false) const;
+
+
+	// Conversion functions
+
+	/** Create a regular BDD with the same nodes and arcs (without states), for functions that require one */
+	BDD* create_bdd() const;
+
+private:
+
+	MappedFile*          file;                /**< mapping of the binary file (owned) */
+
+	FrozenBDD(MappedFile* _file) : file(_file) {}
+
+	FrozenBDD(const FrozenBDD&);
+	FrozenBDD& operator=(const FrozenBDD&);
+
+	friend FrozenBDD* read_bdd_binary(const char* filename);
+};
+
+
+/** Write a constructed BDD to a binary file; return false if it cannot be written */
+bool write_bdd_binary(BDD* bdd, const char* filename);
+
+/** Map a binary DD file as a frozen BDD; return NULL if it cannot be read or is not a valid DD file */
+FrozenBDD* read_bdd_binary(const char* filename);
+
+
+/**
+ * Store values in a top-down or bottom-up pass through a frozen BDD, as bdd_pass does for a BDD. Values are stored in
+ * values, indexed by node; the source and target nodes passed to the pass functions are NULL. NULL may be passed if only
+ * a single direction pass is needed.
+ */
+void frozen_bdd_pass(const FrozenBDD* bdd, BDDPassFunc* top_down, BDDPassFunc* bottom_up, vector<BDDPassValues>& values);
+
+
+#endif /* BDD_FROZEN_HPP_ */
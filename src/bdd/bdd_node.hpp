@@ -77,6 +77,12 @@ public:
 
 	~Node();
 
+	/** Approximate number of bytes held by the node, excluding its state and data */
+	size_t memory_size() const
+	{
+		return sizeof(Node) + (one_ancestors.capacity() + zero_ancestors.capacity()) * sizeof(Node*);
+	}
+
 
 	// General functions
 
@@ -3,6 +3,7 @@
  */
 
 #include <cassert>
+#include <limits>
 #include "bdd_pass.hpp"
 
 
@@ -228,3 +229,57 @@ void bdd_pass_deep_clean_up(BDD* bdd)
 		}
 	}
 }
+
+
+double bdd_longest_path_by_var_value(BDD* bdd, const vector<double>& coeffs, vector<double>& best_zero,
+                                     vector<double>& best_one)
+{
+	int nvars = bdd->nvars();
+	int bdd_size = bdd->layers.size();
+	assert((int) coeffs.size() == nvars);
+
+	best_zero.assign(nvars, -numeric_limits<double>::infinity());
+	best_one.assign(nvars, -numeric_limits<double>::infinity());
+
+	LongestPathPassFunc* longest_path_func = new LongestPathPassFunc(coeffs);
+	bdd_pass(bdd, longest_path_func, longest_path_func);
+
+	// The value of an arc is the longest path through it: top-down value of parent + arc + bottom-up value of child
+	for (int layer = 0; layer < bdd_size; ++layer) {
+		int size = bdd->layers[layer].size();
+		int var = bdd->layer_to_var[layer];
+
+		for (int k = 0; k < size; ++k) {
+			Node* parent = bdd->layers[layer][k];
+			double parent_val = boost::any_cast<BDDPassValues*>(parent->temp_data)->top_down_val;
+
+			for (int val = 0; val <= 1; ++val) {
+				Node* child = (val == 0) ? parent->zero_arc : parent->one_arc;
+				if (child == NULL) {
+					continue;
+				}
+
+				double child_val = boost::any_cast<BDDPassValues*>(child->temp_data)->bottom_up_val;
+				double arc_val = parent_val + val * coeffs[var] + child_val;
+
+				if (val == 0) {
+					best_zero[var] = MAX(best_zero[var], arc_val);
+				} else {
+					best_one[var] = MAX(best_one[var], arc_val);
+				}
+				for (int j = layer + 1; j < child->layer; ++j) {
+					int skipped_var = bdd->layer_to_var[j];
+					best_zero[skipped_var] = MAX(best_zero[skipped_var], arc_val); // long arc (*,0,...,0)
+				}
+			}
+		}
+	}
+
+	double longest_path = boost::any_cast<BDDPassValues*>(
+	                          bdd->layers[bdd->get_terminal_layer()][0]->temp_data)->top_down_val;
+
+	bdd_pass_clean_up(bdd);
+	delete longest_path_func;
+
+	return longest_path;
+}
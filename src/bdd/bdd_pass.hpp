@@ -28,6 +28,7 @@ public:
 	/**
 	 * Return value to be stored at target. Target is child if top-down, parent if bottom-up.
 	 * Source is parent if top-down, child if bottom-up. Layer is always layer of parent (whether source or target).
+	 * Source and target are NULL in passes through a frozen BDD (see frozen_bdd_pass).
 	 */
 	virtual double apply(int layer, int var, int arc_val, double source_val, double target_val,
 	                     Node* source, Node* target) = 0;
@@ -87,6 +88,32 @@ struct MinPassValMerger : Merger {
 };
 
 
+/** Longest path with respect to a linear objective (in variable space) */
+class LongestPathPassFunc : public BDDPassFunc
+{
+	const vector<double>& coeffs;         /**< objective coefficients, indexed by variable */
+
+public:
+
+	LongestPathPassFunc(const vector<double>& _coeffs) : coeffs(_coeffs) {}
+
+	double start_val()
+	{
+		return 0;
+	}
+
+	double init_val()
+	{
+		return -numeric_limits<double>::infinity();
+	}
+
+	double apply(int layer, int var, int arc_val, double source_val, double target_val, Node* source, Node* target)
+	{
+		return MAX(target_val, source_val + arc_val * coeffs[var]);
+	}
+};
+
+
 /**
  * Store values in a top-down or bottom-up pass through the BDD. Note that bdd_pass_clean_up must always
  * be called after done with the values. NULL may be passed if only a single direction pass is needed.
@@ -113,4 +140,13 @@ void bdd_partial_pass(BDD* bdd, BDDPassFunc* top_down);
 void bdd_pass_deep_clean_up(BDD* bdd);
 
 
+/**
+ * Compute, for each variable, the longest path value with respect to coeffs among paths where the variable is zero
+ * (best_zero) and where it is one (best_one); -infinity if no such path exists. Long arcs count as zero for the
+ * variables they skip. Return the longest path value of the BDD.
+ */
+double bdd_longest_path_by_var_value(BDD* bdd, const vector<double>& coeffs, vector<double>& best_zero,
+                                     vector<double>& best_one);
+
+
 #endif // BDD_PASS_HPP_
@@ -29,6 +29,12 @@ public:
 
 	/** Merging function between two NodeDatas. This becomes the merged one and the other one is left unchanged. */
 	virtual void merge(Problem* prob, NodeData* rhs, State* state) {}
+
+	/** Approximate number of bytes held by the data, including its dynamically allocated members */
+	virtual size_t memory_size() const
+	{
+		return sizeof(NodeData);
+	}
 };
 
 
@@ -76,6 +82,17 @@ public:
 		}
 	}
 
+	/** Approximate number of bytes held by the map and its data */
+	size_t memory_size() const
+	{
+		// Each entry is a red-black tree node: key-value pair plus three pointers and a color
+		size_t bytes = sizeof(NodeDataMap);
+		for (const pair<const string, NodeData*>& p : data_map) {
+			bytes += sizeof(pair<const string, NodeData*>) + 4 * sizeof(void*) + p.second->memory_size();
+		}
+		return bytes;
+	}
+
 	/** Return true if at least one NodeData is infeasible */
 	bool is_infeasible()
 	{
@@ -27,6 +27,11 @@ public:
 
 	virtual void merge(Problem* prob, NodeData* rhs, State* state) = 0;
 
+	size_t memory_size() const
+	{
+		return sizeof(PassFuncNodeData);
+	}
+
 	/** Instantiate itself */
 	virtual PassFuncNodeData* create_from_pass_func(BDDPassFunc* pass_func) = 0;
 };
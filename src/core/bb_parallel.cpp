@@ -0,0 +1,290 @@
+/**
+ * Standalone parallel branch-and-bound based on decision diagrams
+ */
+
+#include <cassert>
+#include <chrono>
+#include <limits>
+#include <thread>
+
+#include "bb_parallel.hpp"
+#include "../util/util.hpp"
+#include "../util/profiler.hpp"
+
+
+/** Callback to collect the exact cutset of a relaxed DD: all open nodes right before the first merge */
+class ExactCutsetCallback : public DDSolverCallback
+{
+public:
+	BBProblemFactory*             factory;
+	vector<BBSubproblem>&         cutset;
+	bool                          collected;
+
+	ExactCutsetCallback(BBProblemFactory* _factory, vector<BBSubproblem>& _cutset) : factory(_factory), cutset(_cutset),
+		collected(false) {}
+
+	void cb_pre_merge(BDD* bdd, const vector<Node*>& nodes_layer, const NodeMap& node_list, int width, int current_layer)
+	{
+		if (collected) {
+			return;
+		}
+		collected = true;
+
+		// Every path of the DD goes through exactly one of these nodes, and no node has been relaxed yet
+		for (Node* node : nodes_layer) {
+			assert(!node->relaxed_node);
+			cutset.push_back({factory->copy_state(node->state), node->longest_path, numeric_limits<double>::infinity()});
+		}
+		for (NodeMap::const_iterator it = node_list.begin(); it != node_list.end(); ++it) {
+			assert(!it->second->relaxed_node);
+			cutset.push_back({factory->copy_state(it->second->state), it->second->longest_path,
+			                  numeric_limits<double>::infinity()});
+		}
+	}
+};
+
+
+ParallelDDBranchAndBound::ParallelDDBranchAndBound(BBProblemFactory* _factory, Options* _options, int _nthreads)
+	: factory(_factory), options(_options), nthreads(_nthreads)
+{
+	if (nthreads <= 0) {
+		nthreads = MAX(1, (int) thread::hardware_concurrency());
+	}
+	dual_bound = numeric_limits<double>::infinity();
+	solved = false;
+	time_limit_reached = false;
+	nsubproblems = 0;
+	nsubproblems_pruned = 0;
+	nsteals = 0;
+	time_limit = options->bb_time_limit;
+}
+
+
+double ParallelDDBranchAndBound::solve()
+{
+	incumbent = -numeric_limits<double>::infinity();
+	nopen = 0;
+	stopped = false;
+	nprocessed = 0;
+	npruned = 0;
+	nstolen = 0;
+	unresolved_bound = -numeric_limits<double>::infinity();
+
+	for (int i = 0; i < nthreads; ++i) {
+		queues.push_back(new BBWorkerQueue());
+	}
+
+	// Root subproblem
+	Problem* root_problem = factory->create_problem(options, false);
+	BBSubproblem root = {root_problem->create_initial_state(), 0, numeric_limits<double>::infinity()};
+	delete root_problem;
+	nopen++;
+	push_subproblem(0, root);
+
+	chrono::steady_clock::time_point start = chrono::steady_clock::now();
+
+	vector<thread> workers;
+	for (int i = 0; i < nthreads; ++i) {
+		workers.push_back(thread(&ParallelDDBranchAndBound::run_worker, this, i));
+	}
+
+	// Monitor time limit
+	while (nopen > 0 && !stopped) {
+		this_thread::sleep_for(chrono::milliseconds(10));
+		double elapsed = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+		if (elapsed >= time_limit) {
+			stopped = true;
+		}
+	}
+
+	for (thread& worker : workers) {
+		worker.join();
+	}
+	time_limit_reached = stopped;
+
+	// Dual bound is given by the subproblems left open, if any
+	solved = true;
+	dual_bound = incumbent;
+	for (BBWorkerQueue* queue : queues) {
+		for (BBSubproblem& subproblem : queue->subproblems) {
+			if (DBL_GT(subproblem.bound, incumbent)) {
+				dual_bound = MAX(dual_bound, subproblem.bound);
+				solved = false;
+			}
+			delete subproblem.state;
+		}
+		delete queue;
+	}
+	queues.clear();
+	if (DBL_GT(unresolved_bound, incumbent)) {
+		dual_bound = MAX(dual_bound, unresolved_bound);
+		solved = false;
+	}
+
+	nsubproblems = nprocessed;
+	nsubproblems_pruned = npruned;
+	nsteals = nstolen;
+
+	return incumbent;
+}
+
+
+void ParallelDDBranchAndBound::run_worker(int worker_id)
+{
+	// Each worker has its own options so that construction output is not interleaved
+	Options worker_options = *options;
+	worker_options.quiet = true;
+
+	BBSubproblem subproblem;
+	while (!stopped) {
+		if (take_subproblem(worker_id, subproblem)) {
+			process_subproblem(worker_id, &worker_options, subproblem);
+			nopen--;
+		} else if (nopen == 0) {
+			break;
+		} else {
+			this_thread::yield();
+		}
+	}
+}
+
+
+void ParallelDDBranchAndBound::process_subproblem(int worker_id, Options* worker_options, BBSubproblem& subproblem)
+{
+	if (stopped) {
+		// Return subproblem to the queue so that it is accounted for in the dual bound
+		nopen++;
+		push_subproblem(worker_id, subproblem);
+		return;
+	}
+
+	// Subproblems are numbered in processing order and each gets its own timeline in the profile
+	profiler_set_node(++nprocessed);
+	ProfileScope subproblem_scope("subproblem");
+
+	if (DBL_LE(subproblem.bound, incumbent)) {
+		npruned++;
+		delete subproblem.state;
+		return;
+	}
+
+	// Primal: restricted DD
+	bool exact;
+	double primal = build_dd(worker_options, subproblem, true, exact, NULL);
+	update_incumbent(primal);
+	if (exact) {
+		delete subproblem.state;
+		return;
+	}
+
+	// Dual: relaxed DD, collecting its exact cutset
+	vector<BBSubproblem> cutset;
+	double bound = build_dd(worker_options, subproblem, false, exact, &cutset);
+	delete subproblem.state;
+
+	if (exact) {
+		update_incumbent(bound);
+	}
+	if (exact || DBL_LE(bound, incumbent)) {
+		if (!exact) {
+			npruned++;
+		}
+		for (BBSubproblem& child : cutset) {
+			delete child.state;
+		}
+		return;
+	}
+
+	// Relaxed DD aborted at the memory limit before reaching a cutset: the subproblem cannot be branched on
+	if (cutset.empty()) {
+		lock_guard<mutex> guard(unresolved_lock);
+		unresolved_bound = MAX(unresolved_bound, bound);
+		return;
+	}
+
+	for (BBSubproblem& child : cutset) {
+		child.bound = bound;
+		nopen++;
+		push_subproblem(worker_id, child);
+	}
+}
+
+
+double ParallelDDBranchAndBound::build_dd(Options* worker_options, BBSubproblem& subproblem, bool restricted,
+        bool& exact, vector<BBSubproblem>* cutset)
+{
+	Problem* problem = factory->create_problem(worker_options, restricted);
+	DDSolver solver(problem, worker_options);
+
+	// Prune with the incumbent if the problem supports completion bounds
+	if (problem->completion != NULL && incumbent > -numeric_limits<double>::infinity()) {
+		solver.set_primal_bound(incumbent);
+	}
+
+	ExactCutsetCallback* callback = NULL;
+	if (cutset != NULL) {
+		callback = new ExactCutsetCallback(factory, *cutset);
+		solver.solver_callback = callback;
+	}
+
+	BDD* bdd = solver.construct_decision_diagram_at_state(NULL, factory->copy_state(subproblem.state), subproblem.longest_path);
+
+	// If no DD is returned, all nodes are infeasible or pruned
+	double bound = -numeric_limits<double>::infinity();
+	if (bdd != NULL) {
+		bound = bdd->bound;
+		delete bdd;
+	} else if (!restricted && solver.final_memory_aborted) {
+		// Relaxed DD aborted at the memory limit still bounds the subproblem
+		bound = solver.final_partial_bound;
+	}
+	exact = solver.final_exact;
+
+	delete callback;
+	delete problem;
+	return bound;
+}
+
+
+bool ParallelDDBranchAndBound::take_subproblem(int worker_id, BBSubproblem& subproblem)
+{
+	// Own queue: depth-first from the back
+	{
+		BBWorkerQueue* queue = queues[worker_id];
+		lock_guard<mutex> guard(queue->lock);
+		if (!queue->subproblems.empty()) {
+			subproblem = queue->subproblems.back();
+			queue->subproblems.pop_back();
+			return true;
+		}
+	}
+
+	// Steal from the front of other queues, where subproblems are typically larger
+	for (int k = 1; k < nthreads; ++k) {
+		BBWorkerQueue* queue = queues[(worker_id + k) % nthreads];
+		lock_guard<mutex> guard(queue->lock);
+		if (!queue->subproblems.empty()) {
+			subproblem = queue->subproblems.front();
+			queue->subproblems.pop_front();
+			nstolen++;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+
+void ParallelDDBranchAndBound::push_subproblem(int worker_id, const BBSubproblem& subproblem)
+{
+	BBWorkerQueue* queue = queues[worker_id];
+	lock_guard<mutex> guard(queue->lock);
+	queue->subproblems.push_back(subproblem);
+}
+
+
+void ParallelDDBranchAndBound::update_incumbent(double value)
+{
+	double current = incumbent.load();
+	while (value > current && !incumbent.compare_exchange_weak(current, value)) {}
+}
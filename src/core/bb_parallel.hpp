@@ -0,0 +1,118 @@
+/**
+ * Standalone parallel branch-and-bound based on decision diagrams
+ */
+
+#ifndef BB_PARALLEL_HPP_
+#define BB_PARALLEL_HPP_
+
+#include <atomic>
+#include <deque>
+#include <mutex>
+#include <vector>
+
+#include "solver.hpp"
+#include "../problem/problem.hpp"
+#include "../problem/state.hpp"
+#include "../util/options.hpp"
+
+using namespace std;
+
+
+/** Subproblem of the branch-and-bound: a node of an exact cutset */
+struct BBSubproblem {
+	State*      state;            /**< state of the cutset node (owned by subproblem) */
+	double      longest_path;     /**< value of the (exact) longest path up to the cutset node */
+	double      bound;            /**< dual bound on the subproblem, from the relaxed DD in which it was found */
+};
+
+
+/**
+ * Problem-specific functions required by the branch-and-bound. Problems carry per-construction data (e.g. dynamic
+ * orderings), so a new problem is created for every DD built.
+ */
+class BBProblemFactory
+{
+public:
+	virtual ~BBProblemFactory() {}
+
+	/** Create a problem for a single DD construction; if restricted, nodes past the width must be removed rather than merged */
+	virtual Problem* create_problem(Options* options, bool restricted) = 0;
+
+	/** Create a copy of a state */
+	virtual State* copy_state(State* state) = 0;
+};
+
+
+/** Per-worker queue of subproblems. The owner takes from the back and thieves take from the front. */
+struct BBWorkerQueue {
+	deque<BBSubproblem>    subproblems;
+	mutex                  lock;
+};
+
+
+/**
+ * Parallel branch-and-bound over exact cutsets of relaxed DDs. Each subproblem is solved with a restricted DD (primal)
+ * and a relaxed DD (dual); if neither is conclusive, the exact cutset of the relaxed DD becomes new subproblems.
+ * Subproblems are distributed among workers through work stealing and pruned with a shared incumbent.
+ */
+class ParallelDDBranchAndBound
+{
+public:
+	BBProblemFactory*             factory;                     /**< problem-specific functions */
+	Options*                      options;                     /**< options */
+	int                           nthreads;                    /**< number of worker threads */
+
+	double                        dual_bound;                  /**< final dual bound (equal to the incumbent if solved) */
+	bool                          solved;                      /**< if true, incumbent is optimal */
+	bool                          time_limit_reached;          /**< if true, solving stopped at the time limit */
+	long                          nsubproblems;                /**< number of subproblems processed */
+	long                          nsubproblems_pruned;         /**< number of subproblems pruned by bound */
+	long                          nsteals;                     /**< number of subproblems stolen from other workers */
+
+	ParallelDDBranchAndBound(BBProblemFactory* _factory, Options* _options, int _nthreads);
+
+	/** Solve the problem; returns the value of the best solution found */
+	double solve();
+
+	/** Return current incumbent value */
+	double get_incumbent()
+	{
+		return incumbent.load();
+	}
+
+private:
+
+	atomic<double>                incumbent;                   /**< shared incumbent value (maximization) */
+	atomic<long>                  nopen;                       /**< number of subproblems queued or being processed */
+	atomic<bool>                  stopped;                     /**< set when the time limit is reached */
+	atomic<long>                  nprocessed;
+	atomic<long>                  npruned;
+	atomic<long>                  nstolen;
+
+	vector<BBWorkerQueue*>        queues;                      /**< one queue per worker */
+	double                        time_limit;                  /**< wall-clock time limit in seconds */
+	double                        unresolved_bound;            /**< best bound of subproblems left unresolved at the memory limit */
+	mutex                         unresolved_lock;
+
+	/** Main loop of a worker */
+	void run_worker(int worker_id);
+
+	/** Process a single subproblem; new subproblems are added to the queue of the worker */
+	void process_subproblem(int worker_id, Options* worker_options, BBSubproblem& subproblem);
+
+	/** Take a subproblem from own queue or steal one from another worker; return false if none available */
+	bool take_subproblem(int worker_id, BBSubproblem& subproblem);
+
+	/** Add subproblem to the queue of a worker */
+	void push_subproblem(int worker_id, const BBSubproblem& subproblem);
+
+	/** Update incumbent if value is better */
+	void update_incumbent(double value);
+
+	/** Build a DD for a subproblem; fills cutset with the exact cutset if given and returns the bound (-inf if empty) */
+	double build_dd(Options* worker_options, BBSubproblem& subproblem, bool restricted, bool& exact,
+	                vector<BBSubproblem>* cutset);
+};
+
+
+#endif /* BB_PARALLEL_HPP_ */
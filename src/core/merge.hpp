@@ -5,8 +5,10 @@
 #ifndef MERGE_HPP_
 #define MERGE_HPP_
 
+#include <algorithm>
 #include <cassert>
 #include "../bdd/bdd.hpp"
+#include "../util/event_counters.hpp"
 
 
 /** Node merging for decision diagrams */
@@ -56,6 +58,7 @@ void merge_nodes_past_width_at_once(Problem* prob, vector<Node*>& nodes_layer, i
 	Node* merging_node = nodes_layer[width-1];
 	for (vector<Node*>::iterator node = nodes_layer.begin()+width; node != nodes_layer.end(); ++node) {
 		merging_node->merge(prob, *node);
+		COUNT_EVENT(EVENT_NODE_MERGES);
 		delete(*node);
 	}
 	nodes_layer.resize(width);
@@ -64,6 +67,7 @@ void merge_nodes_past_width_at_once(Problem* prob, vector<Node*>& nodes_layer, i
 	Node* equivalent_node = find_equivalent_state(nodes_layer, merging_node);
 	if (equivalent_node != NULL) {
 		equivalent_node->merge(prob, merging_node, true);
+		COUNT_EVENT(EVENT_NODE_MERGES);
 		delete merging_node;
 		nodes_layer.pop_back();
 	}
@@ -98,6 +102,7 @@ void merge_nodes_past_width_iteratively(Problem* prob, vector<Node*>& nodes_laye
 		// merge two last nodes
 		// cout << "Merging " << *(nodes_layer[current_size-1]->state) << " with " << *(nodes_layer[current_size-2]->state) << endl;
 		nodes_layer[current_size-2]->merge(prob, nodes_layer[current_size-1]);
+		COUNT_EVENT(EVENT_NODE_MERGES);
 
 		// remove last node from layer
 		delete nodes_layer[current_size-1];
@@ -111,6 +116,7 @@ void merge_nodes_past_width_iteratively(Problem* prob, vector<Node*>& nodes_laye
 			// merge nodes
 			// cout << "Merging " << *(nodes_layer[current_size-1]->state) << " with " << *(map_it->second->state) << endl;
 			map_it->second->merge(prob, nodes_layer[current_size-1]);
+			COUNT_EVENT(EVENT_NODE_MERGES);
 
 			// remove last node from layer
 			delete nodes_layer[current_size-1];
@@ -165,18 +171,21 @@ void merge_nodes_past_width_consecutive_pairs(Problem* prob, vector<Node*>& node
 
 			// merge into node A
 			nodeA->merge(prob, nodeB);
+			COUNT_EVENT(EVENT_NODE_MERGES);
 			delete nodeB;
 
 			// equivalence check in old_nodes
 			equivalent_node = find_equivalent_state(old_nodes, nodeA);
 			if (equivalent_node != NULL) {
 				equivalent_node->merge(prob, nodeA, true);
+				COUNT_EVENT(EVENT_NODE_MERGES);
 				delete nodeA;
 			} else {
 				// equivalence check in nodes_layer
 				equivalent_node = find_equivalent_state(nodes_layer, nodeA);
 				if (equivalent_node != NULL) {
 					equivalent_node->merge(prob, nodeA, true);
+					COUNT_EVENT(EVENT_NODE_MERGES);
 					delete nodeA;
 				} else {
 					// node is new
@@ -195,6 +204,35 @@ void merge_nodes_past_width_consecutive_pairs(Problem* prob, vector<Node*>& node
 }
 
 
+/**
+ * Remove all nodes past a given width instead of merging them, yielding a restricted rather than a relaxed DD.
+ * Arcs from parents to removed nodes are detached, so every remaining path is feasible.
+ */
+template <class Compare = NoSorting>
+void remove_nodes_past_width(vector<Node*>& nodes_layer, int width, Compare comparator = NoSorting())
+{
+	bool use_sorting = !is_same<Compare,NoSorting>::value;
+
+	if (use_sorting) {
+		sort(nodes_layer.begin(), nodes_layer.end(), comparator);
+	}
+
+	assert(width > 0);
+	for (vector<Node*>::iterator it = nodes_layer.begin()+width; it != nodes_layer.end(); ++it) {
+		Node* node = *it;
+		assert(node->zero_arc == NULL && node->one_arc == NULL);
+		for (Node* parent : node->zero_ancestors) {
+			parent->zero_arc = NULL;
+		}
+		for (Node* parent : node->one_ancestors) {
+			parent->one_arc = NULL;
+		}
+		delete node;
+	}
+	nodes_layer.resize(width);
+}
+
+
 /** Merge pairs that minimize or maximize a function that takes pairs of nodes into account */
 template <class ValFunc>
 void merge_nodes_pairs_value(Problem* prob, vector<Node*>& nodes_layer, int width, ValFunc value_function, bool maximize = true)
@@ -231,6 +269,7 @@ void merge_nodes_pairs_value(Problem* prob, vector<Node*>& nodes_layer, int widt
 
 		// Merge pair of nodes
 		node1_to_merge->merge(prob, node2_to_merge);
+		COUNT_EVENT(EVENT_NODE_MERGES);
 		nodes_layer.erase(remove(nodes_layer.begin(), nodes_layer.end(), node2_to_merge), nodes_layer.end());
 		delete node2_to_merge;
 
@@ -238,6 +277,7 @@ void merge_nodes_pairs_value(Problem* prob, vector<Node*>& nodes_layer, int widt
 		Node* equivalent_node = find_equivalent_state(nodes_layer, node1_to_merge);
 		if (equivalent_node != NULL) {
 			equivalent_node->merge(prob, node1_to_merge, true);
+			COUNT_EVENT(EVENT_NODE_MERGES);
 			nodes_layer.erase(remove(nodes_layer.begin(), nodes_layer.end(), node1_to_merge), nodes_layer.end());
 			delete node1_to_merge;
 		}
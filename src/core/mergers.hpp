@@ -54,6 +54,17 @@ struct ConsecutivePairLongestPathMerger : Merger {
 };
 
 
+// Minimum longest path restriction: nodes past the width are removed rather than merged (restricted DD)
+struct MinLongestPathRestrictedMerger : Merger {
+	MinLongestPathRestrictedMerger(int _width) : Merger(_width, "restrict_lp") {}
+
+	void merge_layer(Problem* prob, int layer, vector<Node*>& nodes_layer)
+	{
+		remove_nodes_past_width(nodes_layer, this->width, CompareNodesLongestPath());
+	}
+};
+
+
 struct NodeStateLexLessThan {
 	bool operator()(const Node* lhs, const Node* rhs) const
 	{
@@ -3,9 +3,14 @@
  */
 
 #include <cassert>
+#include <memory>
 #include "solver.hpp"
+#include "mergers.hpp"
+#include "solver_telemetry.hpp"
 #include "../util/util.hpp"
 #include "../util/stats.hpp"
+#include "../util/profiler.hpp"
+#include "../util/event_counters.hpp"
 
 
 BDD* DDSolver::construct_decision_diagram(SCIP* scip)
@@ -23,12 +28,22 @@ BDD* DDSolver::construct_decision_diagram_at_state(SCIP* scip, State* initial_st
 {
 	// Initialization
 
+	ProfileScope construct_scope("construct");
 	Stats stats;
 	stats.register_name("time_construct_dd");
 	stats.start_timer(0);
 
 	final_width = -1;
 	final_exact = true;
+	final_memory = DDMemoryUsage();
+	final_peak_memory = DDMemoryUsage();
+	final_memory_limit_reached = false;
+	final_memory_aborted = false;
+	final_partial_bound = numeric_limits<double>::infinity();
+
+	// Memory of the nodes of finished layers; open nodes are accounted for at the start of each layer
+	DDMemoryUsage finished_memory;
+	long long memory_limit = (options->dd_memory_limit >= 0) ? (long long) (options->dd_memory_limit * 1024 * 1024) : -1;
 
 	int width = -1;
 	if (problem->merger != NULL) {
@@ -48,6 +63,15 @@ BDD* DDSolver::construct_decision_diagram_at_state(SCIP* scip, State* initial_st
 
 	problem->callback_initialize();
 
+	// Per-layer telemetry wraps any callback set for this construction
+	unique_ptr<DDTelemetryCallback> telemetry;
+	DDSolverCallback* callback = solver_callback;
+	if (dd_telemetry != NULL) {
+		telemetry.reset(new DDTelemetryCallback(dd_telemetry, solver_callback));
+		callback = telemetry.get();
+	}
+	DDLayerStats layer_stats;
+
 
 	// Decision diagram construction
 
@@ -61,6 +85,10 @@ BDD* DDSolver::construct_decision_diagram_at_state(SCIP* scip, State* initial_st
 	// iterate through layers to construct nodes
 	for (int layer = 0; layer < nlayers - 1; ++layer) {
 
+		ProfileScope layer_scope("layer");
+		layer_stats = DDLayerStats();
+		layer_stats.layer = layer;
+
 		// select next variable
 		int current_var = problem->ordering->select_next_var(layer);
 		assert(current_var >= 0 && current_var < problem->inst->nvars);
@@ -74,6 +102,16 @@ BDD* DDSolver::construct_decision_diagram_at_state(SCIP* scip, State* initial_st
 		// update variable-layer translation maps
 		final_bdd->layer_to_var[layer] = current_var;
 		final_bdd->var_to_layer[current_var] = layer;
+		layer_stats.var = current_var;
+
+		// Memory accounting: the open nodes include the nodes of this layer before merging, which is the peak of the layer
+		DDMemoryUsage memory = finished_memory;
+		add_open_nodes_memory(node_list, memory);
+		if (memory.live() > final_peak_memory.live()) {
+			final_peak_memory = memory;
+		}
+		layer_stats.memory = memory;
+		layer_stats.peak_bytes = final_peak_memory.live();
 
 #ifdef DEBUG
 		cout << "\n\n\n\n ====================================================== \n\n";
@@ -101,6 +139,7 @@ BDD* DDSolver::construct_decision_diagram_at_state(SCIP* scip, State* initial_st
 
 			// if a node does not contain the variable, it will be skipped and corresponding arcs will be long arcs
 			if (options->use_long_arcs && problem->cb_skip_var_for_long_arc(current_var, node_it->second->state)) {
+				COUNT_EVENT(EVENT_LONG_ARC_SKIPS);
 				++node_it;
 				continue;
 			}
@@ -139,22 +178,53 @@ BDD* DDSolver::construct_decision_diagram_at_state(SCIP* scip, State* initial_st
 		 * 2. Merging
 		 * ===============================================================================
 		 */
+		layer_stats.pre_merge_size = nodes_layer.size();
+
+		// Past the memory limit, merge harder or abort with a partial bound
+		if (memory_limit >= 0 && memory.live() > memory_limit) {
+			final_memory_limit_reached = true;
+			if (!reduce_width_for_memory_limit(width, current_var, nodes_layer, node_list)) {
+				final_memory_aborted = true;
+				final_exact = false;
+				for (Node* node : nodes_layer) {
+					delete node;
+				}
+				for (NodeMap::iterator it = node_list.begin(); it != node_list.end(); ++it) {
+					delete it->second;
+				}
+				stats.end_timer(0);
+				delete final_bdd;
+				return NULL;
+			}
+		}
+
 		if (width != EXACT_BDD && (int) nodes_layer.size() > width) {
 
-			if (solver_callback != NULL) {
-				solver_callback->cb_pre_merge(final_bdd, nodes_layer, node_list, width, layer);
+			ProfileScope merge_scope("merge");
+			int64_t merge_start = (callback != NULL) ? wall_clock_ns() : 0;
+
+			if (callback != NULL) {
+				callback->cb_pre_merge(final_bdd, nodes_layer, node_list, width, layer);
 			}
 
 			// cout << "Merging " << (int) nodes_layer.size() << " max " << width << endl;
+			// The width may have been reduced for the memory limit; the merger keeps its own width across constructions
 			assert(problem->merger != NULL);
+			int merger_width = problem->merger->width;
+			problem->merger->width = width;
 			problem->merger->merge_layer(problem, layer, nodes_layer);
+			problem->merger->width = merger_width;
 
-			if (solver_callback != NULL) {
-				solver_callback->cb_post_merge(final_bdd, nodes_layer, node_list, width, layer);
+			if (callback != NULL) {
+				callback->cb_post_merge(final_bdd, nodes_layer, node_list, width, layer);
 			}
 
 			final_exact = false;
+			if (callback != NULL) {
+				layer_stats.merge_time = (wall_clock_ns() - merge_start) / 1e9;
+			}
 		}
+		layer_stats.width = nodes_layer.size();
 
 		final_width = MAX(final_width, (int) nodes_layer.size());
 
@@ -181,6 +251,8 @@ BDD* DDSolver::construct_decision_diagram_at_state(SCIP* scip, State* initial_st
 		 * 3. Branching
 		 * ===============================================================================
 		 */
+		ProfileScope branch_scope("branch");
+		int64_t branch_start = (callback != NULL) ? wall_clock_ns() : 0;
 		for (Node* branch_node : nodes_layer) {
 
 			// add node to final BDD representation
@@ -188,12 +260,18 @@ BDD* DDSolver::construct_decision_diagram_at_state(SCIP* scip, State* initial_st
 			branch_node->layer = layer;
 			branch_node->id = final_bdd->layers[layer].size();
 			final_bdd->layers[layer].push_back(branch_node);
+			finished_memory.nodes += branch_node->memory_size();
+			if (branch_node->data != NULL) {
+				finished_memory.node_data += branch_node->data->memory_size();
+			}
 
 			Node* new_node;
 
 			for (int val = 0; val <= 1; ++val) {
 
 				State* new_state = branch_node->state->transition(problem, current_var, val);
+				layer_stats.ntransitions++;
+				COUNT_EVENT(EVENT_TRANSITIONS);
 
 				// // Debugging info
 				// cout << "[T]  Set " << current_var << " to " << val << "  /  State " << *(branch_node->state) << " / Value " << branch_node->longest_path << endl;
@@ -212,6 +290,8 @@ BDD* DDSolver::construct_decision_diagram_at_state(SCIP* scip, State* initial_st
 						nd = branch_node->data->transition(problem, branch_node, new_state, current_var, val);
 
 						if (nd->is_infeasible()) {
+							layer_stats.ninfeasible++;
+							COUNT_EVENT(EVENT_NODE_DATA_INFEASIBLE);
 							if (val == 1) {
 								branch_node->one_arc = NULL;
 							} else { // val == 0
@@ -226,6 +306,7 @@ BDD* DDSolver::construct_decision_diagram_at_state(SCIP* scip, State* initial_st
 
 					// prune node if bounds allow
 					if ((use_primal_pruning && node_can_be_pruned_by_primal_bound(problem, new_node, branch_node))) {
+						layer_stats.npruned++;
 						if (val == 1) {
 							branch_node->one_arc = NULL;
 						} else { // val == 0
@@ -239,11 +320,14 @@ BDD* DDSolver::construct_decision_diagram_at_state(SCIP* scip, State* initial_st
 					// stats.register_name("find");
 					// stats.start_timer(1);
 					existing_node_it = node_list.find(new_node->state);
+					COUNT_EVENT(EVENT_NODE_LOOKUPS);
 					// stats.end_timer(1);
 					// cout << "Time find: " << stats.get_time(1) << endl;
 
 					if (existing_node_it != node_list.end()) {
 						// node already exists: delete newly created node and point to existing node
+						layer_stats.nequivalent++;
+						COUNT_EVENT(EVENT_NODE_EQUIVALENT);
 
 						Node* existing_node = existing_node_it->second;
 						existing_node->update_optimal_path(new_node);
@@ -276,6 +360,9 @@ BDD* DDSolver::construct_decision_diagram_at_state(SCIP* scip, State* initial_st
 					// cout << " to " << endl;
 					// cout << "\t" << *(new_node->state) << endl;
 					// cout << endl;
+				} else {
+					layer_stats.ninfeasible++;
+					COUNT_EVENT(EVENT_TRANSITIONS_INFEASIBLE);
 				}
 			}
 
@@ -283,9 +370,15 @@ BDD* DDSolver::construct_decision_diagram_at_state(SCIP* scip, State* initial_st
 			if (options->delete_old_states) {
 				delete branch_node->state;
 				branch_node->state = NULL;
+			} else {
+				finished_memory.states += branch_node->state->memory_size();
 			}
 
 		}
+		branch_scope.end();
+		if (callback != NULL) {
+			layer_stats.branch_time = (wall_clock_ns() - branch_start) / 1e9;
+		}
 
 #ifdef DEBUG
 		// iterate through the nodes in the node list
@@ -299,12 +392,14 @@ BDD* DDSolver::construct_decision_diagram_at_state(SCIP* scip, State* initial_st
 #endif
 
 		problem->cb_layer_end(current_var);
-		if (solver_callback != NULL) {
-			solver_callback->cb_layer_end(final_bdd, nodes_layer, node_list, width, layer, options);
+		if (callback != NULL) {
+			callback->cb_layer_end(final_bdd, nodes_layer, node_list, width, layer, options);
+			layer_stats.pool_size = node_list.size();
+			callback->cb_layer_stats(final_bdd, layer_stats);
 		}
 
-		// If SCIP is stopped, return no BDD
-		if (SCIPisStopped(scip)) {
+		// If SCIP is stopped or construction is interrupted, return no BDD (scip may be NULL if the DD is built outside of SCIP)
+		if ((scip != NULL && SCIPisStopped(scip)) || (interrupt_flag != NULL && *interrupt_flag)) {
 			stats.end_timer(0);
 			delete final_bdd;
 			return NULL;
@@ -314,6 +409,12 @@ BDD* DDSolver::construct_decision_diagram_at_state(SCIP* scip, State* initial_st
 
 	// Final steps
 
+	DDMemoryUsage memory = finished_memory;
+	add_open_nodes_memory(node_list, memory);
+	if (memory.live() > final_peak_memory.live()) {
+		final_peak_memory = memory;
+	}
+
 	// If no nodes are left, BDD is infeasible or all nodes were pruned
 	if (node_list.size() == 0) {
 		stats.end_timer(0);
@@ -361,15 +462,24 @@ BDD* DDSolver::construct_decision_diagram_at_state(SCIP* scip, State* initial_st
 		}
 		// cout << "Layer " << i << " width: " << final_bdd->layers[i].size() << endl;
 	}
-	assert(final_bdd->layers[0].size() == 1);
+	// The root may be at a later layer if the initial state skips the first variables through long arcs
+	assert(final_bdd->layers[final_bdd->get_root_layer()].size() == 1);
 	assert(final_bdd->layers[nlayers-1].size() == 1);
 	// cout << endl;
 #endif
 
 	// Finalize construction
 	final_bdd->constructed = true;
-	if (solver_callback != NULL) {
-		solver_callback->cb_solver_end(final_bdd, options);
+	final_memory = finished_memory;
+	final_memory.nodes += terminal_node->memory_size();
+	if (terminal_node->state != NULL) {
+		final_memory.states += terminal_node->state->memory_size();
+	}
+	if (terminal_node->data != NULL) {
+		final_memory.node_data += terminal_node->data->memory_size();
+	}
+	if (callback != NULL) {
+		callback->cb_solver_end(final_bdd, options);
 	}
 
 	stats.end_timer(0);
@@ -428,6 +538,7 @@ DDSolver::DDSolver(Problem* _problem, Options* _options) : problem(_problem), op
 
 	initial_node_data = NULL;
 	solver_callback = NULL;
+	interrupt_flag = NULL;
 }
 
 
@@ -445,6 +556,59 @@ void DDSolver::set_dual_bound(double bound)
 }
 
 
+void DDSolver::add_open_nodes_memory(const NodeMap& node_list, DDMemoryUsage& memory)
+{
+	for (NodeMap::const_iterator it = node_list.begin(); it != node_list.end(); ++it) {
+		Node* node = it->second;
+		memory.nodes += node->memory_size();
+		memory.states += node->state->memory_size();
+		if (node->data != NULL) {
+			memory.node_data += node->data->memory_size();
+		}
+	}
+	memory.node_table += nodemap_memory_size(node_list);
+}
+
+
+bool DDSolver::reduce_width_for_memory_limit(int& width, int current_var, const vector<Node*>& nodes_layer,
+        const NodeMap& node_list)
+{
+	// Halve the width that would be used for this layer
+	int layer_width = nodes_layer.size();
+	if (width != EXACT_BDD) {
+		layer_width = MIN(layer_width, width);
+	}
+	if (problem->merger != NULL && layer_width > 1) {
+		width = layer_width / 2;
+		return true;
+	}
+
+	// Otherwise, every path goes through an open node and is completed by at most the positive weights left
+	double completion = 0;
+	for (int var = 0; var < problem->inst->nvars; ++var) {
+		if (final_bdd->var_to_layer[var] == DD_NODE_ID_OPEN || var == current_var) {
+			completion += MAX(0, problem->inst->weights[var]);
+		}
+	}
+	double best_open = -numeric_limits<double>::infinity();
+	for (Node* node : nodes_layer) {
+		best_open = MAX(best_open, node->longest_path);
+	}
+	for (NodeMap::const_iterator it = node_list.begin(); it != node_list.end(); ++it) {
+		best_open = MAX(best_open, it->second->longest_path);
+	}
+	final_partial_bound = best_open + completion;
+	return false;
+}
+
+
+void DDSolver::set_restricted(int width)
+{
+	delete problem->merger;
+	problem->merger = new MinLongestPathRestrictedMerger(width);
+}
+
+
 bool DDSolver::node_can_be_pruned_by_primal_bound(Problem* prob, Node* node, Node* parent)
 {
 	/* prune if partial solution value + completion dual bound <= primal bound */
@@ -16,6 +16,7 @@
 
 #include "scip/scip.h" // for catching interrupt signals
 
+#include <atomic>
 #include <vector>
 #include <map>
 #include <queue>
@@ -31,6 +32,11 @@ public:
 	BDD*                          final_bdd;                   /**< decision diagram */
 	int                           final_width;                 /**< final width of DD after construction */
 	bool                          final_exact;                 /**< if true, DD is exact after construction */
+	DDMemoryUsage                 final_memory;                /**< memory of the DD after construction */
+	DDMemoryUsage                 final_peak_memory;           /**< memory at the peak of construction */
+	bool                          final_memory_limit_reached;  /**< if true, the memory limit was reached during construction */
+	bool                          final_memory_aborted;        /**< if true, construction was aborted at the memory limit */
+	double                        final_partial_bound;         /**< if aborted, bound on the DD from its open nodes (valid for relaxed DDs) */
 
 	bool                          use_primal_pruning;          /**< if true, enables pruning with primal bound */
 	double                        primal_bound;                /**< primal bound used for pruning; only used if use_primal_pruning is true */
@@ -41,6 +47,8 @@ public:
 
 	DDSolverCallback*             solver_callback;             /**< special solver callback for specific situations */
 
+	const atomic<bool>*           interrupt_flag;              /**< if not NULL, construction is aborted once it is set */
+
 	Options*                      options;                     /**< options */
 
 	DDSolver(Problem* _problem, Options* options);
@@ -57,6 +65,9 @@ public:
 	/** Set a dual bound for possible pruning */
 	void set_dual_bound(double bound);
 
+	/** Construct a restricted DD instead of a relaxed one: nodes past the width are removed rather than merged */
+	void set_restricted(int width);
+
 	/** Check if node can be pruned due to the primal bound */
 	bool node_can_be_pruned_by_primal_bound(Problem* prob, Node* node, Node* parent);
 
@@ -70,6 +81,16 @@ private:
 
 	/** Merge terminal nodes if there is more than one at the end */
 	Node* merge_terminal_nodes(NodeMap& terminal_node_list);
+
+	/** Add the memory held by the open nodes of the pool, including the pool itself */
+	void add_open_nodes_memory(const NodeMap& node_list, DDMemoryUsage& memory);
+
+	/**
+	 * Called when the memory limit is exceeded at the start of a layer: halve the width for the rest of the current construction
+	 * if it reduces the layer; otherwise set final_partial_bound from the open nodes and return false
+	 */
+	bool reduce_width_for_memory_limit(int& width, int current_var, const vector<Node*>& nodes_layer,
+	                                   const NodeMap& node_list);
 };
 
 #endif /* SOLVER_HPP_ */
@@ -8,6 +8,38 @@
 #include "../bdd/bdd.hpp"
 #include "../util/options.hpp"
 
+/** Approximate memory held by a DD under construction, in bytes */
+struct DDMemoryUsage {
+	long long nodes = 0;        /**< nodes, including their ancestor lists */
+	long long states = 0;       /**< states of nodes */
+	long long node_data = 0;    /**< node data of nodes */
+	long long node_table = 0;   /**< map from states to open nodes */
+
+	long long live() const
+	{
+		return nodes + states + node_data + node_table;
+	}
+};
+
+
+/** Statistics of the construction of a layer */
+struct DDLayerStats {
+	int    layer;
+	int    var;                 /**< variable of the layer */
+	int    pool_size;           /**< nodes left in the pool for later layers (long arcs) */
+	int    pre_merge_size;      /**< nodes in the layer before merging */
+	int    width;               /**< nodes in the layer after merging */
+	long   ntransitions;        /**< state transitions computed */
+	long   nequivalent;         /**< transitions reaching a state already in the pool */
+	long   ninfeasible;         /**< transitions that are infeasible */
+	long   npruned;             /**< transitions pruned by the primal bound */
+	double merge_time;          /**< wall-clock time merging (seconds) */
+	double branch_time;         /**< wall-clock time branching (seconds) */
+	DDMemoryUsage memory;       /**< memory of finished layers and open nodes at the start of the layer */
+	long long peak_bytes;       /**< peak memory of the construction so far */
+};
+
+
 /** Interface for a special callback to be called during DD construction */
 class DDSolverCallback
 {
@@ -22,6 +54,9 @@ public:
 	virtual void cb_post_merge(BDD* bdd, const vector<Node*>& nodes_layer, const NodeMap& node_list, int width, int current_layer) {}
 
 	virtual void cb_solver_end(BDD* bdd, Options* options) {}
+
+	/** Called at the end of each layer, after cb_layer_end */
+	virtual void cb_layer_stats(BDD* bdd, const DDLayerStats& layer_stats) {}
 };
 
 
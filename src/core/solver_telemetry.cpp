@@ -0,0 +1,87 @@
+/**
+ * Per-layer telemetry of decision diagram construction
+ */
+
+#include <cstring>
+#include "solver_telemetry.hpp"
+#include "../util/profiler.hpp"
+
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
+
+
+DDTelemetrySink* dd_telemetry = NULL;
+
+
+/** Return the number of heap bytes in use by the process, or 0 if unavailable */
+static long long heap_bytes_in_use()
+{
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33))
+	struct mallinfo2 info = mallinfo2();
+	return (long long) (info.uordblks + info.hblkhd);
+#else
+	return 0;
+#endif
+}
+
+
+DDTelemetrySink::DDTelemetrySink(const char* filename) : ndds(0)
+{
+	size_t len = strlen(filename);
+	csv = (len >= 4 && strcmp(filename + len - 4, ".csv") == 0);
+	out = fopen(filename, "w");
+	if (out != NULL && csv) {
+		fprintf(out, "dd,node,layer,var,pool_size,pre_merge,width,transitions,equivalent,infeasible,pruned,"
+		        "merge_time,branch_time,node_bytes,state_bytes,data_bytes,table_bytes,live_bytes,peak_bytes,heap_bytes\n");
+	}
+}
+
+
+DDTelemetrySink::~DDTelemetrySink()
+{
+	if (out != NULL) {
+		fclose(out);
+	}
+}
+
+
+void DDTelemetrySink::write(long long dd_id, long long node, const DDLayerStats& s, long long heap_bytes)
+{
+	lock_guard<mutex> guard(lock);
+	if (csv) {
+		fprintf(out, "%lld,%lld,%d,%d,%d,%d,%d,%ld,%ld,%ld,%ld,%.9f,%.9f,%lld,%lld,%lld,%lld,%lld,%lld,%lld\n", dd_id,
+		        node, s.layer, s.var, s.pool_size, s.pre_merge_size, s.width, s.ntransitions, s.nequivalent,
+		        s.ninfeasible, s.npruned, s.merge_time, s.branch_time, s.memory.nodes, s.memory.states,
+		        s.memory.node_data, s.memory.node_table, s.memory.live(), s.peak_bytes, heap_bytes);
+	} else {
+		fprintf(out, "{\"dd\":%lld,\"node\":%lld,\"layer\":%d,\"var\":%d,\"pool_size\":%d,\"pre_merge\":%d,\"width\":%d,"
+		        "\"transitions\":%ld,\"equivalent\":%ld,\"infeasible\":%ld,\"pruned\":%ld,\"merge_time\":%.9f,"
+		        "\"branch_time\":%.9f,\"node_bytes\":%lld,\"state_bytes\":%lld,\"data_bytes\":%lld,\"table_bytes\":%lld,"
+		        "\"live_bytes\":%lld,\"peak_bytes\":%lld,\"heap_bytes\":%lld}\n", dd_id, node, s.layer, s.var, s.pool_size,
+		        s.pre_merge_size, s.width, s.ntransitions, s.nequivalent, s.ninfeasible, s.npruned, s.merge_time,
+		        s.branch_time, s.memory.nodes, s.memory.states, s.memory.node_data, s.memory.node_table,
+		        s.memory.live(), s.peak_bytes, heap_bytes);
+	}
+}
+
+
+DDTelemetryCallback::DDTelemetryCallback(DDTelemetrySink* _sink, DDSolverCallback* _inner) : sink(_sink), inner(_inner)
+{
+	dd_id = sink->next_dd_id();
+	node = profiler_get_node();
+	heap_bytes = heap_bytes_in_use();
+}
+
+
+void DDTelemetryCallback::cb_layer_stats(BDD* bdd, const DDLayerStats& layer_stats)
+{
+	// Heap growth is process-wide, so it includes allocations of other threads running concurrently
+	long long current_heap_bytes = heap_bytes_in_use();
+	sink->write(dd_id, node, layer_stats, current_heap_bytes - heap_bytes);
+	heap_bytes = current_heap_bytes;
+
+	if (inner != NULL) {
+		inner->cb_layer_stats(bdd, layer_stats);
+	}
+}
@@ -0,0 +1,103 @@
+/**
+ * Per-layer telemetry of decision diagram construction
+ */
+
+#ifndef SOLVER_TELEMETRY_HPP_
+#define SOLVER_TELEMETRY_HPP_
+
+#include <atomic>
+#include <cstdio>
+#include <mutex>
+#include "solver_callback.hpp"
+
+using namespace std;
+
+
+/**
+ * Thread-safe sink of per-layer records, one line per layer of every DD constructed while it is active. Files ending
+ * in .csv are written as CSV with a header; any other file is written as newline-delimited JSON.
+ */
+class DDTelemetrySink
+{
+public:
+	/** Open the given file for writing; check is_open for success */
+	DDTelemetrySink(const char* filename);
+
+	~DDTelemetrySink();
+
+	bool is_open() const
+	{
+		return out != NULL;
+	}
+
+	/** Return a new identifier for a DD construction */
+	long long next_dd_id()
+	{
+		return ndds++;
+	}
+
+	/** Write the record of a layer of the given construction at the given B&B node */
+	void write(long long dd_id, long long node, const DDLayerStats& layer_stats, long long heap_bytes);
+
+private:
+	FILE*                out;
+	bool                 csv;
+	mutex                lock;
+	atomic<long long>    ndds;
+};
+
+
+/** Sink for per-layer telemetry of all DD constructions; NULL if disabled. Must be set before any construction starts. */
+extern DDTelemetrySink* dd_telemetry;
+
+
+/**
+ * Callback that writes the statistics of each layer to a telemetry sink. It wraps the callback set for the
+ * construction, if any, and forwards every call to it.
+ */
+class DDTelemetryCallback : public DDSolverCallback
+{
+public:
+	DDTelemetryCallback(DDTelemetrySink* _sink, DDSolverCallback* _inner);
+
+	void cb_layer_end(BDD* bdd, const vector<Node*>& nodes_layer, NodeMap& node_list, int width, int current_layer,
+	                  Options* options)
+	{
+		if (inner != NULL) {
+			inner->cb_layer_end(bdd, nodes_layer, node_list, width, current_layer, options);
+		}
+	}
+
+	void cb_pre_merge(BDD* bdd, const vector<Node*>& nodes_layer, const NodeMap& node_list, int width, int current_layer)
+	{
+		if (inner != NULL) {
+			inner->cb_pre_merge(bdd, nodes_layer, node_list, width, current_layer);
+		}
+	}
+
+	void cb_post_merge(BDD* bdd, const vector<Node*>& nodes_layer, const NodeMap& node_list, int width, int current_layer)
+	{
+		if (inner != NULL) {
+			inner->cb_post_merge(bdd, nodes_layer, node_list, width, current_layer);
+		}
+	}
+
+	void cb_solver_end(BDD* bdd, Options* options)
+	{
+		if (inner != NULL) {
+			inner->cb_solver_end(bdd, options);
+		}
+	}
+
+	void cb_layer_stats(BDD* bdd, const DDLayerStats& layer_stats);
+
+private:
+	DDTelemetrySink*     sink;
+	DDSolverCallback*    inner;
+	long long            dd_id;
+	long long            node;            /**< B&B node the construction is attributed to */
+	long long            heap_bytes;      /**< heap bytes in use at the end of the previous layer */
+};
+
+
+#endif /* SOLVER_TELEMETRY_HPP_ */
@@ -0,0 +1,290 @@
+/**
+ * Decision diagram primal heuristic for SCIP
+ * @file   heur_dd.cpp
+ * @brief  restricted dd heuristic
+ */
+
+/*---+----1----+----2----+----3----+----4----+----5----+----6----+----7----+----8----+----9----+----0----+----1----+----2*/
+
+#include <assert.h>
+#include <string.h>
+
+#include "heur_dd.h"
+#include "relax_dd.h"
+
+#include "../core/solver.hpp"
+#include "../util/stats.hpp"
+
+#include "../lagrangian/lg_subprob.hpp"
+#include "../lagrangian/lg_subprob_bdd.hpp"
+#include "../lagrangian/lg_subprob_feas.hpp"
+#include "../lagrangian/lg_subprob_feas_scip.hpp"
+#include "../lagrangian/lg_subprob_subrelaxed.hpp"
+#include "../lagrangian/lg_dd_selector_ct_scip.hpp"
+#include "../lagrangian/lg_dd_selector_bp_scip.hpp"
+
+#include "../problem/cliquetable/cliquetable_completion.hpp"
+
+#define HEUR_NAME             "dd"
+#define HEUR_DESC             "restricted decision diagrams for binary programs"
+#define HEUR_DISPCHAR         'X'
+#define HEUR_PRIORITY         -1100000
+#define HEUR_FREQ             1
+#define HEUR_FREQOFS          0
+#define HEUR_MAXDEPTH         -1
+#define HEUR_TIMING           SCIP_HEURTIMING_AFTERLPNODE
+#define HEUR_USESSUBSCIP      FALSE
+
+
+
+/*
+ * Data structures
+ */
+
+/** primal heuristic data */
+struct SCIP_HeurData {
+	Options*              options;            /**< options */
+	OutputStats*          output_stats;       /**< output statistics */
+
+	bool                  disabled;           /**< if true, this heuristic does not run anymore */
+	bool                  firstrun;           /**< if true, the current run is the first run */
+	LagrangianDDConstraintSelector* lag_selector;  /**< constraint selector for DD construction */
+};
+
+
+/*
+ * Main methods
+ */
+
+/**
+ * Construct a restricted decision diagram over the same subspace as the dd relaxator and try its longest path as a
+ * solution. Every path of a restricted DD is feasible for the constraints in the DD.
+ */
+static
+SCIP_RETCODE construct_restricted_dd(SCIP* scip, SCIP_HEUR* heur, Options* options, OutputStats* output_stats,
+                                     LagrangianDDConstraintSelector* lag_selector, bool* found)
+{
+	Stats stats;
+
+	*found = false;
+
+	stats.register_name("dd_time");
+	stats.start_timer(0);
+
+	// Same subspace as construct_dd_from_bp_lag
+	DDSubspace subspace;
+	SCIP_CALL(get_dd_subspace(scip, lag_selector, &subspace));
+
+	const vector<int>& fixed_vars = subspace.fixed_vars;
+	const vector<int>& var_to_subvar = subspace.var_to_subvar;
+	const vector<int>& subvar_to_var = subspace.subvar_to_var;
+	const vector<double>& sub_obj = subspace.sub_obj;
+	const vector<double>& full_obj = subspace.full_obj;
+	double objconstant = subspace.objconstant;
+
+	SCIP_Real primal_bound = SCIPgetPrimalbound(scip);
+
+	// primal bound taking into account transformations and only variables in subspace
+	double subspace_primal_bound = -SCIPgetUpperbound(scip) - objconstant;
+
+	// Construct restricted decision diagram
+	DDSolver* solver = lag_selector->create_solver(scip, var_to_subvar, subvar_to_var, fixed_vars, sub_obj, options);
+	solver->set_restricted(options->heur_dd_width);
+
+	// Only solutions better than the incumbent are of interest
+	if (!options->lag_pure_bp) {
+		solver->problem->completion = new CliqueTableDomainCompletionBound();
+		solver->set_primal_bound(subspace_primal_bound);
+	}
+
+	BDD* bdd = solver->construct_decision_diagram(scip);
+
+	stats.end_timer(0);
+	output_stats->heur_dd_time += stats.get_time(0);
+
+	// If no DD is returned, no path improves upon the incumbent
+	if (bdd != NULL && !SCIPisStopped(scip)) {
+		LagrangianSubproblemOracle* oracle = new LagrangianSubproblemOracleSubspaceRelaxed(
+		    new LagrangianSubproblemOracleBDD(bdd),
+		    subvar_to_var);
+		oracle = new LagrangianSubproblemOracleFeasibilityCheck(oracle, new FeasibilityCheckerSCIP(scip, heur), full_obj,
+		        fixed_vars, primal_bound, options, output_stats);
+
+		vector<int> optsol;
+		oracle->solve(sub_obj, optsol);
+		delete oracle;
+
+		*found = SCIPisLT(scip, SCIPgetPrimalbound(scip), primal_bound);
+
+		if (options->bounds_verbose) {
+			cout << "Restricted DD width: " << solver->final_width << " -- primal bound: " << SCIPgetPrimalbound(scip);
+			cout << (*found ? " -- improved" : "") << endl;
+		}
+	}
+
+	delete bdd;
+	delete solver->problem->inst;
+	delete solver->problem;
+	delete solver;
+
+	return SCIP_OKAY;
+}
+
+
+/** Initialize necessary structures for heuristic at the start of the solving process */
+static
+SCIP_RETCODE init_dd_heuristic(SCIP* scip, SCIP_HEURDATA* heurdata)
+{
+	SCIP_ROW** rows;
+	int nrows;
+	SCIP_CALL(SCIPgetLPRowsData(scip, &rows, &nrows));
+
+	if (!heurdata->options->lag_pure_bp) {
+		// Clique table
+		heurdata->lag_selector = new LagrangianDDConstraintSelectorCliqueTable();
+	} else {
+		// Pure BP
+		heurdata->lag_selector = new LagrangianDDConstraintSelectorBP();
+	}
+
+	// Disable heuristic if there are no decision diagrams to construct
+	if (!heurdata->lag_selector->exists_structure(scip, rows, nrows)) {
+		cout << "Warning: Decision diagram heuristic enabled but no structure found; disabling heuristic" << endl;
+		heurdata->disabled = true;
+		return SCIP_OKAY;
+	}
+
+	heurdata->lag_selector->prepare_dd_construction(scip, rows, nrows, heurdata->options);
+
+	return SCIP_OKAY;
+}
+
+
+/*
+ * Callback methods of primal heuristic
+ */
+
+
+// Default plugin methods
+#define heurCopyDd NULL
+#define heurInitDd NULL
+#define heurExitDd NULL
+#define heurInitsolDd NULL
+#define heurExitsolDd NULL
+
+
+/** destructor of primal heuristic to free user data (called when SCIP is exiting) */
+static
+SCIP_DECL_HEURFREE(heurFreeDd)
+{
+	/*lint --e{715}*/
+	SCIP_HEURDATA* heurdata;
+
+	heurdata = SCIPheurGetData(heur);
+	delete heurdata->lag_selector;
+	SCIPfreeMemory(scip, &heurdata);
+	SCIPheurSetData(heur, NULL);
+
+	return SCIP_OKAY;
+}
+
+
+/** execution method of primal heuristic */
+static
+SCIP_DECL_HEUREXEC(heurExecDd)
+{
+	assert(heur != NULL);
+	assert(strcmp(SCIPheurGetName(heur), HEUR_NAME) == 0);
+	assert(scip != NULL);
+	assert(result != NULL);
+
+	SCIP_HEURDATA* heurdata = SCIPheurGetData(heur);
+	assert(heurdata != NULL);
+
+	*result = SCIP_DIDNOTRUN;
+
+	if (SCIPisStopped(scip) || heurdata->disabled || !SCIPisLPConstructed(scip)) {
+		return SCIP_OKAY;
+	}
+
+	// If first run: construct structures to be used throughout solving process
+	if (heurdata->firstrun) {
+		heurdata->firstrun = false;
+		SCIP_CALL(init_dd_heuristic(scip, heurdata));
+
+		if (heurdata->disabled) {
+			return SCIP_OKAY;
+		}
+	}
+
+	assert(heurdata->lag_selector != NULL);
+
+	SCIP_COL** cols;
+	int ncols;
+	SCIP_CALL(SCIPgetLPColsData(scip, &cols, &ncols));
+
+	if (count_number_of_free_variables(scip, cols, ncols) == 0) {
+		return SCIP_OKAY;
+	}
+
+	// Disable BDD output
+	heurdata->options->quiet = true;
+
+	heurdata->output_stats->num_heur_dd_runs++;
+
+	bool found;
+	SCIP_CALL(construct_restricted_dd(scip, heur, heurdata->options, heurdata->output_stats, heurdata->lag_selector,
+	                                  &found));
+
+	if (found) {
+		heurdata->output_stats->num_heur_dd_improved++;
+		*result = SCIP_FOUNDSOL;
+	} else {
+		*result = SCIP_DIDNOTFIND;
+	}
+
+	return SCIP_OKAY;
+}
+
+
+
+/*
+ * primal heuristic specific interface methods
+ */
+
+/** creates the restricted dd primal heuristic and includes it in SCIP */
+SCIP_RETCODE SCIPincludeHeurDd(
+    SCIP*                 scip,               /**< SCIP data structure */
+    Options*              options,            /**< options */
+    OutputStats*          output_stats        /**< output statistics */
+)
+{
+	SCIP_HEURDATA* heurdata;
+	SCIP_HEUR* heur;
+
+	/* create dd primal heuristic data */
+	SCIP_CALL(SCIPallocMemory(scip, &heurdata));
+	heurdata->options = options;
+	heurdata->output_stats = output_stats;
+	heurdata->disabled = false;
+	heurdata->firstrun = true;
+	heurdata->lag_selector = NULL;
+
+	heur = NULL;
+
+	/* include primal heuristic */
+	SCIP_CALL(SCIPincludeHeurBasic(scip, &heur, HEUR_NAME, HEUR_DESC, HEUR_DISPCHAR, HEUR_PRIORITY, HEUR_FREQ,
+	                               HEUR_FREQOFS, HEUR_MAXDEPTH, HEUR_TIMING, HEUR_USESSUBSCIP, heurExecDd, heurdata));
+
+	assert(heur != NULL);
+
+	/* set non fundamental callbacks via setter functions */
+	SCIP_CALL(SCIPsetHeurCopy(scip, heur, heurCopyDd));
+	SCIP_CALL(SCIPsetHeurFree(scip, heur, heurFreeDd));
+	SCIP_CALL(SCIPsetHeurInit(scip, heur, heurInitDd));
+	SCIP_CALL(SCIPsetHeurExit(scip, heur, heurExitDd));
+	SCIP_CALL(SCIPsetHeurInitsol(scip, heur, heurInitsolDd));
+	SCIP_CALL(SCIPsetHeurExitsol(scip, heur, heurExitsolDd));
+
+	return SCIP_OKAY;
+}
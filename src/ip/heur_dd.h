@@ -0,0 +1,34 @@
+/**
+ * Decision diagram primal heuristic for SCIP
+ * @file   heur_dd.h
+ * @ingroup PRIMALHEURISTICS
+ * @brief  restricted dd heuristic
+ */
+
+/*---+----1----+----2----+----3----+----4----+----5----+----6----+----7----+----8----+----9----+----0----+----1----+----2*/
+
+#ifndef __SCIP_HEUR_DD_H__
+#define __SCIP_HEUR_DD_H__
+
+
+#include "scip/scip.h"
+#include "../util/options.hpp"
+#include "../util/output_stats.hpp"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** creates the restricted dd primal heuristic and includes it in SCIP */
+EXTERN
+SCIP_RETCODE SCIPincludeHeurDd(
+    SCIP*                 scip,               /**< SCIP data structure */
+    Options*              options,            /**< options */
+    OutputStats*          output_stats        /**< output statistics */
+);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -6,13 +6,42 @@
 #include <limits>
 #include "ip_scip.hpp"
 #include "relax_dd.h"
+#include "heur_dd.h"
+#include "prop_dd.h"
 #include "../util/stats.hpp"
 #include "../util/output_stats.hpp"
 
 using namespace std;
 
 
-SCIP_RETCODE solve_ip(ModelScip* model_builder, Options* options)
+/** Return a short name for the status of SCIP after solving */
+static
+const char* get_status_name(SCIP_STATUS status)
+{
+	switch (status) {
+	case SCIP_STATUS_OPTIMAL:
+		return "optimal";
+	case SCIP_STATUS_INFEASIBLE:
+		return "infeasible";
+	case SCIP_STATUS_UNBOUNDED:
+	case SCIP_STATUS_INFORUNBD:
+		return "unbounded";
+	case SCIP_STATUS_TIMELIMIT:
+		return "timelimit";
+	case SCIP_STATUS_MEMLIMIT:
+		return "memlimit";
+	case SCIP_STATUS_NODELIMIT:
+	case SCIP_STATUS_TOTALNODELIMIT:
+		return "nodelimit";
+	case SCIP_STATUS_USERINTERRUPT:
+		return "interrupted";
+	default:
+		return "other";
+	}
+}
+
+
+SCIP_RETCODE solve_ip(ModelScip* model_builder, Options* options, SolveResult* result)
 {
 	Stats stats;
 	stats.register_name("time");
@@ -27,11 +56,24 @@ SCIP_RETCODE solve_ip(ModelScip* model_builder, Options* options)
 	// Add bound generation system
 	if (options->generate_bounds) {
 		SCIP_CALL(SCIPincludeRelaxDd(scip, options, &output_stats));
+		if (options->lag_rc_fixing) {
+			SCIP_CALL(SCIPincludePropDd(scip, options, &output_stats));
+		}
+	}
+
+	// Add restricted DD primal heuristic
+	if (options->heur_dd) {
+		SCIP_CALL(SCIPincludeHeurDd(scip, options, &output_stats));
 	}
 
 	// Include default plugins
 	SCIP_CALL(SCIPincludeDefaultPlugins(scip));
 
+	// Silence SCIP before reading the model when the result is collected by the caller
+	if (result != NULL) {
+		SCIP_CALL(SCIPsetIntParam(scip, "display/verblevel", 0));
+	}
+
 	// Create IP model
 	model_builder->create_ip_model(scip);
 
@@ -40,6 +82,9 @@ SCIP_RETCODE solve_ip(ModelScip* model_builder, Options* options)
 	// Set options
 	SCIP_CALL(SCIPsetRealParam(scip, "limits/time", options->mip_time_limit));   // Time limit
 	SCIP_CALL(SCIPsetIntParam(scip, "parallel/maxnthreads", 1));   // Single-threaded
+	if (options->mip_memory_limit >= 0) {
+		SCIP_CALL(SCIPsetRealParam(scip, "limits/memory", options->mip_memory_limit));
+	}
 
 	// Aggregation and restarts are not compatible with DD bounds; disabled for baseline as well
 	SCIP_CALL(SCIPsetBoolParam(scip, "presolving/donotaggr", TRUE));
@@ -60,6 +105,21 @@ SCIP_RETCODE solve_ip(ModelScip* model_builder, Options* options)
 
 	SCIP_CALL(SCIPsolve(scip));
 
+	stats.end_timer(0);
+
+	if (result != NULL) {
+		result->status = get_status_name(SCIPgetStatus(scip));
+		result->primal_bound = SCIPgetPrimalbound(scip);
+		result->dual_bound = SCIPgetDualbound(scip);
+		result->time = stats.get_time(0);
+		result->nnodes = SCIPgetNNodes(scip);
+
+		// Other solves may be running, so block memory is not checked for leaks here
+		SCIP_CALL(SCIPfree(&scip));
+		result->output_stats = output_stats;
+		return SCIP_OKAY;
+	}
+
 	cout << "LP relaxation bound: " << SCIPgetFirstLPDualboundRoot(scip) << endl;
 
 	/* Statistics */
@@ -80,8 +140,6 @@ SCIP_RETCODE solve_ip(ModelScip* model_builder, Options* options)
 		cout << endl;
 	}
 
-	stats.end_timer(0);
-
 	return SCIP_OKAY;
 }
 
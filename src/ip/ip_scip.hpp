@@ -13,14 +13,18 @@
 #include "../util/util.hpp"
 #include "../util/stats.hpp"
 #include "../util/options.hpp"
+#include "../util/output_stats.hpp"
 #include "../core/solver.hpp"
 #include "../core/orderings.hpp"
 #include "../core/mergers.hpp"
 #include "../problem/model_scip.hpp"
 
 
-/** Model the problem as an IP and solve it */
-SCIP_RETCODE solve_ip(ModelScip* model_builder, Options* options);
+/**
+ * Model the problem as an IP and solve it. If result is given, the solve is silent and its summary is stored there
+ * instead of printed (used by batch mode, where several solves run concurrently).
+ */
+SCIP_RETCODE solve_ip(ModelScip* model_builder, Options* options, SolveResult* result = NULL);
 
 /** Set SCIP options based on the provided options */
 SCIP_RETCODE set_scip_options(SCIP* scip, Options* options);
@@ -0,0 +1,228 @@
+/**
+ * Decision diagram reduced-cost fixing for SCIP
+ * @file   prop_dd.cpp
+ * @brief  dd propagator
+ */
+
+/*---+----1----+----2----+----3----+----4----+----5----+----6----+----7----+----8----+----9----+----0----+----1----+----2*/
+
+#include <assert.h>
+#include <string.h>
+
+#include "prop_dd.h"
+#include "../util/util.hpp"
+
+#define PROP_NAME              "dd"
+#define PROP_DESC              "reduced-cost fixing with bounds from decision diagrams"
+#define PROP_PRIORITY          -1000000
+#define PROP_FREQ              1
+#define PROP_DELAY             FALSE
+#define PROP_TIMING            SCIP_PROPTIMING_BEFORELP | SCIP_PROPTIMING_AFTERLPLOOP
+
+
+
+/*
+ * Data structures
+ */
+
+/** propagator data */
+struct SCIP_PropData {
+	Options*              options;            /**< options */
+	OutputStats*          output_stats;       /**< output statistics */
+
+	vector<double>*       lb_zero;            /**< lower bound on subtree objective if variable is fixed to zero */
+	vector<double>*       lb_one;             /**< lower bound on subtree objective if variable is fixed to one */
+	SCIP_Longint          nodenumber;         /**< number of the node at which the bounds were computed (-1 if none) */
+	int                   nodedepth;          /**< depth of the node at which the bounds were computed */
+	SCIP_Real             lastcutoffbound;    /**< cutoff bound at the last propagation with the current bounds */
+	SCIP_Longint          lastnodenumber;     /**< node of the last propagation with the current bounds */
+};
+
+
+/*
+ * Main methods
+ */
+
+/** Return true if the current node is the node at which the bounds were computed or one of its descendants */
+static
+bool bounds_valid_at_current_node(SCIP* scip, SCIP_PROPDATA* propdata)
+{
+	if (propdata->nodenumber < 0) {
+		return false;
+	}
+
+	SCIP_NODE* node = SCIPgetCurrentNode(scip);
+	if (node == NULL || SCIPnodeGetDepth(node) < propdata->nodedepth) {
+		return false;
+	}
+	while (SCIPnodeGetDepth(node) > propdata->nodedepth) {
+		node = SCIPnodeGetParent(node);
+	}
+	return (SCIPnodeGetNumber(node) == propdata->nodenumber);
+}
+
+
+
+/*
+ * Callback methods of propagator
+ */
+
+
+// Default plugin methods
+#define propCopyDd NULL
+#define propInitDd NULL
+#define propExitDd NULL
+#define propInitsolDd NULL
+#define propExitsolDd NULL
+
+
+/** destructor of propagator to free user data (called when SCIP is exiting) */
+static
+SCIP_DECL_PROPFREE(propFreeDd)
+{
+	/*lint --e{715}*/
+	SCIP_PROPDATA* propdata;
+
+	propdata = SCIPpropGetData(prop);
+	delete propdata->lb_zero;
+	delete propdata->lb_one;
+	SCIPfreeMemory(scip, &propdata);
+	SCIPpropSetData(prop, NULL);
+
+	return SCIP_OKAY;
+}
+
+
+/** execution method of propagator */
+static
+SCIP_DECL_PROPEXEC(propExecDd)
+{
+	assert(prop != NULL);
+	assert(strcmp(SCIPpropGetName(prop), PROP_NAME) == 0);
+	assert(scip != NULL);
+	assert(result != NULL);
+
+	SCIP_PROPDATA* propdata = SCIPpropGetData(prop);
+	assert(propdata != NULL);
+
+	*result = SCIP_DIDNOTRUN;
+
+	if (!bounds_valid_at_current_node(scip, propdata)) {
+		return SCIP_OKAY;
+	}
+
+	SCIP_Real cutoffbound = SCIPgetCutoffbound(scip);
+	if (SCIPisInfinity(scip, cutoffbound)) {
+		return SCIP_OKAY;
+	}
+
+	// Nothing new to fix if neither the node nor the cutoff bound changed since the last call
+	SCIP_Longint nodenumber = SCIPnodeGetNumber(SCIPgetCurrentNode(scip));
+	if (nodenumber == propdata->lastnodenumber && SCIPisEQ(scip, cutoffbound, propdata->lastcutoffbound)) {
+		return SCIP_OKAY;
+	}
+	propdata->lastnodenumber = nodenumber;
+	propdata->lastcutoffbound = cutoffbound;
+
+	*result = SCIP_DIDNOTFIND;
+
+	SCIP_VAR** vars = SCIPgetVars(scip);
+	int nvars = MIN(SCIPgetNVars(scip), (int) propdata->lb_zero->size());
+
+	for (int i = 0; i < nvars; ++i) {
+		SCIP_VAR* var = vars[i];
+		assert(SCIPvarGetProbindex(var) == i);
+		if (SCIPisEQ(scip, SCIPvarGetLbLocal(var), SCIPvarGetUbLocal(var))) {
+			continue;
+		}
+
+		SCIP_Bool infeasible = FALSE;
+		SCIP_Bool tightened = FALSE;
+
+		if (SCIPisGE(scip, (*propdata->lb_one)[i], cutoffbound)) {
+			// No improving solution with variable at one
+			SCIP_CALL(SCIPtightenVarUb(scip, var, 0.0, FALSE, &infeasible, &tightened));
+		} else if (SCIPisGE(scip, (*propdata->lb_zero)[i], cutoffbound)) {
+			// No improving solution with variable at zero
+			SCIP_CALL(SCIPtightenVarLb(scip, var, 1.0, FALSE, &infeasible, &tightened));
+		}
+
+		if (infeasible) {
+			*result = SCIP_CUTOFF;
+			return SCIP_OKAY;
+		}
+		if (tightened) {
+			propdata->output_stats->num_rc_fixings++;
+			*result = SCIP_REDUCEDDOM;
+		}
+	}
+
+	return SCIP_OKAY;
+}
+
+
+
+/*
+ * propagator specific interface methods
+ */
+
+SCIP_RETCODE SCIPpropDdSetFixingBounds(SCIP* scip, const vector<double>& lb_zero, const vector<double>& lb_one)
+{
+	SCIP_PROP* prop = SCIPfindProp(scip, PROP_NAME);
+	if (prop == NULL) {
+		return SCIP_OKAY;
+	}
+
+	SCIP_PROPDATA* propdata = SCIPpropGetData(prop);
+	assert(propdata != NULL);
+	assert(lb_zero.size() == lb_one.size());
+
+	*(propdata->lb_zero) = lb_zero;
+	*(propdata->lb_one) = lb_one;
+	propdata->nodenumber = SCIPnodeGetNumber(SCIPgetCurrentNode(scip));
+	propdata->nodedepth = SCIPgetDepth(scip);
+	propdata->lastnodenumber = -1;
+
+	return SCIP_OKAY;
+}
+
+
+/** creates the dd propagator and includes it in SCIP */
+SCIP_RETCODE SCIPincludePropDd(
+    SCIP*                 scip,               /**< SCIP data structure */
+    Options*              options,            /**< options */
+    OutputStats*          output_stats        /**< output statistics */
+)
+{
+	SCIP_PROPDATA* propdata;
+	SCIP_PROP* prop;
+
+	/* create dd propagator data */
+	SCIP_CALL(SCIPallocMemory(scip, &propdata));
+	propdata->options = options;
+	propdata->output_stats = output_stats;
+	propdata->lb_zero = new vector<double>();
+	propdata->lb_one = new vector<double>();
+	propdata->nodenumber = -1;
+	propdata->nodedepth = -1;
+	propdata->lastcutoffbound = SCIPinfinity(scip);
+	propdata->lastnodenumber = -1;
+
+	prop = NULL;
+
+	/* include propagator */
+	SCIP_CALL(SCIPincludePropBasic(scip, &prop, PROP_NAME, PROP_DESC, PROP_PRIORITY, PROP_FREQ, PROP_DELAY,
+	                               PROP_TIMING, propExecDd, propdata));
+
+	assert(prop != NULL);
+
+	/* set non fundamental callbacks via setter functions */
+	SCIP_CALL(SCIPsetPropCopy(scip, prop, propCopyDd));
+	SCIP_CALL(SCIPsetPropFree(scip, prop, propFreeDd));
+	SCIP_CALL(SCIPsetPropInit(scip, prop, propInitDd));
+	SCIP_CALL(SCIPsetPropExit(scip, prop, propExitDd));
+	SCIP_CALL(SCIPsetPropInitsol(scip, prop, propInitsolDd));
+	SCIP_CALL(SCIPsetPropExitsol(scip, prop, propExitsolDd));
+
+	return SCIP_OKAY;
+}
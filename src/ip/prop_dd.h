@@ -0,0 +1,44 @@
+/**
+ * Decision diagram reduced-cost fixing for SCIP
+ * @file   prop_dd.h
+ * @ingroup PROPAGATORS
+ * @brief  dd propagator
+ */
+
+/*---+----1----+----2----+----3----+----4----+----5----+----6----+----7----+----8----+----9----+----0----+----1----+----2*/
+
+#ifndef __SCIP_PROP_DD_H__
+#define __SCIP_PROP_DD_H__
+
+
+#include <vector>
+#include "scip/scip.h"
+#include "../util/options.hpp"
+#include "../util/output_stats.hpp"
+
+using namespace std;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** creates the dd propagator and includes it in SCIP */
+EXTERN
+SCIP_RETCODE SCIPincludePropDd(
+    SCIP*                 scip,               /**< SCIP data structure */
+    Options*              options,            /**< options */
+    OutputStats*          output_stats        /**< output statistics */
+);
+
+/**
+ * Store lower bounds on the objective of the subtree of the current node when each variable (by problem index) is
+ * fixed to zero or one. The dd propagator fixes a variable to the opposite value whenever one of these bounds reaches
+ * the cutoff bound, at the current node and at any of its descendants. Does nothing if the propagator is not included.
+ */
+SCIP_RETCODE SCIPpropDdSetFixingBounds(SCIP* scip, const vector<double>& lb_zero, const vector<double>& lb_one);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
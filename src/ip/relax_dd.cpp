@@ -8,10 +8,17 @@
 
 #include <assert.h>
 
+#include <map>
+#include <set>
+
 #include "relax_dd.h"
+#include "relax_dd_async.hpp"
+#include "prop_dd.h"
 
 #include "../core/solver.hpp"
+#include "../bdd/bdd_pass.hpp"
 #include "../util/stats.hpp"
+#include "../util/profiler.hpp"
 
 #include "../problem/bp/bp_state.hpp"
 #include "../problem/bp/bp_reader_scip.hpp"
@@ -22,6 +29,7 @@
 #include "../lagrangian/lagrangian_pure.hpp"
 #include "../lagrangian/lg_subprob.hpp"
 #include "../lagrangian/lg_subprob_bdd.hpp"
+#include "../lagrangian/lg_subprob_decomposed.hpp"
 #include "../lagrangian/lg_subprob_feas.hpp"
 #include "../lagrangian/lg_subprob_feas_scip.hpp"
 #include "../lagrangian/lg_subprob_std.hpp"
@@ -73,9 +81,14 @@ struct SCIP_RelaxData {
 	int                   nruns;
 
 	SCIPRowVector*        lagrangian_rows;    /**< rows to put in Lagrangian relaxation; constructed at start */
+	SCIPRowMatrix*        lagrangian_matrix;  /**< sparse copy of the inequalities of lagrangian_rows; constructed at start */
+	vector<LagrangianConstraint>* relaxed_constrs;  /**< buffer for the relaxed constraints at a node, reused across runs */
+	vector<LagrangianConstraint>* spare_constrs;    /**< constraints left over from previous runs, kept for their memory */
+	map<SCIP_Longint, vector<double>>* warm_start_multipliers;  /**< final multipliers per row of lagrangian_matrix by node number */
 	bool                  disabled;           /**< if true, this relaxator does not run anymore */
 	bool                  firstrun;           /**< if true, the current run is the first run */
 	LagrangianDDConstraintSelector* lag_selector;  /**< constraint selector for Lagrangian relaxation and DD construction */
+	DDBoundJobPool*       job_pool;           /**< worker threads computing bounds in asynchronous mode; NULL if synchronous */
 };
 
 
@@ -168,64 +181,168 @@ vector<bool> get_fixed_variables(SCIP* scip, SCIP_COL** cols, int ncols)
 }
 
 
-SCIP_RETCODE construct_dd_from_bp_lag(SCIP* scip, Options* options, OutputStats* output_stats, double* dualbound,
-								      SCIPRowVector* lagrangian_rows, LagrangianDDConstraintSelector* lag_selector)
+/**
+ * Compute lower bounds (in SCIP's space) on the objective of the subproblem with each variable fixed to zero or one,
+ * using the longest paths of the DDs of the blocks of the subspace with respect to a Lagrangian objective, and pass them
+ * to the dd propagator. The constant includes lambda^T b and the objective constant of fixed variables.
+ */
+static
+SCIP_RETCODE set_dd_fixing_bounds(SCIP* scip, const vector<BDD*>& bdds, const vector<vector<int>>& blocks,
+                                  const vector<double>& lag_obj, double constant, const vector<int>& var_to_subvar,
+                                  const vector<int>& subvar_to_var, const vector<int>& fixed_vars)
 {
-	SCIP_ROW** rows;
-	SCIP_COL** cols;
-	int nrows;
-	int ncols;
-	Stats stats;
+	int nvars = lag_obj.size();
+	int nsubvars = subvar_to_var.size();
+
+	// Best values in each block, relative to the longest path of the block; other blocks take their longest path
+	vector<double> best_zero(nsubvars);
+	vector<double> best_one(nsubvars);
+	double longest_path = 0;
+	for (int b = 0; b < (int) bdds.size(); ++b) {
+		int block_size = blocks[b].size();
+
+		// Objective in DD space
+		vector<double> dd_obj(block_size);
+		for (int k = 0; k < block_size; ++k) {
+			dd_obj[k] = lag_obj[subvar_to_var[blocks[b][k]]];
+		}
 
-	stats.register_name("dd_time");
-	stats.start_timer(0);
+		vector<double> block_best_zero;
+		vector<double> block_best_one;
+		double block_longest_path = bdd_longest_path_by_var_value(bdds[b], dd_obj, block_best_zero, block_best_one);
+		for (int k = 0; k < block_size; ++k) {
+			best_zero[blocks[b][k]] = block_best_zero[k] - block_longest_path;
+			best_one[blocks[b][k]] = block_best_one[k] - block_longest_path;
+		}
+		longest_path += block_longest_path;
+	}
+	for (int i = 0; i < nsubvars; ++i) {
+		best_zero[i] += longest_path;
+		best_one[i] += longest_path;
+	}
 
-	stats.register_name("full_time");
-	stats.start_timer(1);
+	// Variables outside the subspace take their best value in the 0-1 cube, as in LagrangianSubproblemOracleSubspaceRelaxed
+	double outside_val = 0;
+	for (int i = 0; i < nvars; ++i) {
+		if (var_to_subvar[i] < 0) {
+			outside_val += MAX(0, lag_obj[i]);
+		}
+	}
 
-	SCIP_CALL(SCIPgetLPRowsData(scip, &rows, &nrows));
-	SCIP_CALL(SCIPgetLPColsData(scip, &cols, &ncols));
+	vector<double> lb_zero(nvars, -SCIPinfinity(scip));
+	vector<double> lb_one(nvars, -SCIPinfinity(scip));
+	for (int i = 0; i < nvars; ++i) {
+		if (fixed_vars[i] != DD_UNFIXED_VAR) {
+			continue;
+		}
 
-	vector<int> var_to_subvar;
-	vector<int> subvar_to_var;
+		double val_zero;
+		double val_one;
+		if (var_to_subvar[i] >= 0) {
+			val_zero = best_zero[var_to_subvar[i]] + outside_val;
+			val_one = best_one[var_to_subvar[i]] + outside_val;
+		} else {
+			val_zero = longest_path + outside_val - MAX(0, lag_obj[i]);
+			val_one = val_zero + lag_obj[i];
+		}
+
+		// Switch signs back to SCIP's minimization, with the same relaxation constant as the dual bound; a value of
+		// -infinity means that no path of the DD takes that value
+		lb_zero[i] = (val_zero == -numeric_limits<double>::infinity()) ? SCIPinfinity(scip) : -(val_zero + constant + 1e-6);
+		lb_one[i] = (val_one == -numeric_limits<double>::infinity()) ? SCIPinfinity(scip) : -(val_one + constant + 1e-6);
+	}
+
+	SCIP_CALL(SCIPpropDdSetFixingBounds(scip, lb_zero, lb_one));
+
+	return SCIP_OKAY;
+}
+
+
+SCIP_RETCODE get_dd_subspace(SCIP* scip, LagrangianDDConstraintSelector* lag_selector, DDSubspace* subspace)
+{
+	SCIP_COL** cols;
+	int ncols;
+
+	SCIP_CALL(SCIPgetLPColsData(scip, &cols, &ncols));
 
 	// Retrieve fixed variables and the values they are fixed to from SCIP
 	// (This may be expanded in preprocess_fixed_vars and we should not retrieve this information from SCIP from now on)
-	vector<int> fixed_vars = get_fixed_variables_binary_scip(scip, cols, ncols);
+	subspace->fixed_vars = get_fixed_variables_binary_scip(scip, cols, ncols);
 
 	// Expand the set of fixed variables if possible; these must be valid for the entire subproblem and not only the DD constraints
-	lag_selector->preprocess_fixed_vars(scip, fixed_vars);
+	lag_selector->preprocess_fixed_vars(scip, subspace->fixed_vars);
 
 	// Create mappings between original space and subspace of unfixed variables
-	lag_selector->create_mappings(scip, fixed_vars, var_to_subvar, subvar_to_var);
+	lag_selector->create_mappings(scip, subspace->fixed_vars, subspace->var_to_subvar, subspace->subvar_to_var);
 
 	// Subspace only includes unfixed variables, but it may contain even less since it ignores variables not in
 	// any relevant constraint for the DD. Note that these unfixed variables are only ignored for the DD step, and not
 	// in the Lagrangian relaxation.
-	assert((int) subvar_to_var.size() <= count(fixed_vars.begin(), fixed_vars.end(), DD_UNFIXED_VAR));
+	assert((int) subspace->subvar_to_var.size() <= count(subspace->fixed_vars.begin(), subspace->fixed_vars.end(),
+	        DD_UNFIXED_VAR));
 
 	// Get objective
-	vector<double> sub_obj = get_scip_objective_for_dd(scip, cols, ncols);
-	vector<double> full_obj = sub_obj;
-	double objconstant = get_scip_objective_constant_for_fixed_vars(scip, cols, ncols, fixed_vars);
+	subspace->sub_obj = get_scip_objective_for_dd(scip, cols, ncols);
+	subspace->full_obj = subspace->sub_obj;
+	subspace->objconstant = get_scip_objective_constant_for_fixed_vars(scip, cols, ncols, subspace->fixed_vars);
 
 	// Set fixed vars objective to zero; these are handled separately (objconstant)
-	// Note: This makes the values of optsol (further below) for fixed variables become junk, but ok because we do not use it
+	// Note: This makes the values of optsol for fixed variables become junk, but ok because we do not use it
 	for (int i = 0; i < ncols; ++i) {
-		if (fixed_vars[i] != DD_UNFIXED_VAR) {
-			sub_obj[i] = 0;
+		if (subspace->fixed_vars[i] != DD_UNFIXED_VAR) {
+			subspace->sub_obj[i] = 0;
 		}
 	}
 
-	SCIP_Real t_primal_bound = SCIPgetUpperbound(scip);
+	return SCIP_OKAY;
+}
 
-	SCIP_Real primal_bound = SCIPgetPrimalbound(scip);
 
+double get_dd_partial_bound(const DDSubspace* subspace, double dd_partial_bound)
+{
+	// Variables outside the DD are relaxed to the 0-1 cube, as in LagrangianSubproblemOracleSubspaceRelaxed
+	double bound = dd_partial_bound;
+	for (int i = 0; i < (int) subspace->var_to_subvar.size(); ++i) {
+		if (subspace->var_to_subvar[i] == -1 && subspace->fixed_vars[i] == DD_UNFIXED_VAR) {
+			bound += MAX(0, subspace->sub_obj[i]);
+		}
+	}
+	return bound;
+}
+
+
+/** Update memory statistics of decision diagrams with a finished construction */
+static
+void update_dd_memory_stats(OutputStats* output_stats, DDSolver* solver)
+{
+	const DDMemoryUsage& peak = solver->final_peak_memory;
+	if (peak.live() > output_stats->dd_peak_bytes) {
+		output_stats->dd_peak_bytes = peak.live();
+		output_stats->dd_peak_node_bytes = peak.nodes;
+		output_stats->dd_peak_state_bytes = peak.states;
+		output_stats->dd_peak_data_bytes = peak.node_data;
+		output_stats->dd_peak_table_bytes = peak.node_table;
+	}
+	output_stats->dd_final_bytes_total += solver->final_memory.live();
+	if (solver->final_memory_limit_reached) {
+		output_stats->num_dd_memory_limit++;
+	}
+	if (solver->final_memory_aborted) {
+		output_stats->num_dd_memory_aborted++;
+	}
+}
+
+
+/** Create DD solver for a subspace, with primal and dual pruning as set in the options */
+static
+DDSolver* create_dd_solver(SCIP* scip, Options* options, LagrangianDDConstraintSelector* lag_selector,
+                           DDSubspace& subspace)
+{
  	// primal bound taking into account transformations and only variables in subspace
- 	double subspace_primal_bound = -t_primal_bound - objconstant;
+ 	double subspace_primal_bound = -SCIPgetUpperbound(scip) - subspace.objconstant;
 
-	// Construct decision diagram
-	DDSolver* solver = lag_selector->create_solver(scip, var_to_subvar, subvar_to_var, fixed_vars, sub_obj, options);
+	DDSolver* solver = lag_selector->create_solver(scip, subspace.var_to_subvar, subspace.subvar_to_var,
+	                   subspace.fixed_vars, subspace.sub_obj, options);
 
 	// Primal pruning
 	if (options->lag_primal_pruning) {
@@ -241,7 +358,7 @@ SCIP_RETCODE construct_dd_from_bp_lag(SCIP* scip, Options* options, OutputStats*
 	// Dual pruning
 	if (options->lag_dual_pruning) {
 		// dual bound taking into account transformations and only variables in subspace
-		double subspace_dual_bound = -SCIPgetLocalLowerbound(scip) - objconstant;
+		double subspace_dual_bound = -SCIPgetLocalLowerbound(scip) - subspace.objconstant;
 
 		if (!options->lag_pure_bp) {
 			solver->problem->completion = new CliqueTableDomainCompletionBound();
@@ -252,22 +369,246 @@ SCIP_RETCODE construct_dd_from_bp_lag(SCIP* scip, Options* options, OutputStats*
 		}
 	}
 
-	BDD* bdd = solver->construct_decision_diagram(scip);
+	return solver;
+}
+
+
+/**
+ * Construct one DD per block of the subspace from its independent components, without pruning since bounds only apply
+ * to the whole subspace. Components with few variables are enumerated and combined into a single exact DD without
+ * running the DD construction; remaining isolated variables are grouped into one block. On return, blocks holds the
+ * block of each DD. Return false if some block is infeasible. The mappings of the blocks are stored in
+ * block_var_to_subvar and block_subvar_to_var, which must outlive the solvers. The former is shared by all blocks and
+ * maps each variable to its position in its own block; this suffices since blocks share no constraint of the DD.
+ */
+static
+bool construct_block_dds(SCIP* scip, Options* options, LagrangianDDConstraintSelector* lag_selector,
+                         DDSubspace& subspace, vector<vector<int>>& blocks,
+                         vector<int>& block_var_to_subvar, vector<vector<int>>& block_subvar_to_var,
+                         vector<DDSolver*>& solvers, vector<BDD*>& bdds)
+{
+	vector<vector<int>> components;
+	components.swap(blocks);
+
+	vector<int> enum_block;                        // subspace variables of enumerated components
+	vector<vector<int>> enum_component_vars;       // positions in enum_block of each enumerated component
+	vector<vector<vector<int>>> enum_component_sols;
+	vector<int> isolated_block;
+	for (const vector<int>& component : components) {
+		int size = component.size();
+		if (size <= options->lag_decompose_enum_size) {
+			vector<int> component_vars;
+			for (int i : component) {
+				component_vars.push_back(subspace.subvar_to_var[i]);
+			}
+			vector<vector<int>> sols;
+			if (lag_selector->enumerate_block_solutions(scip, component_vars, subspace.fixed_vars, options, sols)) {
+				if (sols.empty()) {
+					return false;
+				}
+				enum_component_vars.push_back(vector<int>());
+				for (int i : component) {
+					enum_component_vars.back().push_back(enum_block.size());
+					enum_block.push_back(i);
+				}
+				enum_component_sols.push_back(sols);
+				continue;
+			}
+		}
+		if (size == 1) {
+			isolated_block.push_back(component[0]);
+		} else {
+			blocks.push_back(component);
+		}
+	}
+	if (!isolated_block.empty()) {
+		blocks.push_back(isolated_block);
+	}
+
+	int nblocks = blocks.size();
+	block_var_to_subvar.assign(subspace.var_to_subvar.size(), -1);
+	block_subvar_to_var.assign(nblocks, vector<int>());
+
+	for (int b = 0; b < nblocks; ++b) {
+		for (int k = 0; k < (int) blocks[b].size(); ++k) {
+			int var = subspace.subvar_to_var[blocks[b][k]];
+			block_var_to_subvar[var] = k;
+			block_subvar_to_var[b].push_back(var);
+		}
+
+		DDSolver* solver = lag_selector->create_solver(scip, block_var_to_subvar, block_subvar_to_var[b],
+		                   subspace.fixed_vars, subspace.sub_obj, options);
+		solvers.push_back(solver);
+		BDD* bdd = solver->construct_decision_diagram(scip);
+		bdds.push_back(bdd);
+
+		if (bdd == NULL || SCIPisStopped(scip)) {
+			return (bdd != NULL);
+		}
+	}
+
+	// Enumerated components need no solver
+	if (!enum_block.empty()) {
+		vector<double> enum_obj;
+		for (int i : enum_block) {
+			enum_obj.push_back(subspace.sub_obj[subspace.subvar_to_var[i]]);
+		}
+		bdds.push_back(create_product_bdd(enum_component_vars, enum_component_sols, enum_obj));
+		blocks.push_back(enum_block);
+	}
+
+	return true;
+}
+
+
+/** Create the oracle over the DDs of the blocks of the subspace (NRP: non-relaxed paths only) */
+static
+LagrangianSubproblemOracle* create_blocks_oracle(const vector<BDD*>& bdds, const vector<vector<int>>& blocks,
+        int nsubvars, Options* options, bool nrp)
+{
+	vector<LagrangianSubproblemOracle*> block_oracles;
+	for (BDD* bdd : bdds) {
+		if (nrp) {
+			block_oracles.push_back(new LagrangianSubproblemOracleNRP(bdd));
+		} else {
+			block_oracles.push_back(create_bdd_oracle(bdd, options->lag_coarse_width));
+		}
+	}
+
+	// A single block is used directly if it is the whole subspace in order
+	bool identity = (blocks.size() == 1);
+	for (int k = 0; identity && k < (int) blocks[0].size(); ++k) {
+		identity = (blocks[0][k] == k);
+	}
+	if (identity) {
+		return block_oracles[0];
+	}
+	return new LagrangianSubproblemOracleDecomposed(block_oracles, blocks, nsubvars, options->lag_decompose_nthreads - 1);
+}
+
+
+/** Delete DD solvers along with their problems, and their DDs */
+static
+void delete_dd_solvers(vector<DDSolver*>& solvers, vector<BDD*>& bdds)
+{
+	for (BDD* bdd : bdds) {
+		delete bdd;
+	}
+	for (DDSolver* solver : solvers) {
+		delete solver->problem->inst;
+		delete solver->problem;
+		delete solver;
+	}
+}
+
+
+SCIP_RETCODE construct_dd_from_bp_lag(SCIP* scip, Options* options, OutputStats* output_stats, double* dualbound,
+								      const SCIPRowMatrix* lagrangian_matrix, vector<LagrangianConstraint>& relaxed_constrs,
+								      vector<LagrangianConstraint>& spare_constrs, vector<double>& row_multipliers,
+								      LagrangianDDConstraintSelector* lag_selector)
+{
+	SCIP_COL** cols;
+	int ncols;
+	Stats stats;
+
+	// Final multipliers are only returned if the Lagrangian relaxation is solved
+	vector<double> initial_row_multipliers;
+	initial_row_multipliers.swap(row_multipliers);
+
+	stats.register_name("dd_time");
+	stats.start_timer(0);
+	ProfileScope dd_scope("dd");
+
+	stats.register_name("full_time");
+	stats.start_timer(1);
+
+	SCIP_CALL(SCIPgetLPColsData(scip, &cols, &ncols));
+
+	DDSubspace subspace;
+	SCIP_CALL(get_dd_subspace(scip, lag_selector, &subspace));
+
+	const vector<int>& fixed_vars = subspace.fixed_vars;
+	const vector<int>& var_to_subvar = subspace.var_to_subvar;
+	const vector<int>& subvar_to_var = subspace.subvar_to_var;
+	const vector<double>& sub_obj = subspace.sub_obj;
+	const vector<double>& full_obj = subspace.full_obj;
+	double objconstant = subspace.objconstant;
+
+	SCIP_Real t_primal_bound = SCIPgetUpperbound(scip);
+
+	SCIP_Real primal_bound = SCIPgetPrimalbound(scip);
+
+ 	// primal bound taking into account transformations and only variables in subspace
+ 	double subspace_primal_bound = -t_primal_bound - objconstant;
+
+	// Blocks of the subspace with no DD constraint between them; each gets its own DD
+	vector<vector<int>> blocks;
+	if (options->lag_decompose) {
+		lag_selector->get_blocks(scip, subvar_to_var, options, blocks);
+	}
+
+	// Construct decision diagrams
+	vector<DDSolver*> solvers;
+	vector<BDD*> bdds;
+	vector<int> block_var_to_subvar;
+	vector<vector<int>> block_subvar_to_var;
+	bool feasible;
+	if (blocks.size() > 1) {
+		feasible = construct_block_dds(scip, options, lag_selector, subspace, blocks, block_var_to_subvar,
+		                               block_subvar_to_var, solvers, bdds);
+	} else {
+		blocks.assign(1, vector<int>());
+		for (int i = 0; i < (int) subvar_to_var.size(); ++i) {
+			blocks[0].push_back(i);
+		}
+		solvers.push_back(create_dd_solver(scip, options, lag_selector, subspace));
+		bdds.push_back(solvers[0]->construct_decision_diagram(scip));
+		feasible = (bdds[0] != NULL);
+	}
 
 	stats.end_timer(0);
+	dd_scope.end();
 	double bdd_time = stats.get_time(0);
 
+	bool exact = true;
+	int width = 0;
+	bool aborted = false;
+	for (DDSolver* solver : solvers) {
+		exact = exact && solver->final_exact;
+		width = MAX(width, solver->final_width);
+		aborted = aborted || solver->final_memory_aborted;
+		update_dd_memory_stats(output_stats, solver);
+	}
+
 	output_stats->bdd_time += bdd_time;
-	if (bdd == NULL || solver->final_exact) {
+	if ((!feasible && !aborted) || exact) {
 		output_stats->num_bdd_exact++;
 	}
 
 	if (SCIPisStopped(scip)) {
+		delete_dd_solvers(solvers, bdds);
+		return SCIP_OKAY;
+	}
+
+	// If construction was aborted at the memory limit, only the partial bound of a single DD is available
+	if (aborted) {
+		if (solvers.size() == 1) {
+			*dualbound = get_dd_partial_bound(&subspace, solvers[0]->final_partial_bound) + objconstant;
+			*dualbound += 1e-6; // relaxation constant for safety purposes (assuming minimization)
+		} else {
+			*dualbound = SCIPinfinity(scip);
+		}
+		delete_dd_solvers(solvers, bdds);
+		stats.end_timer(1);
+		if (options->bounds_verbose) {
+			cout << "BDD aborted at the memory limit; partial bound: " << *dualbound << endl;
+		}
 		return SCIP_OKAY;
 	}
 
 	// If BDD infeasible, then we can set the dual bound to -infinity
-	if (bdd == NULL) {
+	if (!feasible) {
+		delete_dd_solvers(solvers, bdds);
 		stats.end_timer(1);
 		if (options->bounds_verbose) {
 			cout << "BDD is infeasible" << endl;
@@ -278,12 +619,15 @@ SCIP_RETCODE construct_dd_from_bp_lag(SCIP* scip, Options* options, OutputStats*
 
 	// Primal bound by non-relaxed path
 	if (options->lag_generate_primal_nrp) {
-		LagrangianSubproblemOracle* primal_oracle = new LagrangianSubproblemOracleNRP(bdd);
+		LagrangianSubproblemOracle* primal_oracle = create_blocks_oracle(bdds, blocks, subvar_to_var.size(), options,
+		        true);
 		primal_oracle = new LagrangianSubproblemOracleSubspaceRelaxed(primal_oracle, subvar_to_var);
 		primal_oracle = new LagrangianSubproblemOracleFeasibilityCheck(primal_oracle,
-		        new FeasibilityCheckerSCIP(scip), full_obj, fixed_vars, primal_bound, options, output_stats);
+		        new FeasibilityCheckerSCIP(scip, NULL, lagrangian_matrix), full_obj, fixed_vars, primal_bound, options,
+		        output_stats);
 		vector<int> primal_sol;
 		primal_oracle->solve(sub_obj, primal_sol);
+		delete primal_oracle;
 	}
 
 	// Set up Lagrangian relaxation
@@ -291,12 +635,13 @@ SCIP_RETCODE construct_dd_from_bp_lag(SCIP* scip, Options* options, OutputStats*
 	// Note that the oracle must be relaxed to capture unfixed isolated variables outside subspace; fixed variables are handled
 	// through the zero objective
 	LagrangianSubproblemOracle* oracle = new LagrangianSubproblemOracleSubspaceRelaxed(
-	    new LagrangianSubproblemOracleBDD(bdd),
+	    create_blocks_oracle(bdds, blocks, subvar_to_var.size(), options, false),
 	    subvar_to_var);
 
 	if (options->lag_generate_primal) {
-		oracle = new LagrangianSubproblemOracleFeasibilityCheck(oracle, new FeasibilityCheckerSCIP(scip), full_obj,
-		        fixed_vars, primal_bound, options, output_stats);
+		oracle = new LagrangianSubproblemOracleFeasibilityCheck(oracle,
+		        new FeasibilityCheckerSCIP(scip, NULL, lagrangian_matrix), full_obj, fixed_vars, primal_bound, options,
+		        output_stats);
 	}
 
 	vector<int> optsol;
@@ -307,7 +652,10 @@ SCIP_RETCODE construct_dd_from_bp_lag(SCIP* scip, Options* options, OutputStats*
 	if (options->bounds_verbose) {
 		cout << endl;
 		cout << "BDD bound: " << optval << endl;
-		cout << "BDD width: " << solver->final_width << endl;
+		cout << "BDD width: " << width << endl;
+		if (bdds.size() > 1) {
+			cout << "BDD blocks: " << bdds.size() << endl;
+		}
 		cout << "BDD time: " << bdd_time << endl;
 		cout << endl;
 	}
@@ -326,16 +674,17 @@ SCIP_RETCODE construct_dd_from_bp_lag(SCIP* scip, Options* options, OutputStats*
 
 	// If time or iteration limit is zero, or no Lagrangian constraints:
 	// Do not solve Lagrangian relaxation; instead, only output the bound from the BDD
-	if (DBL_EQ(options->lag_cb_time_limit, 0) || options->lag_cb_iter_limit == 0 || lagrangian_rows->size() == 0) {
+	if (DBL_EQ(options->lag_cb_time_limit, 0) || options->lag_cb_iter_limit == 0 || lagrangian_matrix->size() == 0) {
 		stats.end_timer(1);
 		if (options->bounds_verbose) {
 			cout << "Dual bound: " << *dualbound << "   [Objective constant: " << objconstant << "]" << endl;
 		}
-		delete bdd;
-		delete solver->problem->inst;
-		delete solver->problem;
-		delete solver;
+		if (options->lag_rc_fixing && !options->lag_dual_pruning) {
+			SCIP_CALL(set_dd_fixing_bounds(scip, bdds, blocks, sub_obj, objconstant, var_to_subvar, subvar_to_var,
+			                               fixed_vars));
+		}
 		delete oracle;
+		delete_dd_solvers(solvers, bdds);
 		return SCIP_OKAY;
 	}
 
@@ -346,16 +695,14 @@ SCIP_RETCODE construct_dd_from_bp_lag(SCIP* scip, Options* options, OutputStats*
 			cout << "DD bound already prunes node; Lagrangian relaxation skipped" << endl;
 			cout << "Dual bound: " << *dualbound << "   [Objective constant: " << objconstant << "]" << endl;
 		}
-		delete bdd;
-		delete solver->problem->inst;
-		delete solver->problem;
-		delete solver;
 		delete oracle;
+		delete_dd_solvers(solvers, bdds);
 		return SCIP_OKAY;
 	}
 
 	// Create set of relaxed Lagrangian constraints, which take the fixed variables into account
-	vector<LagrangianConstraint> relaxed_constrs = lagrangian_extract_constraints_scip(scip, lagrangian_rows, true, fixed_vars);
+	vector<int> constr_rows;
+	lagrangian_extract_constraints(*lagrangian_matrix, true, fixed_vars, relaxed_constrs, &constr_rows, &spare_constrs);
 
 	// // Debugging info
 	// cout << "Relaxed constraints:" << endl;
@@ -364,7 +711,7 @@ SCIP_RETCODE construct_dd_from_bp_lag(SCIP* scip, Options* options, OutputStats*
 	// }
 
 	// Create subproblem for Lagrangian relaxation
-	LagrangianSubproblem* subproblem = new LagrangianSubproblemStandard(ncols, sub_obj, relaxed_constrs, oracle);
+	LagrangianSubproblemStandard* subproblem = new LagrangianSubproblemStandard(ncols, sub_obj, relaxed_constrs, oracle);
 
 
 	// Solve Lagrangian relaxation
@@ -377,12 +724,28 @@ SCIP_RETCODE construct_dd_from_bp_lag(SCIP* scip, Options* options, OutputStats*
 	stats.register_name("lr_time");
 	stats.start_timer(2);
 
-	LagrangianRelaxationCB lagrangian(relaxed_constrs, subproblem, options->lag_cb_time_limit, options);
 	LagrangianRelaxationParams params;
 	params.obj_limit = subspace_primal_bound;
 	params.max_noracleiters = options->lag_cb_iter_limit;
-	*dualbound = lagrangian.solve(params);
+	int nconstrs = relaxed_constrs.size();
+	if (!initial_row_multipliers.empty()) {
+		// Warm start: rows dropped at this node are ignored and rows dropped at the previous node start at zero
+		assert((int) initial_row_multipliers.size() == lagrangian_matrix->size());
+		params.initial_lambdas.resize(nconstrs);
+		for (int k = 0; k < nconstrs; ++k) {
+			params.initial_lambdas[k] = initial_row_multipliers[constr_rows[k]];
+		}
+	}
+	vector<double> multipliers;
+	*dualbound = solve_lagrangian_dual(relaxed_constrs, subproblem, options, params, multipliers);
 	*dualbound += objconstant;
+
+	if ((int) multipliers.size() == nconstrs) {
+		row_multipliers.assign(lagrangian_matrix->size(), 0);
+		for (int k = 0; k < nconstrs; ++k) {
+			row_multipliers[constr_rows[k]] = multipliers[k];
+		}
+	}
 	*dualbound += 1e-6; // relaxation constant for safety purposes (assuming minimization)
 
 	if (options->bounds_verbose) {
@@ -395,12 +758,17 @@ SCIP_RETCODE construct_dd_from_bp_lag(SCIP* scip, Options* options, OutputStats*
 		cout << "Total Lagrangian time: " << stats.get_time(2) << endl;
 	}
 
-	delete bdd;
-	delete solver->problem->inst;
-	delete solver->problem;
-	delete solver;
+	// Reduced-cost fixing with the final multipliers; not valid if the DD was pruned with the dual bound
+	if (options->lag_rc_fixing && !options->lag_dual_pruning && !multipliers.empty()) {
+		vector<double> lag_obj;
+		double lag_constant = subproblem->get_lagrangian_objective(multipliers, lag_obj);
+		SCIP_CALL(set_dd_fixing_bounds(scip, bdds, blocks, lag_obj, lag_constant + objconstant, var_to_subvar,
+		                               subvar_to_var, fixed_vars));
+	}
+
 	delete subproblem;
 	delete oracle;
+	delete_dd_solvers(solvers, bdds);
 
 	return SCIP_OKAY;
 }
@@ -424,6 +792,197 @@ int count_number_of_free_variables(SCIP* scip, SCIP_COL** cols, int ncols)
 }
 
 
+/** Store the open nodes of the tree in nodes, with the focus node last */
+static
+SCIP_RETCODE get_open_nodes(SCIP* scip, vector<SCIP_NODE*>& nodes)
+{
+	SCIP_NODE** leaves;
+	SCIP_NODE** children;
+	SCIP_NODE** siblings;
+	int nleaves;
+	int nchildren;
+	int nsiblings;
+	SCIP_CALL(SCIPgetOpenNodesData(scip, &leaves, &children, &siblings, &nleaves, &nchildren, &nsiblings));
+
+	nodes.clear();
+	nodes.insert(nodes.end(), leaves, leaves + nleaves);
+	nodes.insert(nodes.end(), children, children + nchildren);
+	nodes.insert(nodes.end(), siblings, siblings + nsiblings);
+	nodes.push_back(SCIPgetCurrentNode(scip));
+
+	return SCIP_OKAY;
+}
+
+
+/** Retrieve the multipliers stored for the closest ancestor of the current node, including itself, if any */
+static
+void get_warm_start_multipliers(SCIP* scip, SCIP_RELAXDATA* relaxdata, vector<double>& row_multipliers)
+{
+	map<SCIP_Longint, vector<double>>& stored = *relaxdata->warm_start_multipliers;
+
+	for (SCIP_NODE* node = SCIPgetCurrentNode(scip); node != NULL; node = SCIPnodeGetParent(node)) {
+		map<SCIP_Longint, vector<double>>::iterator it = stored.find(SCIPnodeGetNumber(node));
+		if (it != stored.end()) {
+			row_multipliers = it->second;
+			relaxdata->output_stats->num_lag_warm_starts++;
+			return;
+		}
+	}
+	row_multipliers.clear();
+}
+
+
+/** Store the multipliers of the current node, discarding those of nodes without open nodes in their subtrees */
+static
+SCIP_RETCODE store_warm_start_multipliers(SCIP* scip, SCIP_RELAXDATA* relaxdata, const vector<double>& row_multipliers)
+{
+	map<SCIP_Longint, vector<double>>& stored = *relaxdata->warm_start_multipliers;
+	stored[SCIPnodeGetNumber(SCIPgetCurrentNode(scip))] = row_multipliers;
+
+	// Clean up once in a while; amortized over the number of stored nodes
+	if ((SCIP_Longint) stored.size() <= 2 * SCIPgetNNodesLeft(scip) + 100) {
+		return SCIP_OKAY;
+	}
+
+	vector<SCIP_NODE*> nodes;
+	SCIP_CALL(get_open_nodes(scip, nodes));
+
+	set<SCIP_Longint> live_nodes;
+	for (SCIP_NODE* node : nodes) {
+		for (SCIP_NODE* ancestor = node; ancestor != NULL; ancestor = SCIPnodeGetParent(ancestor)) {
+			if (!live_nodes.insert(SCIPnodeGetNumber(ancestor)).second) {
+				break; // ancestors already inserted
+			}
+		}
+	}
+
+	for (map<SCIP_Longint, vector<double>>::iterator it = stored.begin(); it != stored.end();) {
+		if (live_nodes.count(it->first) == 0) {
+			it = stored.erase(it);
+		} else {
+			++it;
+		}
+	}
+
+	return SCIP_OKAY;
+}
+
+
+/** Create a job computing the bound of the current node in the background; all data is extracted from SCIP here */
+static
+SCIP_RETCODE create_dd_bound_job(SCIP* scip, Options* options, const SCIPRowMatrix* lagrangian_matrix,
+                                 LagrangianDDConstraintSelector* lag_selector, DDBoundJob** job)
+{
+	*job = new DDBoundJob();
+	(*job)->node_number = SCIPnodeGetNumber(SCIPgetCurrentNode(scip));
+	(*job)->node_depth = SCIPgetDepth(scip);
+	(*job)->options = *options;
+	(*job)->t_primal_bound = SCIPgetUpperbound(scip);
+
+	SCIP_CALL(get_dd_subspace(scip, lag_selector, &(*job)->subspace));
+	(*job)->solver = create_dd_solver(scip, &(*job)->options, lag_selector, (*job)->subspace);
+	lagrangian_extract_constraints(*lagrangian_matrix, true, (*job)->subspace.fixed_vars, (*job)->relaxed_constrs);
+
+	return SCIP_OKAY;
+}
+
+
+/**
+ * Apply the bounds of finished jobs to the open nodes in the subtrees of their nodes and cancel jobs whose subtrees
+ * have no open nodes left. The bound for the focus node is returned in focus_lowerbound (-infinity if none).
+ */
+static
+SCIP_RETCODE apply_dd_bound_jobs(SCIP* scip, SCIP_RELAXDATA* relaxdata, SCIP_Real* focus_lowerbound)
+{
+	OutputStats* output_stats = relaxdata->output_stats;
+	SCIP_Real cutoffbound = SCIPgetCutoffbound(scip);
+
+	*focus_lowerbound = -SCIPinfinity(scip);
+
+	vector<DDBoundJob*> finished;
+	relaxdata->job_pool->collect_finished(finished);
+
+	// Bounds of finished jobs by number of the node they were computed for
+	map<SCIP_Longint, SCIP_Real> job_bounds;
+	for (DDBoundJob* job : finished) {
+		if (!job->cancelled) {
+			SCIP_Real bound = job->infeasible ? SCIPinfinity(scip) : job->lowerbound;
+			job_bounds[job->node_number] = bound;
+
+			output_stats->bdd_time += job->bdd_time;
+			output_stats->num_runs++;
+			update_dd_memory_stats(output_stats, job->solver);
+			if (job->exact) {
+				output_stats->num_bdd_exact++;
+			}
+			if (SCIPisGE(scip, bound, cutoffbound)) {
+				output_stats->num_runs_pruned++;
+			}
+		}
+		delete job;
+	}
+
+	if (job_bounds.empty() && relaxdata->job_pool->size() == 0) {
+		return SCIP_OKAY;
+	}
+
+	// Open nodes, with the focus node last
+	vector<SCIP_NODE*> nodes;
+	SCIP_CALL(get_open_nodes(scip, nodes));
+
+	// Best bound for each node among its ancestors, and the set of nodes that still have open nodes in their subtrees
+	set<SCIP_Longint> live_nodes;
+	set<SCIP_Longint> improving_nodes;
+	vector<SCIP_Real> node_bounds(nodes.size(), -SCIPinfinity(scip));
+	for (int i = 0; i < (int) nodes.size(); ++i) {
+		SCIP_Longint best_ancestor = -1;
+		for (SCIP_NODE* ancestor = nodes[i]; ancestor != NULL; ancestor = SCIPnodeGetParent(ancestor)) {
+			SCIP_Longint number = SCIPnodeGetNumber(ancestor);
+			live_nodes.insert(number);
+			map<SCIP_Longint, SCIP_Real>::iterator it = job_bounds.find(number);
+			if (it != job_bounds.end() && it->second > node_bounds[i]) {
+				node_bounds[i] = it->second;
+				best_ancestor = number;
+			}
+		}
+		if (best_ancestor >= 0 && SCIPisGT(scip, node_bounds[i], SCIPnodeGetLowerbound(nodes[i]))) {
+			improving_nodes.insert(best_ancestor);
+		}
+	}
+	output_stats->num_runs_improved += improving_nodes.size();
+
+	// Update bounds of open nodes; SCIP prunes them if the bound reaches the cutoff bound
+	int nopen = nodes.size() - 1;
+	for (int i = 0; i < nopen; ++i) {
+		if (SCIPisGT(scip, node_bounds[i], SCIPnodeGetLowerbound(nodes[i]))) {
+			SCIP_CALL(SCIPupdateNodeLowerbound(scip, nodes[i], node_bounds[i]));
+		}
+	}
+	*focus_lowerbound = node_bounds[nopen];
+
+	// Jobs for nodes without open nodes in their subtrees are no longer needed
+	output_stats->num_async_cancelled += relaxdata->job_pool->cancel_unneeded([&live_nodes](DDBoundJob* job) {
+		return live_nodes.count(job->node_number) > 0;
+	});
+
+	return SCIP_OKAY;
+}
+
+
+/** Set the result of the relaxator in asynchronous mode given the bound from finished jobs for the focus node */
+static
+void set_async_result(SCIP* scip, SCIP_RELAXDATA* relaxdata, SCIP_Real focus_lowerbound, SCIP_Real* lowerbound,
+                      SCIP_RESULT* result)
+{
+	if (!relaxdata->options->lag_compute_only && !SCIPisInfinity(scip, -focus_lowerbound)) {
+		*lowerbound = focus_lowerbound;
+		*result = SCIP_SUCCESS;
+	} else {
+		*result = SCIP_DIDNOTRUN;
+	}
+}
+
+
 /** Solve sub-MIP; for debugging purposes (e.g. to check if bounds generated are valid) */
 static
 SCIP_RETCODE solve_submip(SCIP* scip, SCIP_Real* bound)
@@ -509,12 +1068,27 @@ SCIP_RETCODE init_dd_relaxator(SCIP* scip, SCIP_RELAXDATA* relaxdata)
 	} else {
 		relaxdata->lagrangian_rows = relaxdata->lag_selector->extract_lagrangian_rows(scip, rows, nrows, relaxdata->options);
 	}
+	relaxdata->lagrangian_matrix = new SCIPRowMatrix(scip, relaxdata->lagrangian_rows);
 	relaxdata->lag_selector->prepare_dd_construction(scip, rows, nrows, relaxdata->options);
 
 	if (relaxdata->options->bounds_verbose) {
 		cout << "Number of Lagrangian rows: " << relaxdata->lagrangian_rows->size() << endl;
 	}
 
+	if (relaxdata->options->lag_async) {
+		if (relaxdata->options->lag_generate_primal || relaxdata->options->lag_generate_primal_nrp
+		        || relaxdata->options->lag_validate_bounds || relaxdata->options->lag_rc_fixing
+		        || relaxdata->options->lag_run_once) {
+			cout << "Warning: Primal generation, validation, reduced-cost fixing, and run once are ignored in asynchronous mode" << endl;
+		}
+
+		int nthreads = relaxdata->options->lag_async_nthreads;
+		if (nthreads <= 0) {
+			nthreads = MAX(1, (int) thread::hardware_concurrency() - 1); // leave one core to SCIP
+		}
+		relaxdata->job_pool = new DDBoundJobPool(nthreads);
+	}
+
 	return SCIP_OKAY;
 }
 
@@ -529,7 +1103,20 @@ SCIP_RETCODE init_dd_relaxator(SCIP* scip, SCIP_RELAXDATA* relaxdata)
 #define relaxInitDd NULL
 #define relaxExitDd NULL
 #define relaxInitsolDd NULL
-#define relaxExitsolDd NULL
+
+
+/** solving process deinitialization method of relaxator (called before branch and bound process data is freed) */
+static
+SCIP_DECL_RELAXEXITSOL(relaxExitsolDd)
+{
+	SCIP_RELAXDATA* relaxdata = SCIPrelaxGetData(relax);
+
+	// Results of running jobs are no longer needed
+	delete relaxdata->job_pool;
+	relaxdata->job_pool = NULL;
+
+	return SCIP_OKAY;
+}
 
 
 /** destructor of relaxator to free user data (called when SCIP is exiting) */
@@ -544,7 +1131,12 @@ SCIP_DECL_RELAXFREE(relaxFreeDd)
 	SCIPclockFree(&relaxdata->relaxatorclock);
 	SCIPclockFree(&relaxdata->profilingclock);
 	delete relaxdata->lagrangian_rows;
+	delete relaxdata->lagrangian_matrix;
+	delete relaxdata->relaxed_constrs;
+	delete relaxdata->spare_constrs;
+	delete relaxdata->warm_start_multipliers;
 	delete relaxdata->lag_selector;
+	delete relaxdata->job_pool;
 	SCIPfreeMemory(scip, &relaxdata);
 	SCIPrelaxSetData(relax, NULL);
 
@@ -561,6 +1153,9 @@ SCIP_DECL_RELAXEXEC(relaxExecDd)
 	assert(scip != NULL);
 	assert(result != NULL);
 
+	profiler_set_node(SCIPnodeGetNumber(SCIPgetCurrentNode(scip)));
+	ProfileScope relaxator_scope("relaxator");
+
 	Stats stats;
 	SCIP_RELAXDATA* relaxdata = SCIPrelaxGetData(relax);
 	assert(relaxdata != NULL);
@@ -633,6 +1228,12 @@ SCIP_DECL_RELAXEXEC(relaxExecDd)
 
 	relaxdata->output_stats->num_attempts++;
 
+	// Asynchronous mode: apply bounds of finished jobs before deciding whether to dispatch a new one
+	SCIP_Real async_lowerbound = -SCIPinfinity(scip);
+	if (relaxdata->job_pool != NULL) {
+		SCIP_CALL(apply_dd_bound_jobs(scip, relaxdata, &async_lowerbound));
+	}
+
 	int nvars_threshold = (int)(relaxdata->options->lag_nvars_frac_to_apply * ncols + 1e-6);
 	if (relaxdata->options->lag_nvars_to_apply >= 0) {
 		// Assume only one between fraction or number of variables is set
@@ -640,6 +1241,20 @@ SCIP_DECL_RELAXEXEC(relaxExecDd)
 	}
 	if (nfree == 0 || nfree > nvars_threshold || nfree < relaxdata->options->lag_nvars_to_apply_min) {
 		*result = SCIP_DIDNOTRUN;
+		if (relaxdata->job_pool != NULL) {
+			set_async_result(scip, relaxdata, async_lowerbound, lowerbound, result);
+		}
+		return SCIP_OKAY;
+	}
+
+	// Asynchronous mode: dispatch job for current node; its bound is applied to the subtree when finished
+	if (relaxdata->job_pool != NULL) {
+		DDBoundJob* job;
+		SCIP_CALL(create_dd_bound_job(scip, relaxdata->options, relaxdata->lagrangian_matrix, relaxdata->lag_selector,
+		                              &job));
+		relaxdata->job_pool->submit(job);
+		relaxdata->output_stats->num_async_jobs++;
+		set_async_result(scip, relaxdata, async_lowerbound, lowerbound, result);
 		return SCIP_OKAY;
 	}
 
@@ -654,15 +1269,26 @@ SCIP_DECL_RELAXEXEC(relaxExecDd)
 		cout << "Run: " << relaxdata->nruns << " / Depth: " << SCIPgetDepth(scip) << endl;
 	}
 
-	stats.register_name("ddbp_genbound");
-	stats.start_timer("ddbp_genbound");
+	int genbound_timer = stats.register_name("ddbp_genbound");
+	stats.start_timer(genbound_timer);
+
+	// Start from the multipliers of the closest ancestor, if warm starting
+	vector<double> row_multipliers;
+	if (relaxdata->options->lag_warm_start) {
+		get_warm_start_multipliers(scip, relaxdata, row_multipliers);
+	}
 
 	SCIP_CALL(construct_dd_from_bp_lag(scip, relaxdata->options, relaxdata->output_stats, &dualbound,
-		relaxdata->lagrangian_rows, relaxdata->lag_selector));
+		relaxdata->lagrangian_matrix, *relaxdata->relaxed_constrs, *relaxdata->spare_constrs, row_multipliers,
+		relaxdata->lag_selector));
+
+	if (relaxdata->options->lag_warm_start && !row_multipliers.empty()) {
+		SCIP_CALL(store_warm_start_multipliers(scip, relaxdata, row_multipliers));
+	}
 
-	stats.end_timer("ddbp_genbound");
+	stats.end_timer(genbound_timer);
 
-	double genbound_time = stats.get_time("ddbp_genbound");
+	double genbound_time = stats.get_time(genbound_timer);
 
 	relaxdata->output_stats->bound_time += genbound_time;
 
@@ -780,6 +1406,13 @@ SCIP_RETCODE SCIPincludeRelaxDd(
 	relaxdata->nruns = 0;
 	relaxdata->disabled = false;
 	relaxdata->firstrun = true;
+	relaxdata->lagrangian_rows = NULL;
+	relaxdata->lagrangian_matrix = NULL;
+	relaxdata->relaxed_constrs = new vector<LagrangianConstraint>();
+	relaxdata->spare_constrs = new vector<LagrangianConstraint>();
+	relaxdata->warm_start_multipliers = new map<SCIP_Longint, vector<double>>();
+	relaxdata->lag_selector = NULL;
+	relaxdata->job_pool = NULL;
 
 	SCIP_CALL(SCIPclockCreate(&relaxdata->profilingclock, SCIP_CLOCKTYPE_CPU));
 	SCIPclockReset(relaxdata->profilingclock);
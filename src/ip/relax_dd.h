@@ -20,6 +20,16 @@
 #include "../core/orderings.hpp"
 #include "../lagrangian/lg_dd_selector_scip.hpp"
 
+/** Subspace of the variables unfixed at the current node, with objectives in the form used for decision diagrams */
+struct DDSubspace {
+	vector<int>           fixed_vars;         /**< value of each fixed variable; DD_UNFIXED_VAR if unfixed */
+	vector<int>           var_to_subvar;      /**< mapping from original variables to subspace (-1 if not in subspace) */
+	vector<int>           subvar_to_var;      /**< mapping from subspace to original variables */
+	vector<double>        full_obj;           /**< objective for DDs, including fixed variables */
+	vector<double>        sub_obj;            /**< objective for DDs, zero for fixed variables */
+	double                objconstant;        /**< objective contribution of fixed variables */
+};
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -38,9 +48,25 @@ vector<bool> get_fixed_variables(SCIP* scip);
 /** Extract the set of rows to be used as Lagrangian relaxation */
 SCIP_RETCODE extract_lagrangian_rows_set_packing(SCIP* scip, vector<SCIP_ROW*>& lagrangian_rows);
 
-/** Construct decision diagram and run Lagrangian relaxation using given constraint selector */
+/**
+ * Construct decision diagram and run Lagrangian relaxation using given constraint selector. row_multipliers holds the
+ * starting multipliers per row of lagrangian_matrix (empty: zero) and is replaced by the final ones (empty if the
+ * Lagrangian relaxation was not solved). relaxed_constrs and spare_constrs are buffers reused across calls (see
+ * lagrangian_extract_constraints).
+ */
 SCIP_RETCODE construct_dd_from_bp_lag(SCIP* scip, Options* options, OutputStats* output_stats, double* dualbound,
-									  SCIPRowVector* lagrangian_rows, LagrangianDDConstraintSelector* lag_selector);
+									  const SCIPRowMatrix* lagrangian_matrix, vector<LagrangianConstraint>& relaxed_constrs,
+									  vector<LagrangianConstraint>& spare_constrs, vector<double>& row_multipliers,
+									  LagrangianDDConstraintSelector* lag_selector);
+
+/** Retrieve the subspace of unfixed variables at the current node, as defined by the given constraint selector */
+SCIP_RETCODE get_dd_subspace(SCIP* scip, LagrangianDDConstraintSelector* lag_selector, DDSubspace* subspace);
+
+/**
+ * Return a bound for the subspace from the partial bound of a DD construction aborted at the memory limit, adding the
+ * positive objective of unfixed variables left out of the DD (the bound is not shifted by the objective constant)
+ */
+double get_dd_partial_bound(const DDSubspace* subspace, double dd_partial_bound);
 
 /** Return objective coefficients from SCIP in a form to be used for decision diagrams */
 vector<double> get_scip_objective_for_dd(SCIP* scip, SCIP_COL** cols, int ncols);
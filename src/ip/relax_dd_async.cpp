@@ -0,0 +1,207 @@
+/**
+ * Asynchronous computation of decision diagram bounds for SCIP nodes
+ */
+
+#include <algorithm>
+#include <cassert>
+
+#include "relax_dd_async.hpp"
+#include "../util/stats.hpp"
+#include "../util/profiler.hpp"
+
+#include "../lagrangian/lagrangian.hpp"
+#include "../lagrangian/lg_subprob_bdd.hpp"
+#include "../lagrangian/lg_subprob_std.hpp"
+#include "../lagrangian/lg_subprob_subrelaxed.hpp"
+
+
+void run_dd_bound_job(DDBoundJob* job)
+{
+	// Attribute the scopes of the job to the node it was created for
+	profiler_set_node(job->node_number);
+	ProfileScope job_scope("relaxator_job");
+
+	Stats stats;
+	stats.register_name("dd_time");
+	stats.start_timer(0);
+	ProfileScope dd_scope("dd");
+
+	// Built without SCIP; the interrupt flag takes the place of SCIP's interrupt
+	job->solver->interrupt_flag = &job->cancelled;
+	BDD* bdd = job->solver->construct_decision_diagram(NULL);
+
+	stats.end_timer(0);
+	dd_scope.end();
+	job->bdd_time = stats.get_time(0);
+
+	if (job->cancelled) {
+		delete bdd;
+		return;
+	}
+
+	job->exact = (bdd == NULL || job->solver->final_exact);
+
+	// If construction was aborted at the memory limit, only the partial bound is available
+	if (bdd == NULL && job->solver->final_memory_aborted) {
+		job->exact = false;
+		double dualbound = get_dd_partial_bound(&job->subspace, job->solver->final_partial_bound)
+		                   + job->subspace.objconstant;
+		dualbound += 1e-6; // relaxation constant for safety purposes (assuming minimization)
+		job->lowerbound = -dualbound;
+		return;
+	}
+
+	// If BDD infeasible, the subtree of the node can be pruned
+	if (bdd == NULL) {
+		job->infeasible = true;
+		return;
+	}
+
+	const vector<double>& sub_obj = job->subspace.sub_obj;
+	double objconstant = job->subspace.objconstant;
+
+	LagrangianSubproblemOracle* oracle = new LagrangianSubproblemOracleSubspaceRelaxed(
+	    create_bdd_oracle(bdd, job->options.lag_coarse_width),
+	    job->subspace.subvar_to_var);
+
+	vector<int> optsol;
+	double dualbound = oracle->solve(sub_obj, optsol) + objconstant;
+	dualbound += 1e-6; // relaxation constant for safety purposes (assuming minimization)
+
+	// Lagrangian relaxation, unless disabled or the DD bound already prunes the node
+	bool run_lagrangian = !(DBL_EQ(job->options.lag_cb_time_limit, 0) || job->options.lag_cb_iter_limit == 0
+	                        || job->relaxed_constrs.size() == 0 || DBL_LT(job->t_primal_bound, -dualbound));
+
+	if (run_lagrangian) {
+		LagrangianSubproblemStandard* subproblem = new LagrangianSubproblemStandard(sub_obj.size(), sub_obj,
+		        job->relaxed_constrs, oracle);
+
+		LagrangianRelaxationParams params;
+		params.obj_limit = -job->t_primal_bound - objconstant;
+		params.max_noracleiters = job->options.lag_cb_iter_limit;
+		vector<double> multipliers;
+		dualbound = solve_lagrangian_dual(job->relaxed_constrs, subproblem, &job->options, params, multipliers,
+		                                  &job->cancelled) + objconstant;
+		dualbound += 1e-6; // relaxation constant for safety purposes (assuming minimization)
+
+		delete subproblem;
+	}
+
+	job->lowerbound = -dualbound;
+
+	delete oracle;
+	delete bdd;
+}
+
+
+DDBoundJobPool::DDBoundJobPool(int nthreads) : shutdown(false)
+{
+	assert(nthreads > 0);
+	for (int i = 0; i < nthreads; ++i) {
+		workers.push_back(thread(&DDBoundJobPool::run_worker, this));
+	}
+}
+
+
+DDBoundJobPool::~DDBoundJobPool()
+{
+	{
+		lock_guard<mutex> guard(lock);
+		shutdown = true;
+		for (DDBoundJob* job : running) {
+			job->cancelled = true;
+		}
+	}
+	job_available.notify_all();
+
+	for (thread& worker : workers) {
+		worker.join();
+	}
+
+	for (DDBoundJob* job : queued) {
+		delete job;
+	}
+	for (DDBoundJob* job : finished) {
+		delete job;
+	}
+}
+
+
+void DDBoundJobPool::submit(DDBoundJob* job)
+{
+	{
+		lock_guard<mutex> guard(lock);
+		queued.push_back(job);
+	}
+	job_available.notify_one();
+}
+
+
+void DDBoundJobPool::collect_finished(vector<DDBoundJob*>& collected)
+{
+	lock_guard<mutex> guard(lock);
+	collected.insert(collected.end(), finished.begin(), finished.end());
+	finished.clear();
+}
+
+
+int DDBoundJobPool::cancel_unneeded(function<bool(DDBoundJob*)> is_needed)
+{
+	lock_guard<mutex> guard(lock);
+	int ncancelled = 0;
+
+	deque<DDBoundJob*> still_queued;
+	for (DDBoundJob* job : queued) {
+		if (is_needed(job)) {
+			still_queued.push_back(job);
+		} else {
+			delete job;
+			ncancelled++;
+		}
+	}
+	queued.swap(still_queued);
+
+	// Running jobs stop at their next check and are returned as finished
+	for (DDBoundJob* job : running) {
+		if (!job->cancelled && !is_needed(job)) {
+			job->cancelled = true;
+			ncancelled++;
+		}
+	}
+
+	return ncancelled;
+}
+
+
+int DDBoundJobPool::size()
+{
+	lock_guard<mutex> guard(lock);
+	return queued.size() + running.size();
+}
+
+
+void DDBoundJobPool::run_worker()
+{
+	while (true) {
+		DDBoundJob* job;
+		{
+			unique_lock<mutex> guard(lock);
+			job_available.wait(guard, [this] { return shutdown || !queued.empty(); });
+			if (shutdown) {
+				return;
+			}
+			// Most recent nodes first, since their descendants are the ones SCIP is about to process
+			job = queued.back();
+			queued.pop_back();
+			running.push_back(job);
+		}
+
+		run_dd_bound_job(job);
+
+		{
+			lock_guard<mutex> guard(lock);
+			running.erase(find(running.begin(), running.end(), job));
+			finished.push_back(job);
+		}
+	}
+}
@@ -0,0 +1,100 @@
+/**
+ * Asynchronous computation of decision diagram bounds for SCIP nodes
+ */
+
+#ifndef RELAX_DD_ASYNC_HPP_
+#define RELAX_DD_ASYNC_HPP_
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "relax_dd.h"
+#include "../core/solver.hpp"
+#include "../lagrangian/lg_constraint.hpp"
+#include "../util/options.hpp"
+
+using namespace std;
+
+
+/**
+ * DD and Lagrangian bound computation for a single SCIP node. All data is extracted from SCIP when the job is created
+ * so that the job can run in a worker thread without calling SCIP.
+ */
+struct DDBoundJob {
+	SCIP_Longint                  node_number;             /**< number of the node the bound is computed for */
+	int                           node_depth;              /**< depth of the node the bound is computed for */
+
+	Options                       options;                 /**< copy of options, owned by the job */
+	DDSubspace                    subspace;                /**< subspace of unfixed variables at the node */
+	DDSolver*                     solver;                  /**< DD solver for the subspace (owned by job) */
+	vector<LagrangianConstraint>  relaxed_constrs;         /**< constraints for the Lagrangian relaxation */
+	double                        t_primal_bound;          /**< primal bound in SCIP's transformed space at creation */
+
+	atomic<bool>                  cancelled;               /**< set if the result is no longer needed */
+
+	bool                          infeasible;              /**< result: no solution in the subtree of the node */
+	double                        lowerbound;              /**< result: lower bound in SCIP's transformed space */
+	bool                          exact;                   /**< result: DD is exact */
+	double                        bdd_time;                /**< result: time to build the DD */
+
+	DDBoundJob() : solver(NULL), cancelled(false), infeasible(false), lowerbound(0), exact(false), bdd_time(0) {}
+
+	~DDBoundJob()
+	{
+		if (solver != NULL) {
+			delete solver->problem->inst;
+			delete solver->problem;
+			delete solver;
+		}
+	}
+};
+
+
+/** Compute the result of a job; does not call SCIP */
+void run_dd_bound_job(DDBoundJob* job);
+
+
+/**
+ * Pool of worker threads running bound jobs. Jobs are owned by the pool until they are collected as finished;
+ * jobs cancelled before they start are deleted by the pool.
+ */
+class DDBoundJobPool
+{
+public:
+	DDBoundJobPool(int nthreads);
+
+	/** Cancel all jobs and wait for the workers to finish */
+	~DDBoundJobPool();
+
+	/** Queue a job */
+	void submit(DDBoundJob* job);
+
+	/** Move finished jobs (including interrupted ones, with cancelled set) to the given vector; caller takes ownership */
+	void collect_finished(vector<DDBoundJob*>& finished);
+
+	/** Cancel queued and running jobs for which is_needed returns false; return number of jobs cancelled */
+	int cancel_unneeded(function<bool(DDBoundJob*)> is_needed);
+
+	/** Number of jobs queued or running */
+	int size();
+
+private:
+	vector<thread>                workers;
+	mutex                         lock;
+	condition_variable            job_available;
+	deque<DDBoundJob*>            queued;
+	vector<DDBoundJob*>           running;
+	vector<DDBoundJob*>           finished;
+	bool                          shutdown;
+
+	/** Main loop of a worker */
+	void run_worker();
+};
+
+
+#endif /* RELAX_DD_ASYNC_HPP_ */
@@ -4,7 +4,10 @@
 #include <limits>
 #include "../core/mergers.hpp"
 #include "../core/solver.hpp"
+#include "../util/profiler.hpp"
+#include "../util/event_counters.hpp"
 #include "lg_master_subgradient.hpp"
+#include "lg_master_bundle.hpp"
 #include "lagrangian_cb.hpp"
 
 #ifdef SOLVER_CPLEX
@@ -12,7 +15,7 @@
 #endif
 
 
-void LagrangianRelaxation::solve(LagrangianRelaxationParams params)
+double LagrangianRelaxation::solve(LagrangianRelaxationParams params)
 {
 	if (master == NULL || subproblem == NULL) {
 		cout << "Error: Lagrangian relaxation called without a model" << endl;
@@ -20,13 +23,22 @@ void LagrangianRelaxation::solve(LagrangianRelaxationParams params)
 	}
 
 	int nrows_lag = master->get_nrows_lag();
-	vector<double> lambdas(nrows_lag, 0); // Lagrange multipliers, initialized to zero
+	vector<double> lambdas(nrows_lag, 0); // Lagrange multipliers, initialized to zero unless warm started
+	if ((int) params.initial_lambdas.size() == nrows_lag) {
+		lambdas = params.initial_lambdas;
+	}
 
-	double primal_value;
+	double primal_value = 0;
 	double dual_value;
+	double gap = numeric_limits<double>::infinity();
 	double best_dual_value = numeric_limits<double>::infinity();
+	vector<double> best_lambdas = lambdas;
 
+	// Each iteration calls the oracle once
 	int max_niters = (params.max_niters >= 0) ? params.max_niters : numeric_limits<int>::max();
+	if (params.max_noracleiters >= 0) {
+		max_niters = MIN(max_niters, params.max_noracleiters);
+	}
 
 	Stats stats;
 	stats.register_name("subprob");
@@ -34,57 +46,132 @@ void LagrangianRelaxation::solve(LagrangianRelaxationParams params)
 
 	int it;
 	for (it = 0; it < max_niters; ++it) {
+		COUNT_EVENT(EVENT_LAG_ITERATIONS);
+		COUNT_EVENT(EVENT_LAG_EVALUATIONS);
 
+		ProfileScope subproblem_scope("subproblem");
 		stats.start_timer(0);
 
 		// Obtain optimal solution and value for subproblem
+		// Subproblem may be solved inexactly far from convergence; sp_optval is then only an upper bound
 		vector<int> sp_optsol;
-		double sp_optval = subproblem->solve(lambdas, sp_optsol);
+		double sp_optval;
+		double sp_solval;
+		vector<vector<int>> sp_sols;
+		vector<double> sp_solvals;
+		if (params.nsols > 1) {
+			sp_optval = subproblem->solve_multiple(lambdas, params.nsols, sp_sols, sp_solvals);
+			sp_optsol = sp_sols[0];
+			sp_solval = sp_optval;
+		} else if (params.inexact_relprec > 0) {
+			double relprec = MIN(params.inexact_relprec, 0.1 * gap);
+			sp_optval = subproblem->solve_inexact(lambdas, relprec, sp_optsol, sp_solval);
+		} else {
+			sp_optval = subproblem->solve(lambdas, sp_optsol);
+			sp_solval = sp_optval;
+		}
 
 		stats.end_timer(0);
+		subproblem_scope.end();
+		ProfileScope master_scope("master");
 		stats.start_timer(1);
 
+		if (sp_optval < best_dual_value) {
+			best_dual_value = sp_optval;
+			best_lambdas = lambdas;
+		}
+
 		// Update master with subproblem solution
 		// E.g. If cutting plane method, add cut
-		master->update(sp_optsol, sp_optval, lambdas);
+		master->update_inexact(sp_optsol, sp_solval, sp_optval, lambdas);
+		for (int k = 1; k < (int) sp_sols.size(); ++k) {
+			master->update_extra(sp_sols[k], sp_solvals[k], lambdas);
+		}
 
 		// Update Lagrangian dual and Lagrange multipliers by solving master LP
 		primal_value = master->solve(lambdas);
 
 		stats.end_timer(1);
+		master_scope.end();
 
 		dual_value = sp_optval;
-		if (dual_value < best_dual_value) {
-			best_dual_value = dual_value;
-		}
-		double gap = abs(primal_value - best_dual_value) / (1 + abs(best_dual_value));
+		gap = abs(primal_value - best_dual_value) / (1 + abs(best_dual_value));
 
 		// Print iteration information
-		cout << "--- Iteration " << it + 1;
-		cout << " -  Primal: " << primal_value;
-		cout << " / Dual: " << dual_value;
-		cout << " / Best Dual: " << best_dual_value;
-		cout << " / Gap: " << gap ;
-		cout << " / [Time: M: " << stats.get_time(1) << " / SP: " << stats.get_time(0) << "]";
-		cout << endl;
+		if (params.verbose) {
+			cout << "--- Iteration " << it + 1;
+			cout << " -  Primal: " << primal_value;
+			cout << " / Dual: " << dual_value;
+			cout << " / Best Dual: " << best_dual_value;
+			cout << " / Gap: " << gap ;
+			cout << " / [Time: M: " << stats.get_time(1) << " / SP: " << stats.get_time(0) << "]";
+			cout << endl;
+		}
 
 		// Stopping condition
 		if (gap <= params.convergence_tol) {
 			it++; // for consistency in number of iterations between different stopping conditions
 			break;
 		}
+		if (DBL_LE(best_dual_value, params.obj_limit)) {
+			if (params.verbose) {
+				cout << "Objective limit reached (" << params.obj_limit << ")" << endl;
+			}
+			it++;
+			break;
+		}
 		if (params.time_limit >= 0 && stats.get_time(0) + stats.get_time(1) >= params.time_limit) {
-			cout << "Time limit reached" << endl;
+			if (params.verbose) {
+				cout << "Time limit reached" << endl;
+			}
 			it++;
 			break;
 		}
+		if (interrupt_flag != NULL && *interrupt_flag) {
+			it++;
+			break;
+		}
+	}
+
+	multipliers = best_lambdas;
+
+	if (params.verbose) {
+		cout << endl;
+		cout << "Number of iterations: " << it << endl;
+		cout << "Dual bound: " << best_dual_value << endl;
+		cout << "Primal (wrt Lagrangian) bound: " << primal_value << endl;;
+		cout << "Total master time: " << stats.get_time(1) << endl;
+		cout << "Total subproblem time: " << stats.get_time(0) << endl;
 	}
 
-	cout << endl;
-	cout << "Number of iterations: " << it << endl;
-	cout << "Dual bound: " << best_dual_value << endl;
-	cout << "Primal (wrt Lagrangian) bound: " << primal_value << endl;;
-	cout << "Total master time: " << stats.get_time(1) << endl;
-	cout << "Total subproblem time: " << stats.get_time(0) << endl;
+	return best_dual_value;
+}
+
+
+double solve_lagrangian_dual(const vector<LagrangianConstraint>& relaxed_constrs, LagrangianSubproblem* subproblem,
+                             Options* options, LagrangianRelaxationParams params, vector<double>& multipliers,
+                             const atomic<bool>* interrupt_flag)
+{
+	ProfileScope lagrangian_scope("lagrangian");
+	double bound;
+
+	if (options->lag_bundle) {
+		LagrangianMasterProblemBundle master(relaxed_constrs);
+		LagrangianRelaxation lagrangian(&master, subproblem);
+		lagrangian.interrupt_flag = interrupt_flag;
+		params.time_limit = options->lag_cb_time_limit;
+		params.convergence_tol = 1e-7; // same relative precision as ConicBundle
+		params.inexact_relprec = 0.1;
+		params.nsols = options->lag_nsubgradients;
+		params.verbose = false;
+		bound = lagrangian.solve(params);
+		multipliers = lagrangian.multipliers;
+	} else {
+		LagrangianRelaxationCB lagrangian(relaxed_constrs, subproblem, options->lag_cb_time_limit, options);
+		lagrangian.interrupt_flag = interrupt_flag;
+		bound = lagrangian.solve(params);
+		multipliers = lagrangian.multipliers;
+	}
 
+	return bound;
 }
@@ -1,9 +1,12 @@
 #ifndef LAGRANGIAN_HPP_
 #define LAGRANGIAN_HPP_
 
+#include <atomic>
 #include <vector>
 #include "lg_master.hpp"
 #include "lg_subprob.hpp"
+#include "lg_constraint.hpp"
+#include "../util/options.hpp"
 
 
 struct LagrangianRelaxationParams {
@@ -11,7 +14,11 @@ struct LagrangianRelaxationParams {
 	int max_niters          = -1;            /**< maximum number of iterations for the Lagrangian relaxation (-1: no limit) */
 	int max_noracleiters    = -1;            /**< maximum number of oracle calls for the Lagrangian relaxation (-1: no limit) */
 	double time_limit       = -1;            /**< time limit */
-	double obj_limit        = -numeric_limits<double>::infinity();   /**< objective limit (only implemented for CB) */
+	double obj_limit        = -numeric_limits<double>::infinity();   /**< stop once the dual bound is at most this limit */
+	vector<double> initial_lambdas;          /**< starting Lagrange multipliers, e.g. from a parent node (empty: zero) */
+	double inexact_relprec  = 0;             /**< relative precision of subproblem solves, tightened with the gap (0: exact) */
+	int nsols               = 1;             /**< number of best subproblem solutions per iteration (extra ones add cuts) */
+	bool verbose            = true;          /**< print information per iteration (only implemented for native master) */
 };
 
 
@@ -24,13 +31,26 @@ private:
 
 public:
 
+	vector<double>           multipliers;        /**< multipliers attaining the returned bound; set by solve */
+	const atomic<bool>*      interrupt_flag;     /**< if not NULL, solve stops once it is set */
+
 	LagrangianRelaxation(LagrangianMasterProblem* _master, LagrangianSubproblem* _subproblem) :
-		master(_master), subproblem(_subproblem) {}
+		master(_master), subproblem(_subproblem), interrupt_flag(NULL) {}
 
 	~LagrangianRelaxation() {}
 
-	void solve(LagrangianRelaxationParams params);
+	/** Solve the Lagrangian dual and return the best (smallest) dual bound found */
+	double solve(LagrangianRelaxationParams params);
 };
 
 
+/**
+ * Solve the Lagrangian dual over relaxed_constrs with the master set in the options (ConicBundle or the native bundle
+ * method), with the time limit from the options. Store the multipliers attaining the returned bound in multipliers.
+ */
+double solve_lagrangian_dual(const vector<LagrangianConstraint>& relaxed_constrs, LagrangianSubproblem* subproblem,
+                             Options* options, LagrangianRelaxationParams params, vector<double>& multipliers,
+                             const atomic<bool>* interrupt_flag = NULL);
+
+
 #endif // LAGRANGIAN_HPP_
\ No newline at end of file
@@ -15,7 +15,7 @@ double LagrangianRelaxationCB::solve(LagrangianRelaxationParams params)
 	int nrows_lag = relaxed_constrs.size();
 
 	CBSolver solver;
-	LagrangianSubproblemCB lsp(relaxed_constrs, subproblem);
+	LagrangianSubproblemCB lsp(relaxed_constrs, subproblem, options->lag_nsubgradients);
 
 	DVector lb(nrows_lag);
 	DVector ub(nrows_lag);
@@ -37,6 +37,15 @@ double LagrangianRelaxationCB::solve(LagrangianRelaxationParams params)
 	solver.set_out(&cout, 0);
 	solver.set_term_relprec(1e-7);
 
+	// Warm start from given multipliers, projected onto their sign constraints
+	if ((int) params.initial_lambdas.size() == nrows_lag) {
+		DVector center(nrows_lag);
+		for (int i = 0; i < nrows_lag; ++i) {
+			center[i] = MIN(MAX(params.initial_lambdas[i], lb[i]), ub[i]);
+		}
+		solver.set_new_center_point(center);
+	}
+
 	if (params.max_noracleiters >= 0) {
 		solver.set_eval_limit(params.max_noracleiters);
 	}
@@ -50,6 +59,7 @@ double LagrangianRelaxationCB::solve(LagrangianRelaxationParams params)
 	int it;
 	for (it = 0; it < max_niters; it++) {
 		solver.do_descent_step();
+		COUNT_EVENT(EVENT_LAG_ITERATIONS);
 
 		// cout << "Iteration " << it << ": bound " << solver.get_objval() << endl;
 
@@ -68,6 +78,13 @@ double LagrangianRelaxationCB::solve(LagrangianRelaxationParams params)
 			break;
 		}
 
+		if (interrupt_flag != NULL && *interrupt_flag) {
+			if (options->bounds_verbose) {
+				cout << "ConicBundle finished: Interrupted" << endl;
+			}
+			break;
+		}
+
 		if (params.time_limit >= 0 && stats.get_current_time(0) >= params.time_limit) {
 			if (options->bounds_verbose) {
 				cout << "ConicBundle finished: Time limit (" << params.time_limit << "s)" << endl;
@@ -77,6 +94,10 @@ double LagrangianRelaxationCB::solve(LagrangianRelaxationParams params)
 	}
 	stats.end_timer(0);
 
+	DVector center;
+	solver.get_center(center);
+	multipliers.assign(center.begin(), center.end());
+
 	// Output
 	if (options->bounds_verbose) {
 		cout << endl;
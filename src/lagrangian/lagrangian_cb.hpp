@@ -8,11 +8,15 @@ using namespace ConicBundle;
 
 #endif // USE_CONICBUNDLE
 
+#include <atomic>
 #include <vector>
 #include "lagrangian.hpp"
 #include "lg_subprob.hpp"
 #include "lg_constraint.hpp"
+#include "lg_constraint_matrix.hpp"
 #include "../util/stats.hpp"
+#include "../util/profiler.hpp"
+#include "../util/event_counters.hpp"
 #include "../util/options.hpp"
 
 using namespace std;
@@ -25,17 +29,20 @@ using namespace std;
 class LagrangianRelaxationCB
 {
 private:
-	vector<LagrangianConstraint> relaxed_constrs;  /**< constraints Lagrangian relaxation is applied to */
+	const vector<LagrangianConstraint>& relaxed_constrs;  /**< constraints Lagrangian relaxation is applied to (not owned) */
 	LagrangianSubproblem*        subproblem;       /**< subproblem for the Lagrangian relaxation */
 	double                       time_limit;       /**< time limit for the Lagrangian relaxation */
 	Options*                     options;
 
 public:
 
+	vector<double>               multipliers;      /**< multipliers attaining the returned bound; set by solve */
+	const atomic<bool>*          interrupt_flag;   /**< if not NULL, solve stops once it is set */
+
 	LagrangianRelaxationCB(const vector<LagrangianConstraint>& _relaxed_constrs,
 	                       LagrangianSubproblem* _subproblem, double _time_limit,
 	                       Options* _options) : relaxed_constrs(_relaxed_constrs), subproblem(_subproblem),
-		time_limit(_time_limit), options(_options)
+		time_limit(_time_limit), options(_options), interrupt_flag(NULL)
 	{
 #ifndef USE_CONICBUNDLE
 		cout << "Error: ConicBundle not compiled" << endl;
@@ -54,15 +61,20 @@ public:
 class LagrangianSubproblemCB : public FunctionOracle
 {
 private:
-	vector<LagrangianConstraint> relaxed_constrs;
+	LagrangianConstraintMatrix matrix;
 	LagrangianSubproblem* subprob;
+	int nsols;                             /**< number of best subproblem solutions returned as subgradients */
+	vector<int> sp_optsol;                 /**< buffer for the subproblem solution, reused across evaluations */
+	vector<vector<int>> sp_sols;           /**< buffer for multiple subproblem solutions */
+	vector<double> sp_solvals;             /**< buffer for the values of sp_sols */
 	Stats stats;
 	int neval;
 
 public:
 
-	LagrangianSubproblemCB(const vector<LagrangianConstraint>& _relaxed_constrs, LagrangianSubproblem* _subprob) :
-		relaxed_constrs(_relaxed_constrs), subprob(_subprob)
+	LagrangianSubproblemCB(const vector<LagrangianConstraint>& _relaxed_constrs, LagrangianSubproblem* _subprob,
+	                       int _nsols = 1) :
+		matrix(_relaxed_constrs), subprob(_subprob), nsols(_nsols)
 	{
 		stats.register_name("subprob");
 		neval = 0;
@@ -71,22 +83,35 @@ public:
 	int evaluate(const DVector& lambdas, double relprec, double& objval, DVector& cut_vals,
 	             vector<DVector>& subgradients, vector<PrimalData*>& primal_solutions, PrimalExtender*&)
 	{
+		ProfileScope subproblem_scope("subproblem");
+		COUNT_EVENT(EVENT_LAG_EVALUATIONS);
 		stats.start_timer(0);
 
-		// Compute subproblem
-		vector<int> sp_optsol;
-		objval = subprob->solve(lambdas, sp_optsol);
+		// Several solutions: each one is a cut, the first one being optimal
+		if (nsols > 1) {
+			objval = subprob->solve_multiple(lambdas, nsols, sp_sols, sp_solvals);
+			for (int k = 0; k < (int) sp_sols.size(); ++k) {
+				cut_vals.push_back(sp_solvals[k]);
+				subgradients.push_back(DVector());
+				matrix.get_lagrangian_subgradient(sp_sols[k], subgradients.back());
+			}
+
+			stats.end_timer(0);
+			neval++;
+			return 0;
+		}
+
+		// Compute subproblem up to the precision requested by ConicBundle: objval is an upper bound on the function value
+		// and the cut is given by the value of the solution
+		double sp_solval;
+		objval = subprob->solve_inexact(lambdas, relprec, sp_optsol, sp_solval);
 
 		// Return new subproblem value
-		cut_vals.push_back(objval);
+		cut_vals.push_back(sp_solval);
 
 		// Return new subgradient
-		int nrows_lag = relaxed_constrs.size();
-		DVector subg(nrows_lag);
-		for (int i = 0; i < nrows_lag; ++i) {
-			subg[i] = relaxed_constrs[i].get_lagrangian_subgradient(sp_optsol);
-		}
-		subgradients.push_back(subg);
+		subgradients.push_back(DVector());
+		matrix.get_lagrangian_subgradient(sp_optsol, subgradients.back());
 
 		stats.end_timer(0);
 		neval++;
@@ -45,9 +45,9 @@ SCIP_RETCODE solve_indepset_lagrangian_pure(SCIP* scip, Options* options)
 	stats.start_timer(0);
 
 	// Solve Lagrangian relaxation
-	LagrangianRelaxationCB lagrangian(relaxed_constrs, subproblem, options->lag_cb_time_limit, options);
 	LagrangianRelaxationParams params;
-	double objval = lagrangian.solve(params);
+	vector<double> multipliers;
+	double objval = solve_lagrangian_dual(relaxed_constrs, subproblem, options, params, multipliers);
 
 	cout << "Retransformed objective: " << -SCIPretransformObj(scip, -objval) << endl;
 
@@ -33,8 +33,6 @@ struct LagrangianConstraint {
 		nnonz = ind.size();
 	}
 
-	~LagrangianConstraint() {}
-
 	/** Return a subgradient of the Lagrangian dual w.r.t. this constraint at a given point x */
 	double get_lagrangian_subgradient(const vector<int>& x)
 	{
@@ -49,6 +47,7 @@ struct LagrangianConstraint {
 	friend ostream& operator<<(ostream& os, const LagrangianConstraint& constr);
 };
 
+
 inline ostream& operator<<(ostream& os, const LagrangianConstraint& constr)
 {
 	for (int j = 0; j < constr.nnonz; ++j) {
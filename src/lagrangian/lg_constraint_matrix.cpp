@@ -0,0 +1,97 @@
+#include <algorithm>
+
+#include "lg_constraint_matrix.hpp"
+
+
+LagrangianConstraintMatrix::LagrangianConstraintMatrix(const vector<LagrangianConstraint>& relaxed_constrs, int _nvars)
+	: nrows(relaxed_constrs.size()), nvars(_nvars)
+{
+	int nnonz = 0;
+	int max_var = -1;
+	for (const LagrangianConstraint& constr : relaxed_constrs) {
+		nnonz += constr.nnonz;
+		for (int k = 0; k < constr.nnonz; ++k) {
+			max_var = max(max_var, constr.ind[k]);
+		}
+	}
+	if (nvars < 0) {
+		nvars = max_var + 1;
+	}
+	assert(max_var < nvars);
+
+	// Rows
+	row_start.reserve(nrows + 1);
+	row_ind.reserve(nnonz);
+	row_coeffs.reserve(nnonz);
+	rhs.reserve(nrows);
+	row_start.push_back(0);
+	for (const LagrangianConstraint& constr : relaxed_constrs) {
+		row_ind.insert(row_ind.end(), constr.ind.begin(), constr.ind.end());
+		row_coeffs.insert(row_coeffs.end(), constr.coeffs.begin(), constr.coeffs.end());
+		row_start.push_back(row_ind.size());
+		rhs.push_back(constr.rhs);
+	}
+
+	// Columns: count nonzeros per column, then fill rows in increasing order
+	col_start.assign(nvars + 1, 0);
+	for (int k = 0; k < nnonz; ++k) {
+		col_start[row_ind[k] + 1]++;
+	}
+	for (int j = 0; j < nvars; ++j) {
+		col_start[j + 1] += col_start[j];
+	}
+	col_ind.resize(nnonz);
+	col_coeffs.resize(nnonz);
+	vector<int> next(col_start.begin(), col_start.end() - 1);
+	for (int i = 0; i < nrows; ++i) {
+		for (int k = row_start[i]; k < row_start[i + 1]; ++k) {
+			int pos = next[row_ind[k]]++;
+			col_ind[pos] = i;
+			col_coeffs[pos] = row_coeffs[k];
+		}
+	}
+}
+
+
+double LagrangianConstraintMatrix::get_lagrangian_objective(const vector<double>& obj, const vector<double>& lambdas,
+        vector<double>& lag_obj) const
+{
+	assert((int) lambdas.size() == nrows);
+	assert((int) obj.size() >= nvars);
+
+	// c
+	lag_obj.assign(obj.begin(), obj.end());
+
+	// - A^T lambda and lambda^T b, skipping rows with zero multipliers
+	double constant = 0;
+	for (int i = 0; i < nrows; ++i) {
+		double lambda = lambdas[i];
+		if (lambda == 0) {
+			continue;
+		}
+		for (int k = row_start[i]; k < row_start[i + 1]; ++k) {
+			lag_obj[row_ind[k]] -= row_coeffs[k] * lambda;
+		}
+		constant += lambda * rhs[i];
+	}
+
+	return constant;
+}
+
+
+void LagrangianConstraintMatrix::get_lagrangian_subgradient(const vector<int>& x, vector<double>& subg) const
+{
+	// b
+	subg.assign(rhs.begin(), rhs.end());
+
+	// - Ax, only over variables that are nonzero
+	int size = min((int) x.size(), nvars);
+	for (int j = 0; j < size; ++j) {
+		if (x[j] == 0) {
+			continue;
+		}
+		for (int k = col_start[j]; k < col_start[j + 1]; ++k) {
+			subg[col_ind[k]] -= col_coeffs[k] * x[j];
+		}
+	}
+}
@@ -0,0 +1,57 @@
+/** Packed sparse matrix of constraints relaxed in Lagrangian relaxation */
+
+#ifndef LG_CONSTRAINT_MATRIX_HPP_
+#define LG_CONSTRAINT_MATRIX_HPP_
+
+#include <vector>
+#include <cassert>
+#include "lg_constraint.hpp"
+
+using namespace std;
+
+
+/**
+ * Constraints relaxed in Lagrangian relaxation stored both by rows (CSR) and by columns (CSC), so that the Lagrangian
+ * objective only touches rows with nonzero multipliers and the subgradient only touches variables set to nonzero.
+ */
+class LagrangianConstraintMatrix
+{
+private:
+	int nrows;                      /**< number of constraints */
+	int nvars;                      /**< number of variables (columns) */
+
+	vector<int> row_start;          /**< nonzeros of row i are in positions row_start[i] to row_start[i+1]-1 */
+	vector<int> row_ind;            /**< variable of each nonzero in row order */
+	vector<double> row_coeffs;      /**< coefficient of each nonzero in row order */
+
+	vector<int> col_start;          /**< nonzeros of column j are in positions col_start[j] to col_start[j+1]-1 */
+	vector<int> col_ind;            /**< row of each nonzero in column order */
+	vector<double> col_coeffs;      /**< coefficient of each nonzero in column order */
+
+	vector<double> rhs;             /**< right-hand side of each row */
+
+public:
+
+	/**
+	 * Pack the given constraints. The number of variables may be given; otherwise, it is one plus the largest variable
+	 * index in the constraints.
+	 */
+	LagrangianConstraintMatrix(const vector<LagrangianConstraint>& relaxed_constrs, int _nvars = -1);
+
+	/**
+	 * Store the objective coefficients c - A^T lambda of the Lagrangian relaxation in lag_obj (resized to the size of
+	 * obj) and return the constant lambda^T b
+	 */
+	double get_lagrangian_objective(const vector<double>& obj, const vector<double>& lambdas, vector<double>& lag_obj) const;
+
+	/** Store the subgradient b - Ax of the Lagrangian dual at point x in subg (resized to the number of rows) */
+	void get_lagrangian_subgradient(const vector<int>& x, vector<double>& subg) const;
+
+	int get_nrows() const
+	{
+		return nrows;
+	}
+};
+
+
+#endif // LG_CONSTRAINT_MATRIX_HPP_
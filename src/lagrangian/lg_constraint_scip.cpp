@@ -1,3 +1,4 @@
+#include <iterator>
 #include "lg_constraint_scip.hpp"
 #include "lg_dd_selector_scip.hpp"
 
@@ -123,118 +124,116 @@ vector<LagrangianConstraint> lagrangian_extract_constraints_scip(SCIP* scip, SCI
 }
 
 
-// Note: This is essentially a copy of lagrangian_extract_constraints_scip above, but with copies of SCIP_ROW* instead of using
-// the original ones, which might be removed by SCIP.
-// clean_up_assume_binary assumes all variables are binary and removes rows that are redundant to binary bounds
-vector<LagrangianConstraint> lagrangian_extract_constraints_scip(SCIP* scip, SCIPRowVector* lagrangian_rows,
-        bool clean_up_assume_binary, const vector<int>& fixed_vars)
+SCIPRowMatrix::SCIPRowMatrix(SCIP* scip, SCIPRowVector* lagrangian_rows)
 {
-	vector<bool> row_skip_lhs(lagrangian_rows->lhs);
-	vector<bool> row_skip_rhs(lagrangian_rows->rhs);
-	row_skip_lhs.flip();
-	row_skip_rhs.flip();
 	int nrows = lagrangian_rows->rows.size();
-
-	vector<LagrangianConstraint> relaxed_constrs;
-	vector<int> ind;
-	vector<double> coeffs;
-
-	assert((int) fixed_vars.size() == SCIPgetNLPCols(scip));
+	row_start.push_back(0);
 
 	for (int i = 0; i < nrows; ++i) {
 		SCIPRow* row = lagrangian_rows->rows[i];
-		SCIP_Real lhs = row->lhs;
-		SCIP_Real rhs = row->rhs;
-		SCIP_Real constant = row->constant;
 
-		bool skip_lhs = (row_skip_lhs[i] || SCIPisInfinity(scip, -lhs));
-		bool skip_rhs = (row_skip_rhs[i] || SCIPisInfinity(scip, rhs));
-
-		if (skip_lhs && skip_rhs) {
-			continue;
-		}
+		for (LinSense sense : {LINSENSE_GE, LINSENSE_LE}) {
+			if (sense == LINSENSE_GE && (!lagrangian_rows->lhs[i] || SCIPisInfinity(scip, -row->lhs))) {
+				continue;
+			}
+			if (sense == LINSENSE_LE && (!lagrangian_rows->rhs[i] || SCIPisInfinity(scip, row->rhs))) {
+				continue;
+			}
 
-		if (!skip_lhs) {
-			lhs -= constant;
+			col_ids.insert(col_ids.end(), row->col_ids.begin(), row->col_ids.end());
+			vals.insert(vals.end(), row->vals.begin(), row->vals.end());
+			row_start.push_back(col_ids.size());
+			sides.push_back(((sense == LINSENSE_GE) ? row->lhs : row->rhs) - row->constant);
+			senses.push_back(sense);
 		}
-		if (!skip_rhs) {
-			rhs -= constant;
-		}
-
-		ind.clear();
-		coeffs.clear();
+	}
+}
 
-		int nnonz = row->nnonz;
-		for (int j = 0; j < nnonz; ++j) {
-			int idx = row->col_ids[j];
 
-			bool var_is_fixed = false;
-			SCIP_Real fixed_val = 0;
+// clean_up_assume_binary assumes all variables are binary and removes rows that are redundant to binary bounds
+void lagrangian_extract_constraints(const SCIPRowMatrix& matrix, bool clean_up_assume_binary,
+                                    const vector<int>& fixed_vars, vector<LagrangianConstraint>& relaxed_constrs,
+                                    vector<int>* constr_rows, vector<LagrangianConstraint>* spare_constrs)
+{
+	int nrows = matrix.size();
+	int nconstrs = 0;
 
-			fixed_val = fixed_vars[idx];
-			var_is_fixed = (fixed_val != DD_UNFIXED_VAR);
+	if (constr_rows != NULL) {
+		constr_rows->clear();
+	}
 
-			// Add variables that are not fixed to LagrangianConstraint or update RHS for those that are
-			if (!var_is_fixed) {
-				coeffs.push_back(row->vals[j]);
-				ind.push_back(idx);
-				assert(idx < SCIPgetNLPCols(scip));
+	for (int i = 0; i < nrows; ++i) {
+		// Reuse the memory of an existing constraint if possible
+		if (nconstrs == (int) relaxed_constrs.size()) {
+			if (spare_constrs != NULL && !spare_constrs->empty()) {
+				relaxed_constrs.push_back(move(spare_constrs->back()));
+				spare_constrs->pop_back();
 			} else {
-				// i-th variable is fixed to fixed_val
-				if (!skip_lhs) {
-					lhs -= row->vals[j] * fixed_val;
-				}
-				if (!skip_rhs) {
-					rhs -= row->vals[j] * fixed_val;
-				}
+				relaxed_constrs.push_back(LagrangianConstraint({}, {}, 0, matrix.senses[i]));
 			}
 		}
+		LagrangianConstraint& constr = relaxed_constrs[nconstrs];
+		constr.ind.clear();
+		constr.coeffs.clear();
+		constr.sense = matrix.senses[i];
+		double side = matrix.sides[i];
+		double minactivity = 0;
+		double maxactivity = 0;
+
+		for (int k = matrix.row_start[i]; k < matrix.row_start[i+1]; ++k) {
+			int idx = matrix.col_ids[k];
+			assert(idx < (int) fixed_vars.size());
+
+			// Add variables that are not fixed to the constraint or update RHS for those that are
+			if (fixed_vars[idx] == DD_UNFIXED_VAR) {
+				constr.ind.push_back(idx);
+				constr.coeffs.push_back(matrix.vals[k]);
+				minactivity += MIN(0, matrix.vals[k]);
+				maxactivity += MAX(0, matrix.vals[k]);
+			} else {
+				side -= matrix.vals[k] * fixed_vars[idx];
+			}
+		}
+
+		if (constr.ind.empty()) {
+			continue;
+		}
 
 		if (clean_up_assume_binary) {
 			// Clean up redundant rows (assume variables are binary)
-			if (!skip_lhs) { // >= type constraint
-				double minactivity = 0;
-				int nnonz_cons = coeffs.size();
-				for (int j = 0; j < nnonz_cons; ++j) {
-					minactivity += MIN(0, coeffs[j]);
-				}
-				if (DBL_GE(minactivity, lhs)) {
-					skip_lhs = true;
-					// cout << "Skipped: ";
-					// for (int j = 0; j < nnonz_cons; ++j) {
-					// 	cout << " + " << coeffs[j] << " x" << ind[j];
-					// }
-					// cout << " >= " << lhs << endl;
-				}
+			if (constr.sense == LINSENSE_GE && DBL_GE(minactivity, side)) {
+				continue;
 			}
-			if (!skip_rhs) { // >= type constraint
-				double maxactivity = 0;
-				int nnonz_cons = coeffs.size();
-				for (int j = 0; j < nnonz_cons; ++j) {
-					maxactivity += MAX(0, coeffs[j]);
-				}
-				if (DBL_LE(maxactivity, rhs)) {
-					skip_rhs = true;
-					// cout << "Skipped: ";
-					// for (int j = 0; j < nnonz_cons; ++j) {
-					// 	cout << " + " << coeffs[j] << " x" << ind[j];
-					// }
-					// cout << " <= " << rhs << endl;
-				}
+			if (constr.sense == LINSENSE_LE && DBL_LE(maxactivity, side)) {
+				continue;
 			}
 		}
 
-		if (coeffs.size() > 0) {
-			if (!skip_lhs) {
-				relaxed_constrs.push_back(LagrangianConstraint(ind, coeffs, lhs, LINSENSE_GE));
-			}
-
-			if (!skip_rhs) {
-				relaxed_constrs.push_back(LagrangianConstraint(ind, coeffs, rhs, LINSENSE_LE));
-			}
+		constr.nnonz = constr.ind.size();
+		constr.rhs = side;
+		nconstrs++;
+		if (constr_rows != NULL) {
+			constr_rows->push_back(i);
 		}
 	}
 
+	// Keep the memory of the constraints left over for the next extraction
+	if (spare_constrs != NULL) {
+		spare_constrs->insert(spare_constrs->end(), make_move_iterator(relaxed_constrs.begin() + nconstrs),
+		                      make_move_iterator(relaxed_constrs.end()));
+	}
+	relaxed_constrs.erase(relaxed_constrs.begin() + nconstrs, relaxed_constrs.end());
+}
+
+
+vector<LagrangianConstraint> lagrangian_extract_constraints_scip(SCIP* scip, SCIPRowVector* lagrangian_rows,
+        bool clean_up_assume_binary, const vector<int>& fixed_vars)
+{
+	assert((int) fixed_vars.size() == SCIPgetNLPCols(scip));
+
+	vector<LagrangianConstraint> relaxed_constrs;
+	lagrangian_extract_constraints(SCIPRowMatrix(scip, lagrangian_rows), clean_up_assume_binary, fixed_vars,
+	                               relaxed_constrs);
 	return relaxed_constrs;
 }
 
@@ -63,6 +63,27 @@ struct SCIPRowVector {
 };
 
 
+/**
+ * Compressed sparse row copy of the inequalities of a SCIPRowVector, with one row per inequality considered (>= for
+ * LHS, <= for RHS, in this order) and row constants moved to the right-hand side. Built once per solve so that
+ * extraction at a node only needs to drop fixed variables and update right-hand sides.
+ */
+struct SCIPRowMatrix {
+	vector<int> row_start;       /**< nonzeros of row i are in positions row_start[i] to row_start[i+1]-1 */
+	vector<int> col_ids;         /**< SCIP problem index of variable of each nonzero */
+	vector<double> vals;         /**< coefficient of each nonzero */
+	vector<double> sides;        /**< right-hand side of each row */
+	vector<LinSense> senses;     /**< sense of each row */
+
+	SCIPRowMatrix(SCIP* scip, SCIPRowVector* lagrangian_rows);
+
+	int size() const
+	{
+		return sides.size();
+	}
+};
+
+
 
 /**
  * Extract rows from SCIP into a vector of Lagrangian constraints. Skips rows marked in row_skip_lhs and row_skip_rhs.
@@ -82,4 +103,14 @@ vector<LagrangianConstraint> lagrangian_extract_all_constraints_scip(SCIP* scip,
 vector<LagrangianConstraint> lagrangian_extract_constraints_scip(SCIP* scip, SCIPRowVector* lagrangian_rows,
         bool clean_up_assume_binary, const vector<int>& fixed_vars);
 
+/**
+ * Convert rows from a row matrix into a vector of Lagrangian constraints given a vector of fixed variables. Constraints
+ * already in relaxed_constrs are overwritten, reusing their memory. If spare_constrs is given, constraints left over are
+ * moved there instead of being destroyed, and are taken from there when more are needed. If constr_rows is given, it
+ * stores the row of the matrix each constraint comes from. Does not call SCIP.
+ */
+void lagrangian_extract_constraints(const SCIPRowMatrix& matrix, bool clean_up_assume_binary,
+                                    const vector<int>& fixed_vars, vector<LagrangianConstraint>& relaxed_constrs,
+                                    vector<int>* constr_rows = NULL, vector<LagrangianConstraint>* spare_constrs = NULL);
+
 #endif // LG_CONSTRAINT_SCIP_HPP_
\ No newline at end of file
@@ -85,6 +85,7 @@ void LagrangianDDConstraintSelectorCliqueTable::prepare_dd_construction(SCIP* sc
 	// Create rows that will be considered in propagation in the DD; these are the ones that were Lagrangianized
 	prop_bpvars.clear();
 	prop_bprows.clear();
+	prop_var_rows.clear();
 	if (options->lag_prop) {
 		Options convert_options;
 		convert_options.bp_prop_only_all = false;
@@ -97,6 +98,13 @@ void LagrangianDDConstraintSelectorCliqueTable::prepare_dd_construction(SCIP* sc
 			assert(i == prop_bpvars[i]->solver_index);
 		}
 
+		prop_var_rows.resize(size);
+		for (int r = 0; r < (int) prop_bprows.size(); ++r) {
+			for (int k = 0; k < prop_bprows[r]->nnonz; ++k) {
+				prop_var_rows[prop_bprows[r]->ind[k]].push_back(r);
+			}
+		}
+
 		// for (BPVar* var : prop_bpvars) {
 		// 	cout << var->solver_index << " ";
 		// }
@@ -108,23 +116,50 @@ void LagrangianDDConstraintSelectorCliqueTable::prepare_dd_construction(SCIP* sc
 }
 
 
-DDSolver* LagrangianDDConstraintSelectorCliqueTable::create_solver(SCIP* scip, const vector<int>& var_to_subvar,
-        const vector<int>& subvar_to_var, const vector<int>& fixed_vars, const vector<double>& obj, Options* options)
+CliqueTableInstance* LagrangianDDConstraintSelectorCliqueTable::get_full_instance(SCIP* scip, Options* options)
 {
-	SCIP_COL** cols;
-	int ncols;
-
-	// Recreate list of columns in subspace to retrieve clique table from SCIP
-	SCIP_CALL_ABORT(SCIPgetLPColsData(scip, &cols, &ncols));
-	vector<SCIP_COL*> subcols;
-	for (int i = 0; i < ncols; ++i) {
-		SCIP_VAR* var = SCIPcolGetVar(cols[i]);
-		int idx = SCIPvarGetProbindex(var);
-		if (fixed_vars[idx] == DD_UNFIXED_VAR) {
-			subcols.push_back(cols[i]);
+	int ncliques = SCIPgetNCliques(scip);
+	int ncliques_created = SCIPgetNCliquesCreated(scip);
+
+	// Rows are identified by their SCIP index, which is never reused, so the same count of different rows is detected
+	vector<int> global_rows;
+	if (options->lag_add_all_ct_rows) {
+		SCIP_ROW** rows;
+		int nrows;
+		SCIP_CALL_ABORT(SCIPgetLPRowsData(scip, &rows, &nrows));
+		for (int i = 0; i < nrows; ++i) {
+			if (!SCIProwIsLocal(rows[i])) {
+				global_rows.push_back(SCIProwGetIndex(rows[i]));
+			}
 		}
 	}
 
+	if (full_inst == NULL || ncliques != full_inst_ncliques || ncliques_created != full_inst_ncliques_created
+	        || global_rows != full_inst_rows) {
+		SCIP_COL** cols;
+		int ncols;
+		SCIP_CALL_ABORT(SCIPgetLPColsData(scip, &cols, &ncols));
+
+		// Variables are indexed by their SCIP problem index
+		vector<int> var_to_var(ncols);
+		for (int i = 0; i < ncols; ++i) {
+			var_to_var[i] = i;
+		}
+
+		delete full_inst;
+		full_inst = new CliqueTableInstance(scip, cols, ncols, var_to_var, options->lag_add_all_ct_rows, true, true);
+		full_inst_ncliques = ncliques;
+		full_inst_ncliques_created = ncliques_created;
+		full_inst_rows.swap(global_rows);
+	}
+
+	return full_inst;
+}
+
+
+DDSolver* LagrangianDDConstraintSelectorCliqueTable::create_solver(SCIP* scip, const vector<int>& var_to_subvar,
+        const vector<int>& subvar_to_var, const vector<int>& fixed_vars, const vector<double>& obj, Options* options)
+{
 	// Debugging info
 	// for (int i = 0; i < (int) prop_bprows.size(); ++i) {
 	// 	double rhs_mod = prop_bprows[i]->rhs;
@@ -143,8 +178,8 @@ DDSolver* LagrangianDDConstraintSelectorCliqueTable::create_solver(SCIP* scip, c
 	// 	cout << " <= " << rhs_mod << endl;
 	// }
 
-	// Create problem
-	CliqueTableInstance* inst = new CliqueTableInstance(scip, subcols.data(), (int) subcols.size(), var_to_subvar, options->lag_add_all_ct_rows);
+	// Create problem; the clique table is only converted when it changes, and restricted to the subspace at each node
+	CliqueTableInstance* inst = new CliqueTableInstance(*get_full_instance(scip, options), subvar_to_var);
 
 	CliqueTablePropLinearcons* prop = NULL;
 	if (!prop_bprows.empty()) {
@@ -162,3 +197,176 @@ DDSolver* LagrangianDDConstraintSelectorCliqueTable::create_solver(SCIP* scip, c
 
 	return solver;
 }
+
+
+/** Find operation of a union-find structure with path halving */
+static int find_component(vector<int>& parent, int i)
+{
+	while (parent[i] != i) {
+		parent[i] = parent[parent[i]];
+		i = parent[i];
+	}
+	return i;
+}
+
+
+void LagrangianDDConstraintSelectorCliqueTable::get_blocks(SCIP* scip, const vector<int>& subvar_to_var, Options* options,
+        vector<vector<int>>& blocks)
+{
+	CliqueTableInstance* inst = get_full_instance(scip, options);
+	int nvars = inst->nvars;
+	int nsubvars = subvar_to_var.size();
+
+	vector<int> var_to_subvar(nvars, -1);
+	for (int i = 0; i < nsubvars; ++i) {
+		var_to_subvar[subvar_to_var[i]] = i;
+	}
+
+	vector<int> parent(nsubvars);
+	for (int i = 0; i < nsubvars; ++i) {
+		parent[i] = i;
+	}
+
+	// Clique table edges, including those of negated variables
+	for (int i = 0; i < nsubvars; ++i) {
+		int var = subvar_to_var[i];
+		for (int vertex : {var, var + nvars}) {
+			if (vertex >= (int) inst->adj.size()) {
+				continue;
+			}
+			const IntSet& adj = inst->adj[vertex];
+			for (int u = adj.get_first(); u != adj.get_end(); u = adj.get_next(u)) {
+				int j = var_to_subvar[u % nvars];
+				if (j >= 0) {
+					parent[find_component(parent, j)] = find_component(parent, i);
+				}
+			}
+		}
+	}
+
+	// Rows used by the propagator in the DD
+	for (BPRow* row : prop_bprows) {
+		int first = -1;
+		for (int k = 0; k < row->nnonz; ++k) {
+			int j = var_to_subvar[row->ind[k]];
+			if (j < 0) {
+				continue;
+			}
+			if (first < 0) {
+				first = j;
+			} else {
+				parent[find_component(parent, j)] = find_component(parent, first);
+			}
+		}
+	}
+
+	// Components by increasing first variable
+	vector<int> component_block(nsubvars, -1);
+	blocks.clear();
+	for (int i = 0; i < nsubvars; ++i) {
+		int root = find_component(parent, i);
+		if (component_block[root] < 0) {
+			component_block[root] = blocks.size();
+			blocks.push_back(vector<int>());
+		}
+		blocks[component_block[root]].push_back(i);
+	}
+}
+
+
+bool LagrangianDDConstraintSelectorCliqueTable::enumerate_block_solutions(SCIP* scip, const vector<int>& block_vars,
+        const vector<int>& fixed_vars, Options* options, vector<vector<int>>& sols)
+{
+	CliqueTableInstance* inst = get_full_instance(scip, options);
+	int nvars = inst->nvars;
+	int size = block_vars.size();
+	if (size > 30) {
+		return false;
+	}
+
+	// Conflicts as pairs of (position in block, value) that cannot hold together, and values that conflict with fixed
+	// variables; a vertex u of the clique table is variable u % nvars at value 1 if u < nvars and 0 otherwise
+	vector<pair<pair<int, int>, pair<int, int>>> conflicts;
+	vector<vector<bool>> allowed(size, vector<bool>(2, true));
+	for (int k = 0; k < size; ++k) {
+		for (int val = 0; val <= 1; ++val) {
+			int vertex = (val == 1) ? block_vars[k] : block_vars[k] + nvars;
+			if (vertex >= (int) inst->adj.size()) {
+				continue;
+			}
+			const IntSet& adj = inst->adj[vertex];
+			for (int u = adj.get_first(); u != adj.get_end(); u = adj.get_next(u)) {
+				int var = u % nvars;
+				int u_val = (u < nvars) ? 1 : 0;
+				if (fixed_vars[var] != DD_UNFIXED_VAR) {
+					if (fixed_vars[var] == u_val) {
+						allowed[k][val] = false;
+					}
+					continue;
+				}
+				int l = find(block_vars.begin(), block_vars.end(), var) - block_vars.begin();
+				if (l < size && make_pair(k, val) <= make_pair(l, u_val)) {
+					conflicts.push_back(make_pair(make_pair(k, val), make_pair(l, u_val)));
+				}
+			}
+		}
+	}
+
+	// Propagated rows containing the block, with the activity of fixed variables moved to the right-hand side
+	vector<int> block_rows;
+	for (int var : block_vars) {
+		if (var < (int) prop_var_rows.size()) {
+			block_rows.insert(block_rows.end(), prop_var_rows[var].begin(), prop_var_rows[var].end());
+		}
+	}
+	sort(block_rows.begin(), block_rows.end());
+	block_rows.erase(unique(block_rows.begin(), block_rows.end()), block_rows.end());
+
+	vector<double> rows_rhs;
+	vector<vector<double>> rows_coeffs;
+	for (int r : block_rows) {
+		BPRow* row = prop_bprows[r];
+		double sign = (row->sense == SENSE_LE) ? 1 : -1;
+		double rhs = sign * row->rhs;
+		vector<double> coeffs(size, 0);
+		for (int j = 0; j < row->nnonz; ++j) {
+			int var = row->ind[j];
+			int l = find(block_vars.begin(), block_vars.end(), var) - block_vars.begin();
+			if (l < size) {
+				coeffs[l] += sign * row->coeffs[j];
+			} else if (fixed_vars[var] != DD_UNFIXED_VAR) {
+				rhs -= sign * row->coeffs[j] * fixed_vars[var];
+			} else {
+				rhs -= MIN(0, sign * row->coeffs[j]); // not expected: unfixed variables outside block are relaxed
+			}
+		}
+		rows_rhs.push_back(rhs);
+		rows_coeffs.push_back(coeffs);
+	}
+
+	sols.clear();
+	vector<int> sol(size);
+	for (long long assignment = 0; assignment < (1LL << size); ++assignment) {
+		bool feasible = true;
+		for (int k = 0; k < size && feasible; ++k) {
+			sol[k] = (assignment >> k) & 1;
+			feasible = allowed[k][sol[k]];
+		}
+		for (int i = 0; i < (int) conflicts.size() && feasible; ++i) {
+			feasible = (sol[conflicts[i].first.first] != conflicts[i].first.second
+			            || sol[conflicts[i].second.first] != conflicts[i].second.second);
+		}
+		for (int r = 0; r < (int) rows_rhs.size() && feasible; ++r) {
+			double activity = 0;
+			for (int k = 0; k < size; ++k) {
+				activity += rows_coeffs[r][k] * sol[k];
+			}
+			feasible = DBL_LE(activity, rows_rhs[r]);
+		}
+		if (feasible) {
+			sols.push_back(sol);
+		}
+	}
+
+	return true;
+}
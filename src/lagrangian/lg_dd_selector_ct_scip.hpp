@@ -8,6 +8,7 @@
 #include "../problem/bp/bprow.hpp"
 #include "../problem/bp/bpvar.hpp"
 #include "../problem/bp/filtering.hpp"
+#include "../problem/cliquetable/cliquetable_instance.hpp"
 
 
 class LagrangianDDConstraintSelectorCliqueTable : public LagrangianDDConstraintSelector
@@ -15,11 +16,24 @@ class LagrangianDDConstraintSelectorCliqueTable : public LagrangianDDConstraintS
 private:
 	vector<BPVar*> prop_bpvars;           // Variables to be considered in DD propagator
 	vector<BPRow*> prop_bprows;           // Rows to be considered in DD propagator
+	vector<vector<int>> prop_var_rows;    // Indices of rows in prop_bprows containing each variable
+
+	CliqueTableInstance* full_inst;       // Instance over all variables, restricted to the subspace at each node
+	int full_inst_ncliques;               // Number of cliques in SCIP when full_inst was built
+	int full_inst_ncliques_created;       // Number of cliques created by SCIP when full_inst was built
+	vector<int> full_inst_rows;           // Indices of the global LP rows when full_inst was built (if clique table rows
+	                                      // are added); local rows are not added since full_inst is shared across nodes
+
+	/** Return the instance over all variables, rebuilding it if the clique table (or LP rows, if used) changed */
+	CliqueTableInstance* get_full_instance(SCIP* scip, Options* options);
 
 public:
 
+	LagrangianDDConstraintSelectorCliqueTable() : full_inst(NULL), full_inst_ncliques(-1), full_inst_ncliques_created(-1) {}
+
 	~LagrangianDDConstraintSelectorCliqueTable()
 	{
+		delete full_inst;
 		for (BPVar* bpvar : prop_bpvars) {
 			delete bpvar;
 		}
@@ -42,6 +56,13 @@ public:
 		create_mappings_default(scip, fixed_vars, var_to_subvar, subvar_to_var);
 	}
 
+	/** Blocks are the connected components of the clique table and propagated rows */
+	void get_blocks(SCIP* scip, const vector<int>& subvar_to_var, Options* options, vector<vector<int>>& blocks);
+
+	/** Enumerate assignments of at most 30 variables against the clique table and propagated rows */
+	bool enumerate_block_solutions(SCIP* scip, const vector<int>& block_vars, const vector<int>& fixed_vars,
+	                               Options* options, vector<vector<int>>& sols);
+
 	void filter(BDD* bdd, const vector<int>& var_to_subvar, const vector<int>& fixed_vars);
 
 };
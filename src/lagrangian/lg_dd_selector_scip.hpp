@@ -50,6 +50,31 @@ public:
 	/** Create decision diagram solver for problem */
 	virtual DDSolver* create_solver(SCIP* scip, const vector<int>& var_to_subvar, const vector<int>& subvar_to_var,
 	                                const vector<int>& fixed_vars, const vector<double>& obj, Options* options) = 0;
+
+	/**
+	 * Partition the subspace into blocks of subspace variables that share no constraint of the DD, so that a DD may be
+	 * constructed for each block independently. The solver of a block is then created with a mapping shared by all
+	 * blocks, so variables of other blocks must be unreachable through the constraints of the DD. By default, the whole
+	 * subspace is a single block.
+	 */
+	virtual void get_blocks(SCIP* scip, const vector<int>& subvar_to_var, Options* options, vector<vector<int>>& blocks)
+	{
+		blocks.assign(1, vector<int>());
+		for (int i = 0; i < (int) subvar_to_var.size(); ++i) {
+			blocks[0].push_back(i);
+		}
+	}
+
+	/**
+	 * Store in sols all assignments of the given variables (in original space) that satisfy the constraints of the DD,
+	 * given the fixed variables and assuming that no constraint of the DD links them to other unfixed variables. This
+	 * replaces constructing a DD for small blocks. Return false if unsupported, which is the default.
+	 */
+	virtual bool enumerate_block_solutions(SCIP* scip, const vector<int>& block_vars, const vector<int>& fixed_vars,
+	                                       Options* options, vector<vector<int>>& sols)
+	{
+		return false;
+	}
 };
 
 
@@ -25,6 +25,22 @@ public:
 	/** Update the master problem with the subproblem optimal solution and value */
 	virtual void update(const vector<int>& sp_optsol, double sp_optval, const vector<double>& lambdas) = 0;
 
+	/**
+	 * Update the master problem with an inexact subproblem solve: sp_solval is the value of sp_optsol and sp_bound an upper
+	 * bound on the subproblem optimal value. By default, use it as an exact solve with value sp_solval.
+	 */
+	virtual void update_inexact(const vector<int>& sp_optsol, double sp_solval, double sp_bound,
+	                            const vector<double>& lambdas)
+	{
+		update(sp_optsol, sp_solval, lambdas);
+	}
+
+	/**
+	 * Update the master problem with another subproblem solution at the multipliers of the last update, e.g. one of the
+	 * k best solutions. By default, it is ignored.
+	 */
+	virtual void update_extra(const vector<int>& sp_sol, double sp_solval, const vector<double>& lambdas) {}
+
 	/**
 	 * Solve the master problem, returning the objective and the optimal Lagrange multipliers
 	 * at this iteration
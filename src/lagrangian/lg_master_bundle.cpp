@@ -0,0 +1,338 @@
+/* Master problem for Lagrangian relaxation: Proximal bundle method */
+
+#include <algorithm>
+#include <cmath>
+#include "lg_master_bundle.hpp"
+
+
+void solve_simplex_qp(const vector<double>& b, const vector<vector<double>>& Q, vector<double>& theta)
+{
+	int k = b.size();
+	assert(k > 0);
+
+	// Start from the given point if valid; otherwise from the vertex with the largest linear term
+	double sum = 0;
+	bool valid = ((int) theta.size() == k);
+	for (int i = 0; valid && i < k; ++i) {
+		valid = (theta[i] >= 0);
+		sum += theta[i];
+	}
+	if (!valid || fabs(sum - 1) > 1e-9) {
+		theta.assign(k, 0);
+		theta[max_element(b.begin(), b.end()) - b.begin()] = 1;
+	}
+
+	// Gradient
+	vector<double> d(b);
+	for (int i = 0; i < k; ++i) {
+		if (theta[i] > 0) {
+			for (int l = 0; l < k; ++l) {
+				d[l] -= Q[l][i] * theta[i];
+			}
+		}
+	}
+
+	// Pairwise coordinate ascent: move weight from the worst cut in the support to the best cut
+	int max_niters = 100 * k + 1000;
+	for (int it = 0; it < max_niters; ++it) {
+		int i = 0;
+		int j = -1;
+		for (int l = 0; l < k; ++l) {
+			if (d[l] > d[i]) {
+				i = l;
+			}
+			if (theta[l] > 0 && (j < 0 || d[l] < d[j])) {
+				j = l;
+			}
+		}
+		assert(j >= 0);
+		if (i == j || d[i] - d[j] <= 1e-12 * (1 + fabs(d[i]))) {
+			break;
+		}
+
+		double curvature = Q[i][i] + Q[j][j] - 2 * Q[i][j];
+		double step = (curvature > 1e-16) ? (d[i] - d[j]) / curvature : theta[j];
+		step = MIN(step, theta[j]);
+
+		theta[i] += step;
+		theta[j] -= step;
+		if (theta[j] < 1e-15) {
+			theta[j] = 0;
+		}
+		for (int l = 0; l < k; ++l) {
+			d[l] -= step * (Q[l][i] - Q[l][j]);
+		}
+	}
+}
+
+
+LagrangianMasterProblemBundle::LagrangianMasterProblemBundle(const vector<LagrangianConstraint>& _relaxed_constrs,
+        LagrangianBundleParams _params) :
+	LagrangianMasterProblem(_relaxed_constrs),
+	params(_params),
+	matrix(_relaxed_constrs),
+	nnew_cuts(0),
+	has_center(false),
+	center_value(numeric_limits<double>::infinity()),
+	weight(_params.initial_weight),
+	predicted_decrease(0),
+	nnull_steps(0),
+	agg_primal_value(0)
+{
+	int nrows_lag = get_nrows_lag();
+	lb.resize(nrows_lag);
+	ub.resize(nrows_lag);
+	for (int i = 0; i < nrows_lag; ++i) {
+		lb[i] = (relaxed_constrs[i].sense == LINSENSE_LE) ? 0 : -numeric_limits<double>::infinity();
+		ub[i] = (relaxed_constrs[i].sense == LINSENSE_GE) ? 0 : numeric_limits<double>::infinity();
+	}
+	center.assign(nrows_lag, 0);
+}
+
+
+void LagrangianMasterProblemBundle::update(const vector<int>& sp_optsol, double sp_optval, const vector<double>& lambdas)
+{
+	update_inexact(sp_optsol, sp_optval, sp_optval, lambdas);
+}
+
+
+void LagrangianMasterProblemBundle::update_inexact(const vector<int>& sp_optsol, double cut_value, double upper_bound,
+        const vector<double>& lambdas)
+{
+	int nrows_lag = get_nrows_lag();
+	assert((int) lambdas.size() == nrows_lag);
+	assert(DBL_LE(cut_value, upper_bound));
+
+	BundleCut cut;
+	create_cut(sp_optsol, cut_value, lambdas, cut);
+
+	if (!has_center) {
+		has_center = true;
+		center = lambdas;
+		center_value = upper_bound;
+		if (weight <= 0) {
+			// Proximal step of the first subgradient predicts a decrease of the order of the dual function value
+			double norm2 = 0;
+			for (int i = 0; i < nrows_lag; ++i) {
+				norm2 += cut.subgradient[i] * cut.subgradient[i];
+			}
+			weight = MAX(norm2 / (fabs(upper_bound) + 1), params.min_weight);
+		}
+	} else if (upper_bound <= center_value - params.descent_ratio * predicted_decrease) {
+		// Serious step; trust the model more if the decrease matched the prediction
+		if (center_value - upper_bound >= 0.5 * predicted_decrease) {
+			weight = MAX(weight * 0.5, params.min_weight);
+		}
+		center = lambdas;
+		center_value = upper_bound;
+		nnull_steps = 0;
+	} else {
+		// Null step; the new cut improves the model, but stabilize more if this happens repeatedly
+		nnull_steps++;
+		if (nnull_steps >= 3) {
+			weight = MIN(weight * 2, params.max_weight);
+			nnull_steps = 0;
+		}
+	}
+
+	add_cut(cut);
+}
+
+
+void LagrangianMasterProblemBundle::update_extra(const vector<int>& sp_sol, double sp_solval,
+        const vector<double>& lambdas)
+{
+	assert(has_center);
+	BundleCut cut;
+	create_cut(sp_sol, sp_solval, lambdas, cut);
+	add_cut(cut);
+}
+
+
+void LagrangianMasterProblemBundle::create_cut(const vector<int>& sp_sol, double sp_solval,
+        const vector<double>& lambdas, BundleCut& cut)
+{
+	// Cut: L(lambda') >= c^T x + lambda'^T (b - Ax) for the solution x
+	int nrows_lag = get_nrows_lag();
+	matrix.get_lagrangian_subgradient(sp_sol, cut.subgradient);
+	cut.primal.assign(sp_sol.begin(), sp_sol.end());
+	cut.primal_value = sp_solval;
+	for (int i = 0; i < nrows_lag; ++i) {
+		cut.primal_value -= lambdas[i] * cut.subgradient[i];
+	}
+	cut.alpha = cut.primal_value;
+}
+
+
+void LagrangianMasterProblemBundle::add_cut(BundleCut& cut)
+{
+	if ((int) bundle.size() >= params.max_bundle_size) {
+		// Drop cuts that were inactive in the last solve; cuts added since then are kept
+		int nold = bundle.size() - nnew_cuts;
+		vector<BundleCut> kept_bundle;
+		vector<double> kept_theta;
+		for (int i = 0; i < (int) bundle.size(); ++i) {
+			if (i >= nold || theta[i] > 0) {
+				kept_bundle.push_back(bundle[i]);
+				kept_theta.push_back(theta[i]);
+			}
+		}
+		bundle.swap(kept_bundle);
+		theta.swap(kept_theta);
+
+		// Otherwise, aggregate the cuts from the last solve into a single cut
+		if ((int) bundle.size() >= params.max_bundle_size) {
+			aggregate_bundle();
+		}
+	}
+
+	bundle.push_back(cut);
+	theta.push_back(0);
+	nnew_cuts++;
+}
+
+
+void LagrangianMasterProblemBundle::aggregate_bundle()
+{
+	int nold = bundle.size() - nnew_cuts;
+	if (nold <= 1) {
+		return;
+	}
+
+	BundleCut agg;
+	agg.alpha = 0;
+	agg.primal_value = 0;
+	agg.subgradient.assign(bundle[0].subgradient.size(), 0);
+	agg.primal.assign(bundle[0].primal.size(), 0);
+	for (int i = 0; i < nold; ++i) {
+		if (theta[i] == 0) {
+			continue;
+		}
+		agg.alpha += theta[i] * bundle[i].alpha;
+		agg.primal_value += theta[i] * bundle[i].primal_value;
+		for (int j = 0; j < (int) agg.subgradient.size(); ++j) {
+			agg.subgradient[j] += theta[i] * bundle[i].subgradient[j];
+		}
+		for (int j = 0; j < (int) agg.primal.size(); ++j) {
+			agg.primal[j] += theta[i] * bundle[i].primal[j];
+		}
+	}
+
+	bundle.erase(bundle.begin(), bundle.begin() + nold);
+	theta.erase(theta.begin(), theta.begin() + nold);
+	bundle.insert(bundle.begin(), agg);
+	theta.insert(theta.begin(), 1);
+}
+
+
+double LagrangianMasterProblemBundle::get_model_value(const vector<double>& lambdas)
+{
+	double value = -numeric_limits<double>::infinity();
+	for (const BundleCut& cut : bundle) {
+		double cut_value = cut.alpha;
+		for (int j = 0; j < (int) lambdas.size(); ++j) {
+			cut_value += cut.subgradient[j] * lambdas[j];
+		}
+		value = MAX(value, cut_value);
+	}
+	return value;
+}
+
+
+double LagrangianMasterProblemBundle::solve(vector<double>& lambdas)
+{
+	int nrows_lag = get_nrows_lag();
+	int k = bundle.size();
+	assert(has_center && k > 0);
+
+	// Dual of min_{lb <= lambda <= ub} max_i (alpha_i + g_i^T lambda) + (weight/2) ||lambda - center||^2: for a fixed
+	// set of multipliers at bounds, lambda = center - G theta / weight on the others, giving a QP in theta
+	vector<int> at_bound(nrows_lag, 0); // -1: at lower bound, 1: at upper bound, 0: free
+	vector<double> b(k);
+	vector<vector<double>> Q(k, vector<double>(k));
+	vector<double> aggsubg(nrows_lag);
+	vector<double> fixed_lambdas(nrows_lag);
+	theta.resize(k, 0);
+	nnew_cuts = 0;
+
+	for (int round = 0; round < params.max_qp_rounds; ++round) {
+		for (int j = 0; j < nrows_lag; ++j) {
+			fixed_lambdas[j] = (at_bound[j] < 0) ? lb[j] : ((at_bound[j] > 0) ? ub[j] : center[j]);
+		}
+		for (int i = 0; i < k; ++i) {
+			const vector<double>& gi = bundle[i].subgradient;
+			b[i] = bundle[i].alpha;
+			for (int j = 0; j < nrows_lag; ++j) {
+				b[i] += gi[j] * fixed_lambdas[j];
+			}
+			for (int l = 0; l <= i; ++l) {
+				const vector<double>& gl = bundle[l].subgradient;
+				double q = 0;
+				for (int j = 0; j < nrows_lag; ++j) {
+					if (at_bound[j] == 0) {
+						q += gi[j] * gl[j];
+					}
+				}
+				Q[i][l] = Q[l][i] = q / weight;
+			}
+		}
+
+		solve_simplex_qp(b, Q, theta);
+
+		// Unconstrained minimizer for each multiplier given theta; update the set of multipliers at bounds
+		bool changed = false;
+		for (int j = 0; j < nrows_lag; ++j) {
+			aggsubg[j] = 0;
+			for (int i = 0; i < k; ++i) {
+				aggsubg[j] += theta[i] * bundle[i].subgradient[j];
+			}
+			double value = center[j] - aggsubg[j] / weight;
+			int new_at_bound = (value < lb[j]) ? -1 : ((value > ub[j]) ? 1 : 0);
+			if (new_at_bound != at_bound[j]) {
+				at_bound[j] = new_at_bound;
+				changed = true;
+			}
+		}
+		if (!changed) {
+			break;
+		}
+	}
+
+	// Candidate, feasible regardless of the accuracy of the QP
+	lambdas.resize(nrows_lag);
+	for (int j = 0; j < nrows_lag; ++j) {
+		lambdas[j] = MIN(MAX(center[j] - aggsubg[j] / weight, lb[j]), ub[j]);
+	}
+
+	// Aggregated primal solution
+	agg_primal.assign(bundle[0].primal.size(), 0);
+	agg_primal_value = 0;
+	for (int i = 0; i < k; ++i) {
+		if (theta[i] == 0) {
+			continue;
+		}
+		agg_primal_value += theta[i] * bundle[i].primal_value;
+		for (int j = 0; j < (int) agg_primal.size(); ++j) {
+			agg_primal[j] += theta[i] * bundle[i].primal[j];
+		}
+	}
+
+	double model_value = get_model_value(lambdas);
+	predicted_decrease = center_value - model_value;
+
+	// No decrease predicted: converged (or inexact cuts lie above the center value)
+	if (predicted_decrease <= 0) {
+		predicted_decrease = 0;
+		lambdas = center;
+		return center_value;
+	}
+
+	return model_value;
+}
+
+
+double LagrangianMasterProblemBundle::recover_primal_sol(vector<double>& primal_sol)
+{
+	primal_sol = agg_primal;
+	return agg_primal_value;
+}
@@ -0,0 +1,127 @@
+/* Master problem for Lagrangian relaxation: Proximal bundle method */
+
+#ifndef LG_MASTER_BUNDLE_HPP_
+#define LG_MASTER_BUNDLE_HPP_
+
+#include <vector>
+#include "lg_master.hpp"
+#include "lg_constraint_matrix.hpp"
+#include "../util/util.hpp"
+
+using namespace std;
+
+
+/** Parameters of the proximal bundle method */
+struct LagrangianBundleParams {
+	int    max_bundle_size  = 50;      /**< maximum number of cuts; inactive cuts are dropped, then cuts are aggregated */
+	double descent_ratio    = 0.1;     /**< fraction of predicted decrease required for a serious step */
+	double initial_weight   = -1;      /**< initial proximal weight (negative: computed from the first subgradient) */
+	double min_weight       = 1e-10;   /**< minimum proximal weight */
+	double max_weight       = 1e10;    /**< maximum proximal weight */
+	int    max_qp_rounds    = 10;      /**< maximum number of updates of the set of multipliers at their bounds per solve */
+};
+
+
+/**
+ * Proximal bundle method for the Lagrangian dual min_lambda L(lambda), where L(lambda) = max_x (c - A^T lambda) x + lambda^T b
+ * and multipliers are sign-constrained by the sense of their constraints. Each solve minimizes the cutting-plane model
+ * plus (weight/2) ||lambda - center||^2; its dual is a small dense QP over the simplex of cut weights, solved by
+ * pairwise coordinate ascent for a fixed set of multipliers at their bounds, which is updated until consistent.
+ *
+ * Cuts may come from inexact evaluations: the value of any solution x at lambda gives a valid cut, while the center is
+ * only moved with upper bounds on L, so the center value is always a valid bound.
+ */
+class LagrangianMasterProblemBundle : public LagrangianMasterProblem
+{
+private:
+
+	/** Linearization alpha + subgradient^T lambda of the dual function, with the primal solution it comes from */
+	struct BundleCut {
+		double         alpha;
+		vector<double> subgradient;
+		vector<double> primal;
+		double         primal_value;        /**< original objective c^T x of primal */
+	};
+
+	LagrangianBundleParams params;
+	LagrangianConstraintMatrix matrix;
+
+	vector<double> lb;                      /**< lower bounds on multipliers */
+	vector<double> ub;                      /**< upper bounds on multipliers */
+
+	vector<BundleCut> bundle;
+	vector<double> theta;                   /**< weights of cuts in the last solve (aggregation coefficients) */
+	int nnew_cuts;                          /**< number of cuts added since the last solve (at the end of bundle) */
+
+	bool has_center;
+	vector<double> center;                  /**< stability center */
+	double center_value;                    /**< upper bound on the dual function at the center */
+	double weight;                          /**< proximal weight */
+	double predicted_decrease;              /**< center value minus model value at the last candidate */
+	int nnull_steps;                        /**< consecutive null steps */
+
+	vector<double> agg_primal;              /**< aggregated primal solution from the last solve */
+	double agg_primal_value;                /**< original objective value of agg_primal */
+
+	/** Return the value of the cutting-plane model at lambda */
+	double get_model_value(const vector<double>& lambdas);
+
+	/** Create the cut given by a subproblem solution with value sp_solval at lambdas */
+	void create_cut(const vector<int>& sp_sol, double sp_solval, const vector<double>& lambdas, BundleCut& cut);
+
+	/** Add a cut, dropping inactive cuts or aggregating the bundle if it is full */
+	void add_cut(BundleCut& cut);
+
+	/** Replace the cuts of the last solve by their convex combination given by theta */
+	void aggregate_bundle();
+
+public:
+
+	LagrangianMasterProblemBundle(const vector<LagrangianConstraint>& _relaxed_constrs,
+	                              LagrangianBundleParams _params = LagrangianBundleParams());
+
+	// Functions from base class
+
+	/** Update with an exact evaluation of the dual function at lambdas */
+	void update(const vector<int>& sp_optsol, double sp_optval, const vector<double>& lambdas);
+
+	/**
+	 * Compute the next candidate in lambdas and return the value of the model there. If the predicted decrease is not
+	 * positive, lambdas is set to the center and the center value is returned.
+	 */
+	double solve(vector<double>& lambdas);
+
+	/** Store the aggregated primal solution in primal_sol and return its original objective value */
+	double recover_primal_sol(vector<double>& primal_sol);
+
+	/**
+	 * Update with an inexact evaluation at lambdas: cut_value is the Lagrangian value of sp_optsol at lambdas (a lower
+	 * estimate of the dual function) and upper_bound is an upper bound on the dual function at lambdas
+	 */
+	void update_inexact(const vector<int>& sp_optsol, double cut_value, double upper_bound, const vector<double>& lambdas);
+
+	/** Add the cut of another subproblem solution at the multipliers of the last update */
+	void update_extra(const vector<int>& sp_sol, double sp_solval, const vector<double>& lambdas);
+
+	/** Return the best multipliers found, i.e. the stability center */
+	const vector<double>& get_center()
+	{
+		return center;
+	}
+
+	/** Return an upper bound on the dual function at the center */
+	double get_center_value()
+	{
+		return center_value;
+	}
+};
+
+
+/**
+ * Maximize b^T theta - 1/2 theta^T Q theta over the simplex, where Q is positive semidefinite (dense, k x k). theta is
+ * used as the starting point if it is in the simplex.
+ */
+void solve_simplex_qp(const vector<double>& b, const vector<vector<double>>& Q, vector<double>& theta);
+
+
+#endif // LG_MASTER_BUNDLE_HPP_
@@ -13,10 +13,7 @@ void LagrangianMasterProblemSubgradient::update(const vector<int>& sp_optsol, do
 	}
 	cout << endl;
 
-	int nrows_lag = get_nrows_lag();
-	for (int i = 0; i < nrows_lag; ++i) {
-		current_subgradients[i] = relaxed_constrs[i].get_lagrangian_subgradient(sp_optsol);
-	}
+	matrix.get_lagrangian_subgradient(sp_optsol, current_subgradients);
 
 	stepsize = compute_stepsize(sp_optval);
 
@@ -6,12 +6,14 @@
 #include <limits>
 #include <iostream>
 #include "lg_master.hpp"
+#include "lg_constraint_matrix.hpp"
 #include "../util/util.hpp"
 
 
 class LagrangianMasterProblemSubgradient : public LagrangianMasterProblem
 {
 private:
+	LagrangianConstraintMatrix matrix;
 	vector<double> current_subgradients;
 	double stepsize;
 	double stepscale;
@@ -25,6 +27,7 @@ private:
 public:
 	LagrangianMasterProblemSubgradient(const vector<LagrangianConstraint>& _relaxed_constrs) :
 		LagrangianMasterProblem(_relaxed_constrs),
+		matrix(_relaxed_constrs),
 		current_subgradients(_relaxed_constrs.size(), 0),
 		stepsize(0),
 		stepscale(2),
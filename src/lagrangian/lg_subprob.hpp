@@ -6,6 +6,7 @@
 #include <vector>
 #include <cassert>
 #include "../util/util.hpp"
+#include "../util/event_counters.hpp"
 
 using namespace std;
 
@@ -21,6 +22,28 @@ public:
 	 */
 	virtual double solve(const vector<double>& lambdas, vector<int>& optsol) = 0;
 
+	/**
+	 * Solve a subproblem up to relative precision relprec. Return an upper bound on the optimal value and store in optsol a
+	 * solution whose value sol_value is within relprec * (|bound| + 1) of it. By default, solve exactly.
+	 */
+	virtual double solve_inexact(const vector<double>& lambdas, double relprec, vector<int>& optsol, double& sol_value)
+	{
+		sol_value = solve(lambdas, optsol);
+		return sol_value;
+	}
+
+	/**
+	 * Solve a subproblem, storing in sols up to max_nsols good solutions, starting with an optimal one, and their values
+	 * in sol_values. Return the optimal value. By default, only the optimal solution is stored.
+	 */
+	virtual double solve_multiple(const vector<double>& lambdas, int max_nsols, vector<vector<int>>& sols,
+	                              vector<double>& sol_values)
+	{
+		sols.resize(1);
+		sol_values.assign(1, solve(lambdas, sols[0]));
+		return sol_values[0];
+	}
+
 };
 
 /**
@@ -39,6 +62,28 @@ public:
 	 */
 	virtual double solve(const vector<double>& obj, vector<int>& optsol) = 0;
 
+	/**
+	 * Solve a subproblem possibly inexactly. Return an upper bound on the optimal value and store in optsol a solution with
+	 * value sol_value. By default, solve exactly.
+	 */
+	virtual double solve_inexact(const vector<double>& obj, vector<int>& optsol, double& sol_value)
+	{
+		sol_value = solve(obj, optsol);
+		return sol_value;
+	}
+
+	/**
+	 * Solve a subproblem, storing in sols up to max_nsols good solutions, starting with an optimal one, and their values
+	 * in sol_values. Return the optimal value. By default, only the optimal solution is stored.
+	 */
+	virtual double solve_multiple(const vector<double>& obj, int max_nsols, vector<vector<int>>& sols,
+	                              vector<double>& sol_values)
+	{
+		sols.resize(1);
+		sol_values.assign(1, solve(obj, sols[0]));
+		return sol_values[0];
+	}
+
 protected:
 
 	/** Return value of a solution. Convenience function that may be used returning the objective value in solve. */
@@ -0,0 +1,76 @@
+#include "lg_subprob_bdd.hpp"
+
+
+double LagrangianSubproblemOracleBDDMultiResolution::solve(const vector<double>& obj, vector<int>& optsol)
+{
+	double optval = bdd->get_optimal_sol(obj, optsol, true);
+	add_to_pool(optsol);
+	return optval;
+}
+
+
+double LagrangianSubproblemOracleBDDMultiResolution::solve_multiple(const vector<double>& obj, int max_nsols,
+        vector<vector<int>>& sols, vector<double>& sol_values)
+{
+	bdd->get_k_best_sols(obj, max_nsols, sols, sol_values);
+	if (sols.empty()) {
+		sols.resize(1);
+		sol_values.assign(1, -numeric_limits<double>::infinity());
+	}
+	add_to_pool(sols[0]);
+	return sol_values[0];
+}
+
+
+void LagrangianSubproblemOracleBDDMultiResolution::add_to_pool(const vector<int>& sol)
+{
+	if (sol.size() > 0) {
+		pool.push_front(sol);
+		if ((int) pool.size() > max_pool_size) {
+			pool.pop_back();
+		}
+	}
+}
+
+
+double LagrangianSubproblemOracleBDDMultiResolution::solve_inexact(const vector<double>& obj, vector<int>& optsol,
+        double& sol_value)
+{
+	if (coarse_bdd == NULL) {
+		coarse_bdd = bdd->create_coarsening(coarse_width);
+	}
+
+	double bound = coarse_bdd->get_optimal_sol(obj, optsol, true);
+
+	if (optsol.size() == 0) {
+		sol_value = bound;
+		return bound;
+	}
+
+	// If the coarse optimal path is in the BDD, it is optimal for the BDD as well
+	int nvars = optsol.size();
+	path.resize(nvars);
+	for (int var = 0; var < nvars; ++var) {
+		path[bdd->var_to_layer[var]] = optsol[var];
+	}
+	if (bdd->contains_path(path)) {
+		sol_value = bound;
+		return bound;
+	}
+
+	if (pool.empty()) {
+		sol_value = solve(obj, optsol);
+		return sol_value;
+	}
+
+	sol_value = -numeric_limits<double>::infinity();
+	for (const vector<int>& sol : pool) {
+		double value = get_optimal_value(obj, sol);
+		if (value > sol_value) {
+			sol_value = value;
+			optsol = sol;
+		}
+	}
+
+	return bound;
+}
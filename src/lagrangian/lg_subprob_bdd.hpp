@@ -1,9 +1,11 @@
 #ifndef LG_SUBPROB_BDD_HPP_
 #define LG_SUBPROB_BDD_HPP_
 
+#include <deque>
 #include <vector>
 #include "lg_subprob.hpp"
 #include "../bdd/bdd.hpp"
+#include "../bdd/bdd_frozen.hpp"
 
 /** Simple oracle that returns the optimal solution in a BDD. */
 class LagrangianSubproblemOracleBDD : public LagrangianSubproblemOracle
@@ -22,7 +24,93 @@ public:
 		double optval = bdd->get_optimal_sol(obj, optsol, true);
 		return optval;
 	}
+
+	/** Calculate the max_nsols best solutions in a BDD. */
+	double solve_multiple(const vector<double>& obj, int max_nsols, vector<vector<int>>& sols, vector<double>& sol_values)
+	{
+		assert(bdd != NULL);
+		bdd->get_k_best_sols(obj, max_nsols, sols, sol_values);
+		if (sols.empty()) {
+			sols.resize(1);
+			sol_values.assign(1, -numeric_limits<double>::infinity());
+		}
+		return sol_values[0];
+	}
+};
+
+
+/** Oracle that returns the optimal solution in a frozen BDD; solves do not modify the BDD, so oracles may share it. */
+class LagrangianSubproblemOracleFrozenBDD : public LagrangianSubproblemOracle
+{
+private:
+	const FrozenBDD* bdd;
+
+public:
+
+	LagrangianSubproblemOracleFrozenBDD(const FrozenBDD* _bdd) : bdd(_bdd) {}
+
+	/** Calculate optimal solution in a frozen BDD. */
+	double solve(const vector<double>& obj, vector<int>& optsol)
+	{
+		assert(bdd != NULL);
+		double optval = bdd->get_optimal_sol(obj, optsol, true);
+		return optval;
+	}
+};
+
+
+/**
+ * Oracle over a BDD that also keeps a coarsening of the BDD (see BDD::create_coarsening) for inexact solves. The coarse
+ * optimum is an upper bound on the optimum of the BDD; if its path is not in the BDD, the solution is the best one among
+ * recent exact solutions, which are paths of the BDD. Exact solves use the BDD.
+ */
+class LagrangianSubproblemOracleBDDMultiResolution : public LagrangianSubproblemOracle
+{
+private:
+	BDD* bdd;
+	BDD* coarse_bdd;                     /**< coarsening of bdd, created at the first inexact solve (owned) */
+	int coarse_width;                    /**< width of coarse_bdd */
+
+	int max_pool_size;                   /**< number of recent exact solutions kept */
+	deque<vector<int>> pool;             /**< recent exact solutions, in variable space */
+
+	vector<int> path;                    /**< buffer for paths in layer space */
+
+	/** Add an exact solution to the pool */
+	void add_to_pool(const vector<int>& sol);
+
+public:
+
+	LagrangianSubproblemOracleBDDMultiResolution(BDD* _bdd, int _coarse_width, int _max_pool_size = 10) :
+		bdd(_bdd), coarse_bdd(NULL), coarse_width(_coarse_width), max_pool_size(_max_pool_size)
+	{
+		assert(bdd != NULL);
+	}
+
+	~LagrangianSubproblemOracleBDDMultiResolution()
+	{
+		delete coarse_bdd;
+	}
+
+	/** Calculate optimal solution in the BDD. */
+	double solve(const vector<double>& obj, vector<int>& optsol);
+
+	/** Bound from the coarse BDD; solution from the coarse BDD if it is in the BDD, otherwise from recent solutions. */
+	double solve_inexact(const vector<double>& obj, vector<int>& optsol, double& sol_value);
+
+	/** Calculate the max_nsols best solutions in the BDD. */
+	double solve_multiple(const vector<double>& obj, int max_nsols, vector<vector<int>>& sols, vector<double>& sol_values);
 };
 
 
+/** Create an oracle over a BDD, with a coarsening of the given width for inexact solves if positive and smaller */
+inline LagrangianSubproblemOracle* create_bdd_oracle(BDD* bdd, int coarse_width)
+{
+	if (coarse_width > 0 && coarse_width < bdd->get_width()) {
+		return new LagrangianSubproblemOracleBDDMultiResolution(bdd, coarse_width);
+	}
+	return new LagrangianSubproblemOracleBDD(bdd);
+}
+
+
 #endif // LG_SUBPROB_BDD_HPP_
\ No newline at end of file
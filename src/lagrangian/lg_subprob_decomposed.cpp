@@ -0,0 +1,92 @@
+#include <limits>
+#include "lg_subprob_decomposed.hpp"
+
+
+LagrangianSubproblemOracleDecomposed::LagrangianSubproblemOracleDecomposed(
+    const vector<LagrangianSubproblemOracle*>& _block_oracles, const vector<vector<int>>& _block_to_var, int _nvars,
+    int nthreads) :
+	block_oracles(_block_oracles), block_to_var(_block_to_var), nvars(_nvars),
+	pool(MIN(nthreads, (int) _block_oracles.size() - 1))
+{
+	int nblocks = block_oracles.size();
+	assert(nblocks > 0 && (int) block_to_var.size() == nblocks);
+
+	block_obj.resize(nblocks);
+	block_sol.resize(nblocks);
+	block_bound.resize(nblocks);
+	block_value.resize(nblocks);
+	for (int b = 0; b < nblocks; ++b) {
+		block_obj[b].resize(block_to_var[b].size());
+	}
+}
+
+
+void LagrangianSubproblemOracleDecomposed::split_objective(const vector<double>& obj)
+{
+	assert((int) obj.size() == nvars);
+	for (int b = 0; b < (int) block_oracles.size(); ++b) {
+		for (int k = 0; k < (int) block_to_var[b].size(); ++k) {
+			block_obj[b][k] = obj[block_to_var[b][k]];
+		}
+	}
+}
+
+
+bool LagrangianSubproblemOracleDecomposed::combine_solutions(vector<int>& optsol)
+{
+	optsol.assign(nvars, 0);
+	for (int b = 0; b < (int) block_oracles.size(); ++b) {
+		if (block_sol[b].size() == 0) {
+			optsol.clear();
+			return false;
+		}
+		for (int k = 0; k < (int) block_to_var[b].size(); ++k) {
+			optsol[block_to_var[b][k]] = block_sol[b][k];
+		}
+	}
+	return true;
+}
+
+
+double LagrangianSubproblemOracleDecomposed::solve(const vector<double>& obj, vector<int>& optsol)
+{
+	split_objective(obj);
+
+	pool.run(block_oracles.size(), [this](int b) {
+		block_bound[b] = block_oracles[b]->solve(block_obj[b], block_sol[b]);
+	});
+
+	if (!combine_solutions(optsol)) {
+		return -numeric_limits<double>::infinity();
+	}
+
+	double optval = 0;
+	for (double bound : block_bound) {
+		optval += bound;
+	}
+	return optval;
+}
+
+
+double LagrangianSubproblemOracleDecomposed::solve_inexact(const vector<double>& obj, vector<int>& optsol,
+        double& sol_value)
+{
+	split_objective(obj);
+
+	pool.run(block_oracles.size(), [this](int b) {
+		block_bound[b] = block_oracles[b]->solve_inexact(block_obj[b], block_sol[b], block_value[b]);
+	});
+
+	if (!combine_solutions(optsol)) {
+		sol_value = -numeric_limits<double>::infinity();
+		return sol_value;
+	}
+
+	double bound = 0;
+	sol_value = 0;
+	for (int b = 0; b < (int) block_oracles.size(); ++b) {
+		bound += block_bound[b];
+		sol_value += block_value[b];
+	}
+	return bound;
+}
@@ -0,0 +1,56 @@
+#ifndef LG_SUBPROB_DECOMPOSED_HPP_
+#define LG_SUBPROB_DECOMPOSED_HPP_
+
+#include <vector>
+#include "lg_subprob.hpp"
+#include "../util/worker_pool.hpp"
+
+using namespace std;
+
+/**
+ * Oracle for a problem that decomposes into blocks of variables with no constraint between them: the optimal solution
+ * is the union of the optimal solutions of the blocks, which are computed in parallel. Block oracles must be independent
+ * of each other (e.g. each with its own BDD) since they may run concurrently.
+ */
+class LagrangianSubproblemOracleDecomposed : public LagrangianSubproblemOracle
+{
+private:
+	vector<LagrangianSubproblemOracle*> block_oracles;  /**< oracle for each block (owned) */
+	vector<vector<int>> block_to_var;                   /**< block_to_var[b][k] is the variable of k-th variable of block b */
+	int nvars;                                          /**< number of variables in oracle space */
+	WorkerPool pool;                                    /**< threads solving blocks */
+
+	// Buffers per block
+	vector<vector<double>> block_obj;
+	vector<vector<int>> block_sol;
+	vector<double> block_bound;
+	vector<double> block_value;
+
+	/** Split obj into the blocks */
+	void split_objective(const vector<double>& obj);
+
+	/** Combine solutions of the blocks into optsol; return false if some block has no solution */
+	bool combine_solutions(vector<int>& optsol);
+
+public:
+
+	/** Blocks must partition the nvars variables; nthreads is the number of threads besides the calling one */
+	LagrangianSubproblemOracleDecomposed(const vector<LagrangianSubproblemOracle*>& _block_oracles,
+	                                     const vector<vector<int>>& _block_to_var, int _nvars, int nthreads);
+
+	~LagrangianSubproblemOracleDecomposed()
+	{
+		for (LagrangianSubproblemOracle* oracle : block_oracles) {
+			delete oracle;
+		}
+	}
+
+	/** Solve each block; the optimal value is the sum of the block optimal values */
+	double solve(const vector<double>& obj, vector<int>& optsol);
+
+	/** Solve each block inexactly; bounds and solution values are summed */
+	double solve_inexact(const vector<double>& obj, vector<int>& optsol, double& sol_value);
+};
+
+
+#endif // LG_SUBPROB_DECOMPOSED_HPP_
@@ -1,13 +1,43 @@
+#include <algorithm>
 #include "lg_subprob_feas.hpp"
 #include "lg_dd_selector_scip.hpp"
 
 double LagrangianSubproblemOracleFeasibilityCheck::solve(const vector<double>& obj, vector<int>& optsol)
 {
 	double optval = oracle->solve(obj, optsol);
+	queue_solution(optsol);
+	check_queued_solutions();
+	return optval;
+}
+
+
+double LagrangianSubproblemOracleFeasibilityCheck::solve_inexact(const vector<double>& obj, vector<int>& optsol,
+        double& sol_value)
+{
+	double bound = oracle->solve_inexact(obj, optsol, sol_value);
+	queue_solution(optsol);
+	check_queued_solutions();
+	return bound;
+}
+
+
+double LagrangianSubproblemOracleFeasibilityCheck::solve_multiple(const vector<double>& obj, int max_nsols,
+        vector<vector<int>>& sols, vector<double>& sol_values)
+{
+	double optval = oracle->solve_multiple(obj, max_nsols, sols, sol_values);
+	for (const vector<int>& sol : sols) {
+		queue_solution(sol);
+	}
+	check_queued_solutions();
+	return optval;
+}
 
+
+void LagrangianSubproblemOracleFeasibilityCheck::queue_solution(const vector<int>& optsol)
+{
 	// If no solution is found, do nothing
 	if (optsol.size() == 0) {
-		return optval;
+		return;
 	}
 
 	// Construct actual solution with fixed variables
@@ -26,36 +56,57 @@ double LagrangianSubproblemOracleFeasibilityCheck::solve(const vector<double>& o
 	// Check (true) objective value of oracle solution
 	double true_optval = get_optimal_value(true_obj, true_optsol);
 
-	// If true objective value is better than primal bound, check feasibility
+	// Only solutions with true objective value better than primal bound are checked
 	if (DBL_LT(-true_optval, primal_bound)) {
-		// cout << "Potential primal improvement: " << -true_optval << " better than " << primal_bound << endl;
-		bool feasible = feas_checker->check_feasibility_and_apply(true_optsol, -true_optval);
+		candidates.push_back(make_pair(-true_optval, true_optsol));
+	}
+}
+
+
+void LagrangianSubproblemOracleFeasibilityCheck::check_queued_solutions()
+{
+	sort(candidates.begin(), candidates.end());
+
+	for (const pair<double, vector<int>>& candidate : candidates) {
+		double value = candidate.first;
+		const vector<int>& true_optsol = candidate.second;
+
+		// Remaining candidates are no better than the primal bound
+		if (!DBL_LT(value, primal_bound)) {
+			break;
+		}
+
+		// Identical solutions are often returned over many iterations; each is checked once
+		int nvars = true_optsol.size();
+		vector<uint64_t> packed((nvars + 63) / 64, 0);
+		for (int i = 0; i < nvars; ++i) {
+			if (true_optsol[i] != 0) {
+				packed[i / 64] |= (uint64_t) 1 << (i % 64);
+			}
+		}
+		if (!checked_sols.insert(packed).second) {
+			output_stats->num_primal_cached++;
+			continue;
+		}
+
+		if (!feas_checker->precheck(true_optsol)) {
+			output_stats->num_primal_filtered++;
+			continue;
+		}
+
+		// cout << "Potential primal improvement: " << value << " better than " << primal_bound << endl;
+		output_stats->num_primal_checks++;
+		bool feasible = feas_checker->check_feasibility_and_apply(true_optsol, value);
 
 		// If feasible, mark as new primal bound
 		if (feasible) {
 			if (options->bounds_verbose) {
-				cout << "Feasible primal improvement found: from " << primal_bound << " to " << -true_optval << endl;
+				cout << "Feasible primal improvement found: from " << primal_bound << " to " << value << endl;
 			}
 			output_stats->num_primal_improved++;
-			primal_bound = -true_optval;
+			primal_bound = value;
 		}
 	}
 
-	// // Debugging info
-	// cout << "Solving Oracle: ";
-	// cout << "size " << optsol.size() << endl;
-	// // cout << "   True Obj: ";
-	// // for (double k : true_obj) {
-	// // 	cout << k << " ";
-	// // }
-	// // cout << endl;
-	// cout << "   True Sol: ";
-	// for (int k : true_optsol) {
-	// 	cout << k << " ";
-	// }
-	// cout << endl;
-	// cout << "   True Val: " << true_optval << endl;
-	// cout << "Primal Bound: " << primal_bound << endl;
-
-	return optval;
+	candidates.clear();
 }
@@ -1,6 +1,8 @@
 #ifndef LG_SUBPROB_FEAS_HPP_
 #define LG_SUBPROB_FEAS_HPP_
 
+#include <cstdint>
+#include <unordered_set>
 #include <vector>
 #include "lg_subprob.hpp"
 #include "../util/options.hpp"
@@ -15,6 +17,25 @@ public:
 
 	/** Checks if candidate is feasible and supplies primal solution to solver */
 	virtual bool check_feasibility_and_apply(const vector<int>& candidate, double optval) = 0;
+
+	/** Return false if candidate is certainly infeasible; cheap test run before check_feasibility_and_apply */
+	virtual bool precheck(const vector<int>& candidate)
+	{
+		return true;
+	}
+};
+
+
+/** Hash of a 0/1 solution packed into 64-bit words */
+struct PackedSolutionHash {
+	size_t operator()(const vector<uint64_t>& packed) const
+	{
+		size_t h = packed.size();
+		for (uint64_t word : packed) {
+			h ^= hash<uint64_t>()(word) + 0x9e3779b9 + (h << 6) + (h >> 2);
+		}
+		return h;
+	}
 };
 
 
@@ -34,6 +55,18 @@ private:
 	Options *options;
 	OutputStats *output_stats;
 
+	unordered_set<vector<uint64_t>, PackedSolutionHash> checked_sols;  /**< solutions already checked, packed */
+	vector<pair<double, vector<int>>> candidates;  /**< queued solutions (with fixed variables) and their objective */
+
+	/** Queue an oracle solution to be checked if it improves upon the primal bound */
+	void queue_solution(const vector<int>& optsol);
+
+	/**
+	 * Check queued solutions from best to worst, skipping solutions checked before and those rejected by the precheck,
+	 * until none improves upon the primal bound
+	 */
+	void check_queued_solutions();
+
 public:
 
 	LagrangianSubproblemOracleFeasibilityCheck(LagrangianSubproblemOracle* _oracle, FeasibilityChecker* _feas_checker,
@@ -49,6 +82,10 @@ public:
 	}
 
 	double solve(const vector<double>& obj, vector<int>& optsol);
+
+	double solve_inexact(const vector<double>& obj, vector<int>& optsol, double& sol_value);
+
+	double solve_multiple(const vector<double>& obj, int max_nsols, vector<vector<int>>& sols, vector<double>& sol_values);
 };
 
 
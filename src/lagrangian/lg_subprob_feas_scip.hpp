@@ -2,15 +2,41 @@
 #define LG_SUBPROB_FEAS_SCIP_HPP_
 
 #include "lg_subprob_feas.hpp"
+#include "lg_constraint_scip.hpp"
 
 
 class FeasibilityCheckerSCIP : public FeasibilityChecker
 {
 	SCIP* scip;
+	SCIP_HEUR* heur;          /**< heuristic to which solutions are attributed; NULL if none */
+	const SCIPRowMatrix* row_matrix;  /**< rows of the problem tested before calling SCIP; NULL if none */
 
 public:
 
-	FeasibilityCheckerSCIP(SCIP* _scip) : scip(_scip) {}
+	FeasibilityCheckerSCIP(SCIP* _scip, SCIP_HEUR* _heur = NULL, const SCIPRowMatrix* _row_matrix = NULL) :
+		scip(_scip), heur(_heur), row_matrix(_row_matrix) {}
+
+	/** Test the candidate against the rows of row_matrix (typically the Lagrangian rows, which the DD does not enforce) */
+	bool precheck(const vector<int>& candidate)
+	{
+		if (row_matrix == NULL) {
+			return true;
+		}
+		int nrows = row_matrix->size();
+		for (int i = 0; i < nrows; ++i) {
+			double activity = 0;
+			for (int k = row_matrix->row_start[i]; k < row_matrix->row_start[i + 1]; ++k) {
+				activity += row_matrix->vals[k] * candidate[row_matrix->col_ids[k]];
+			}
+			LinSense sense = row_matrix->senses[i];
+			double side = row_matrix->sides[i];
+			if ((sense != LINSENSE_GE && SCIPisFeasGT(scip, activity, side))
+			        || (sense != LINSENSE_LE && SCIPisFeasLT(scip, activity, side))) {
+				return false;
+			}
+		}
+		return true;
+	}
 
 	bool check_feasibility_and_apply(const vector<int>& candidate, double optval)
 	{
@@ -33,7 +59,7 @@ public:
 		}
 
 		SCIP_SOL* sol;
-		SCIP_CALL(SCIPcreateSol(scip, &sol, NULL));
+		SCIP_CALL(SCIPcreateSol(scip, &sol, heur));
 		SCIP_CALL(SCIPsetSolVals(scip, sol, ncols, vars, vals));
 		// SCIP_CALL( SCIPtrySolFree(scip, &sol, TRUE, TRUE, TRUE, TRUE, TRUE, &feasible) ); // print reason
 		SCIP_CALL(SCIPtrySolFree(scip, &sol, FALSE, TRUE, TRUE, TRUE, TRUE, &feasible));
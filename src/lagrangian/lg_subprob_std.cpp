@@ -1,36 +1,22 @@
+#include <cmath>
 #include "lg_subprob_std.hpp"
 
-double LagrangianSubproblemStandard::solve(const vector<double>& lambdas, vector<int>& optsol)
+double LagrangianSubproblemStandard::get_lagrangian_objective(const vector<double>& lambdas, vector<double>& lag_obj)
 {
-	int nconstrs = lambdas.size();
-	assert(nconstrs == (int) relaxed_constrs.size());
-
-	// Objective coefficients of Lagrangian relaxation: c - A^T lambda
-	vector<double> lag_obj(nvars, 0);
+	return matrix.get_lagrangian_objective(obj, lambdas, lag_obj);
+}
 
-	// c
-	for (int i = 0; i < nvars; ++i) {
-		lag_obj[i] = obj[i];
-	}
 
-	// - A^T lambda
-	for (int j = 0; j < nconstrs; ++j) {
-		int nnonz = relaxed_constrs[j].nnonz;
-		for (int k = 0; k < nnonz; ++k) {
-			int var = relaxed_constrs[j].ind[k];
-			double coeff = relaxed_constrs[j].coeffs[k];
-			lag_obj[var] -= coeff * lambdas[j];
-		}
-	}
+double LagrangianSubproblemStandard::solve(const vector<double>& lambdas, vector<int>& optsol)
+{
+	double constant = get_lagrangian_objective(lambdas, lag_obj);
 
 	// Calculate optimal solution using the oracle
+	COUNT_EVENT(EVENT_LAG_ORACLE_CALLS);
 	double oracle_optval = oracle->solve(lag_obj, optsol);
 
 	// Add lambda^T b to optimal value
-	double optimal_value = oracle_optval;
-	for (int j = 0; j < nconstrs; ++j) {
-		optimal_value += lambdas[j] * relaxed_constrs[j].rhs;
-	}
+	double optimal_value = oracle_optval + constant;
 
 	// // Debugging info
 	// cout << "Original obj coeffs: ";
@@ -44,7 +30,7 @@ double LagrangianSubproblemStandard::solve(const vector<double>& lambdas, vector
 	// }
 	// cout << endl;
 	// cout << "Lambdas: ";
-	// for (int j = 0; j < nconstrs; ++j) {
+	// for (int j = 0; j < (int) lambdas.size(); ++j) {
 	// 	cout << lambdas[j] << " ";
 	// }
 	// cout << endl;
@@ -57,3 +43,38 @@ double LagrangianSubproblemStandard::solve(const vector<double>& lambdas, vector
 
 	return optimal_value;
 }
+
+
+double LagrangianSubproblemStandard::solve_inexact(const vector<double>& lambdas, double relprec, vector<int>& optsol,
+        double& sol_value)
+{
+	double constant = get_lagrangian_objective(lambdas, lag_obj);
+
+	double oracle_sol_value;
+	COUNT_EVENT(EVENT_LAG_ORACLE_CALLS);
+	double bound = oracle->solve_inexact(lag_obj, optsol, oracle_sol_value) + constant;
+	sol_value = oracle_sol_value + constant;
+
+	if (bound - sol_value > relprec * (fabs(bound) + 1)) {
+		COUNT_EVENT(EVENT_LAG_ORACLE_CALLS);
+		bound = oracle->solve(lag_obj, optsol) + constant;
+		sol_value = bound;
+	}
+
+	return bound;
+}
+
+
+double LagrangianSubproblemStandard::solve_multiple(const vector<double>& lambdas, int max_nsols,
+        vector<vector<int>>& sols, vector<double>& sol_values)
+{
+	double constant = get_lagrangian_objective(lambdas, lag_obj);
+
+	COUNT_EVENT(EVENT_LAG_ORACLE_CALLS);
+	double optimal_value = oracle->solve_multiple(lag_obj, max_nsols, sols, sol_values) + constant;
+	for (double& value : sol_values) {
+		value += constant;
+	}
+
+	return optimal_value;
+}
@@ -6,6 +6,7 @@
 #include "../util/util.hpp"
 #include "lg_subprob.hpp"
 #include "lg_constraint.hpp"
+#include "lg_constraint_matrix.hpp"
 
 using namespace std;
 
@@ -15,14 +16,15 @@ class LagrangianSubproblemStandard : public LagrangianSubproblem
 private:
 	int nvars;                                     /**< number of variables */
 	vector<double> obj;                            /**< objective function of the original problem */
-	vector<LagrangianConstraint> relaxed_constrs;  /**< constraints relaxed in Lagrangian relaxation */
+	LagrangianConstraintMatrix matrix;             /**< constraints relaxed in Lagrangian relaxation */
 	LagrangianSubproblemOracle* oracle;            /**< oracle to call */
+	vector<double> lag_obj;                        /**< buffer for the Lagrangian objective, reused across calls */
 
 public:
 
 	LagrangianSubproblemStandard(int _nvars, const vector<double>& _obj, const vector<LagrangianConstraint>& _relaxed_constrs,
 	                             LagrangianSubproblemOracle* _oracle) :
-		nvars(_nvars), obj(_obj), relaxed_constrs(_relaxed_constrs), oracle(_oracle)
+		nvars(_nvars), obj(_obj), matrix(_relaxed_constrs, _nvars), oracle(_oracle)
 	{
 		assert(oracle != NULL);
 		assert((int) obj.size() == nvars);
@@ -30,6 +32,15 @@ public:
 
 	double solve(const vector<double>& lambdas, vector<int>& optsol);
 
+	/** Solve with the inexact oracle, falling back to an exact solve if the oracle is not within relprec */
+	double solve_inexact(const vector<double>& lambdas, double relprec, vector<int>& optsol, double& sol_value);
+
+	double solve_multiple(const vector<double>& lambdas, int max_nsols, vector<vector<int>>& sols,
+	                      vector<double>& sol_values);
+
+	/** Store objective coefficients c - A^T lambda in lag_obj and return the constant lambda^T b */
+	double get_lagrangian_objective(const vector<double>& lambdas, vector<double>& lag_obj);
+
 };
 
 #endif // LG_SUBPROB_STD_HPP_
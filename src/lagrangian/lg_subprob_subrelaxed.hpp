@@ -27,16 +27,8 @@ public:
 
 	double solve(const vector<double>& obj, vector<int>& optsol)
 	{
-		int nvars_original = obj.size();
-		int nvars_oracle = oracle_to_original_var.size();
-
-		assert(nvars_oracle <= nvars_original); // assume oracle space is a subspace of original space
-
-		// Map original to objective to oracle space (reduce to a possibly smaller space)
-		vector<double> oracle_obj(nvars_oracle);
-		for (int i = 0; i < nvars_oracle; ++i) {
-			oracle_obj[i] = obj[oracle_to_original_var[i]];
-		}
+		vector<double> oracle_obj;
+		map_objective(obj, oracle_obj);
 
 		// // Debugging info
 		// cout << "Lagrangian oracle objective: ";
@@ -54,6 +46,77 @@ public:
 			return optval;
 		}
 
+		complete_solution(obj, oracle_optsol, optsol);
+
+		// Recalculate optval with optsol updated with points from 0-1 cube (from scratch)
+		optval = get_optimal_value(obj, optsol);
+
+		return optval;
+	}
+
+	double solve_inexact(const vector<double>& obj, vector<int>& optsol, double& sol_value)
+	{
+		vector<double> oracle_obj;
+		map_objective(obj, oracle_obj);
+
+		vector<int> oracle_optsol;
+		double oracle_sol_value;
+		double bound = oracle->solve_inexact(oracle_obj, oracle_optsol, oracle_sol_value);
+
+		if (oracle_optsol.size() == 0) {
+			sol_value = bound;
+			return bound;
+		}
+
+		complete_solution(obj, oracle_optsol, optsol);
+
+		// Variables outside the oracle space contribute the same to the bound and to the solution value
+		sol_value = get_optimal_value(obj, optsol);
+		return bound + (sol_value - oracle_sol_value);
+	}
+
+	double solve_multiple(const vector<double>& obj, int max_nsols, vector<vector<int>>& sols, vector<double>& sol_values)
+	{
+		vector<double> oracle_obj;
+		map_objective(obj, oracle_obj);
+
+		vector<vector<int>> oracle_sols;
+		double optval = oracle->solve_multiple(oracle_obj, max_nsols, oracle_sols, sol_values);
+
+		sols.resize(oracle_sols.size());
+		for (int k = 0; k < (int) oracle_sols.size(); ++k) {
+			if (oracle_sols[k].size() == 0) {
+				sols[k].clear();
+				continue;
+			}
+			complete_solution(obj, oracle_sols[k], sols[k]);
+			sol_values[k] = get_optimal_value(obj, sols[k]);
+		}
+
+		return (sols[0].size() > 0) ? sol_values[0] : optval;
+	}
+
+private:
+
+	/** Map original objective to oracle space (reduce to a possibly smaller space) */
+	void map_objective(const vector<double>& obj, vector<double>& oracle_obj)
+	{
+		int nvars_oracle = oracle_to_original_var.size();
+
+		assert(nvars_oracle <= (int) obj.size()); // assume oracle space is a subspace of original space
+
+		oracle_obj.resize(nvars_oracle);
+		for (int i = 0; i < nvars_oracle; ++i) {
+			oracle_obj[i] = obj[oracle_to_original_var[i]];
+		}
+	}
+
+	/** Extend an oracle solution to the original space, setting variables outside the oracle space by their objective */
+	void complete_solution(const vector<double>& obj, const vector<int>& oracle_optsol, vector<int>& optsol)
+	{
+		int nvars_original = obj.size();
+		int nvars_oracle = oracle_to_original_var.size();
+
 		// Set variables not in oracle space to zero if obj is negative; one if obj is positive
 		optsol.clear();
 		optsol.resize(nvars_original, 0);
@@ -69,11 +132,6 @@ public:
 		for (int i = 0; i < nvars_oracle; ++i) {
 			optsol[oracle_to_original_var[i]] = oracle_optsol[i];
 		}
-
-		// Recalculate optval with optsol updated with points from 0-1 cube (from scratch)
-		optval = get_optimal_value(obj, optsol);
-
-		return optval;
 	}
 };
 
@@ -3,53 +3,102 @@
 #include <sstream>
 
 #include "getopt.h"
+#include "batch.hpp"
 #include "util/options.hpp"
-
-#ifdef SOLVER_SCIP
-#include "ip/ip_scip.hpp"
-#include "problem/bp/bp_reader_scip.hpp"
-#include "problem/bp/bp_model_scip.hpp"
-#include "problem/indepset/indepset_model_scip.hpp"
-#endif
+#include "util/profiler.hpp"
+#include "core/solver_telemetry.hpp"
 
 using namespace std;
 
 
-int main(int argc, char* argv[])
+/** Close the telemetry sink and write the profile trace, if enabled */
+void finish_output(Options* options)
 {
+	if (dd_telemetry != NULL) {
+		delete dd_telemetry;
+		dd_telemetry = NULL;
+	}
 
-	Options options;
-
-	if (argc < 2) {
-		cout << "\nUsage: " << argv[0] << " [options] [instance file]\n";
-		cout << endl;
-		cout << "Decision diagram construction options:" << endl;
-		cout << "    -w [width]                maximum decision diagram width (default: no limit)" << endl;
-		cout << "    --no-long-arcs            do not use long arcs in the construction" << endl;
-		cout << endl;
-		cout << "Decision diagram bounds options:" << endl;
-		cout << "    --no-bounds               do not generate bounds from DDs" << endl;
-		cout << "    --lag-nvars               generate bounds from DDs at subproblems with at most this many variables" << endl;
-		cout << "    --lag-nvarsfrac           generate bounds from DDs at subproblems with at most this many variables, as a fraction of total number of variables" << endl;
-		cout << "    --lag-primal              generate primal bounds by checking if primal solutions generated in Lagrangian relaxation are feasible" << endl;
-		cout << "    --lag-primal-nrp          generate primal bounds by finding optimal non-relaxed paths (without Lagrangian relaxation)" << endl;
-		cout << "    --lag-primal-pruning      use primal bound from MIP solver to prune DDs" << endl;
-		cout << "    --lag-prop                apply propagation in Lagrangian relaxation" << endl;
-		cout << "    --lag-iter-limit          limit on number of iterations in Lagrangian relaxation" << endl;
-		cout << "    --lag-initial-dd          prepare Lagrangian rows and decision diagrams before first LP" << endl;
-		cout << "    --lag-run-once            abort at the end of first relaxation (useful to obtain bounds quickly)" << endl;
-		cout << endl;
-		cout << "MIP solver options:" << endl;
-		cout << "    --solver-cuts [set]       MIP solver cuts: -1 none (default), 0: solver default, 2: aggressive" << endl;
-		cout << "    --root-only               stop solver at the end of the root node" << endl;
-		cout << "    --root-lp                 LP algorithm at root" << endl;
-		cout << "    --mip-time-limit          time limit for MIP solver in seconds" << endl;
-		cout << "    --mip-seed                random seed for MIP solver (does nothing if zero)" << endl;
-		cout << endl;
+	if (options->profile_trace_file.empty()) {
+		return;
+	}
+	profiler_enable(false);
+	cout << endl;
+	profiler_print_summary();
+	if (!profiler_write_chrome_trace(options->profile_trace_file.c_str())) {
+		cout << "Error: Profile trace file cannot be written" << endl;
 		exit(1);
 	}
+	cout << "Profile trace written to " << options->profile_trace_file << endl;
+}
+
 
-	static struct option long_options[] = {
+/** Print the command line usage */
+void print_usage(const char* program)
+{
+	cout << "\nUsage: " << program << " [options] [instance file]\n";
+	cout << endl;
+	cout << "Decision diagram construction options:" << endl;
+	cout << "    -w [width]                maximum decision diagram width (default: no limit)" << endl;
+	cout << "    --no-long-arcs            do not use long arcs in the construction" << endl;
+	cout << "    --dd-memory-limit [MB]    approximate memory limit of a DD construction; width is halved past it, then construction is aborted with a partial bound" << endl;
+	cout << endl;
+	cout << "Decision diagram bounds options:" << endl;
+	cout << "    --no-bounds               do not generate bounds from DDs" << endl;
+	cout << "    --lag-nvars               generate bounds from DDs at subproblems with at most this many variables" << endl;
+	cout << "    --lag-nvarsfrac           generate bounds from DDs at subproblems with at most this many variables, as a fraction of total number of variables" << endl;
+	cout << "    --lag-primal              generate primal bounds by checking if primal solutions generated in Lagrangian relaxation are feasible" << endl;
+	cout << "    --lag-primal-nrp          generate primal bounds by finding optimal non-relaxed paths (without Lagrangian relaxation)" << endl;
+	cout << "    --lag-primal-pruning      use primal bound from MIP solver to prune DDs" << endl;
+	cout << "    --lag-prop                apply propagation in Lagrangian relaxation" << endl;
+	cout << "    --lag-iter-limit          limit on number of iterations in Lagrangian relaxation" << endl;
+	cout << "    --lag-initial-dd          prepare Lagrangian rows and decision diagrams before first LP" << endl;
+	cout << "    --lag-run-once            abort at the end of first relaxation (useful to obtain bounds quickly)" << endl;
+	cout << "    --lag-rc-fixing           fix variables using DD longest paths under the Lagrangian objective (reduced-cost fixing)" << endl;
+	cout << "    --lag-bundle              solve the Lagrangian dual with the built-in bundle method instead of ConicBundle" << endl;
+	cout << "    --lag-coarse-width        width of a coarsened DD answering early Lagrangian iterations inexactly (default: 0, disabled)" << endl;
+	cout << "    --lag-nsubgradients       number of best DD paths returned as subgradients per Lagrangian oracle call (default: 1)" << endl;
+	cout << "    --lag-decompose           build one DD per block of variables sharing no DD constraint and sum their bounds" << endl;
+	cout << "    --lag-decompose-threads   number of threads solving DD blocks with --lag-decompose (default: 1)" << endl;
+	cout << "    --lag-decompose-enum-size components up to this size are enumerated instead of building a DD with --lag-decompose (default: 6)" << endl;
+	cout << "    --lag-warm-start          start the Lagrangian relaxation at each node from the multipliers of its closest ancestor" << endl;
+	cout << "    --lag-async               compute DD bounds in background threads while the MIP solver continues" << endl;
+	cout << "    --lag-async-threads       number of background threads for --lag-async (default: number of cores - 1)" << endl;
+	cout << endl;
+	cout << "Decision diagram primal heuristic options:" << endl;
+	cout << "    --heur-dd                 run primal heuristic based on restricted DDs in the MIP solver" << endl;
+	cout << "    --heur-dd-width           maximum width of restricted DDs in primal heuristic (default: 100)" << endl;
+	cout << endl;
+	cout << "Decision diagram branch-and-bound options (independent set only):" << endl;
+	cout << "    --dd-bb                   solve with parallel DD branch-and-bound instead of the MIP solver (uses -w as width)" << endl;
+	cout << "    --dd-bb-threads           number of threads for DD branch-and-bound (default: number of cores)" << endl;
+	cout << "    --dd-bb-time-limit        time limit for DD branch-and-bound in seconds (wall clock)" << endl;
+	cout << endl;
+	cout << "Batch options:" << endl;
+	cout << "    --batch [manifest]        run jobs from a manifest instead of a single instance (see OPTIONS.md for its format)" << endl;
+	cout << "    --batch-threads           number of jobs run concurrently in batch mode (default: number of cores)" << endl;
+	cout << "    --batch-output [file]     results table of batch mode in CSV (default: batch_results.csv)" << endl;
+	cout << "    --batch-time-limit        time limit per batch job in seconds, for the MIP solver or DD branch-and-bound" << endl;
+	cout << "    --batch-memory-limit      approximate memory limit per batch job in MB, for the MIP solver and DD construction" << endl;
+	cout << endl;
+	cout << "Input options:" << endl;
+	cout << "    --instance-cache          read independent set instances from a binary cache next to the instance file, creating it if needed" << endl;
+	cout << endl;
+	cout << "Output options:" << endl;
+	cout << "    --profile-trace [file]    write a Chrome trace of DD construction, relaxator and Lagrangian scopes per B&B node" << endl;
+	cout << "    --dd-telemetry [file]     write statistics of every layer of every DD constructed (CSV if .csv, NDJSON otherwise)" << endl;
+	cout << endl;
+	cout << "MIP solver options:" << endl;
+	cout << "    --solver-cuts [set]       MIP solver cuts: -1 none (default), 0: solver default, 2: aggressive" << endl;
+	cout << "    --root-only               stop solver at the end of the root node" << endl;
+	cout << "    --root-lp                 LP algorithm at root" << endl;
+	cout << "    --mip-time-limit          time limit for MIP solver in seconds" << endl;
+	cout << "    --mip-seed                random seed for MIP solver (does nothing if zero)" << endl;
+	cout << endl;
+}
+
+
+static struct option long_options[] = {
 #define OPT_NO_LONG_ARCS           0
 #define OPT_SOLVER_CUTS            1
 #define OPT_ROOT_ONLY              2
@@ -75,208 +124,437 @@ int main(int argc, char* argv[])
 #define OPT_MIP_TIME_LIMIT        22
 #define OPT_MIP_SEED              23
 #define OPT_OUTPUT_STATS_VERBOSE  24
-		{"merger",                 required_argument, 0, 'm'},
-		{"ordering",               required_argument, 0, 'o'},
-		{"width",                  required_argument, 0, 'w'},
-		{"verbose",                no_argument,       0, 'v'},
-		{"output-stats-verbose",   no_argument,       0, OPT_OUTPUT_STATS_VERBOSE},
-		{"no-long-arcs",           no_argument,       0, OPT_NO_LONG_ARCS},
-		{"solver-cuts",            required_argument, 0, OPT_SOLVER_CUTS},
-		{"root-only",              no_argument,       0, OPT_ROOT_ONLY},
-		{"root-lp",                required_argument, 0, OPT_ROOT_LP},
-
-		// Bound options
-		{"no-bounds",              no_argument,       0, OPT_NO_BOUNDS},
-		{"lag-prop",               no_argument,       0, OPT_LAG_PROP},
-		{"lag-nvarsfrac",          required_argument, 0, OPT_LAG_NVARSFRAC},
-		{"lag-nvars",              required_argument, 0, OPT_LAG_NVARS},
-		{"lag-nvars-min",          required_argument, 0, OPT_LAG_NVARS_MIN},
-		{"lag-time-limit",         required_argument, 0, OPT_LAG_TIMELIMIT},
-		{"lag-primal",             no_argument,       0, OPT_LAG_PRIMAL},
-		{"lag-validate",           no_argument,       0, OPT_LAG_VALIDATE},
-		{"lag-primal-pruning",     no_argument,       0, OPT_LAG_PRIMAL_PRUNING},
-		{"lag-iter-limit",         required_argument, 0, OPT_LAG_ITERLIMIT},
-		{"lag-compute-only",       no_argument,       0, OPT_LAG_COMPUTE_ONLY},
-		{"lag-pure-bp",            no_argument,       0, OPT_LAG_PURE_BP},
-		{"lag-dual-pruning",       no_argument,       0, OPT_LAG_DUAL_PRUNING},
-		{"lag-add-linear",         no_argument,       0, OPT_LAG_ADD_LINEAR},
-		{"lag-primal-nrp",         no_argument,       0, OPT_LAG_PRIMAL_NRP},
-		{"lag-initial-dd",         no_argument,       0, OPT_LAG_INITIAL_DD},
-		{"lag-pure-bp-nolinprop",  no_argument,       0, OPT_LAG_PURE_BP_NOLINPROP},
-		{"lag-run-once",           no_argument,       0, OPT_LAG_RUN_ONCE},
-
-		{"mip-time-limit",         required_argument, 0, OPT_MIP_TIME_LIMIT},
-		{"mip-seed",               required_argument, 0, OPT_MIP_SEED},
-		{0, 0, 0, 0}
-	};
+#define OPT_DD_BB                 25
+#define OPT_DD_BB_THREADS         26
+#define OPT_DD_BB_TIME_LIMIT      27
+#define OPT_HEUR_DD               28
+#define OPT_HEUR_DD_WIDTH         29
+#define OPT_LAG_RC_FIXING         30
+#define OPT_LAG_ASYNC             31
+#define OPT_LAG_ASYNC_THREADS     32
+#define OPT_LAG_WARM_START        33
+#define OPT_LAG_BUNDLE            34
+#define OPT_LAG_COARSE_WIDTH      35
+#define OPT_LAG_NSUBGRADIENTS     36
+#define OPT_LAG_DECOMPOSE         37
+#define OPT_LAG_DECOMPOSE_THREADS 38
+#define OPT_LAG_DECOMPOSE_ENUM_SIZE 39
+#define OPT_INSTANCE_CACHE        40
+#define OPT_PROFILE_TRACE         41
+#define OPT_DD_TELEMETRY          42
+#define OPT_DD_MEMORY_LIMIT       43
+#define OPT_BATCH                 44
+#define OPT_BATCH_THREADS         45
+#define OPT_BATCH_OUTPUT          46
+#define OPT_BATCH_TIME_LIMIT      47
+#define OPT_BATCH_MEMORY_LIMIT    48
+	{"merger",                 required_argument, 0, 'm'},
+	{"ordering",               required_argument, 0, 'o'},
+	{"width",                  required_argument, 0, 'w'},
+	{"verbose",                no_argument,       0, 'v'},
+	{"output-stats-verbose",   no_argument,       0, OPT_OUTPUT_STATS_VERBOSE},
+	{"no-long-arcs",           no_argument,       0, OPT_NO_LONG_ARCS},
+	{"dd-memory-limit",        required_argument, 0, OPT_DD_MEMORY_LIMIT},
+	{"solver-cuts",            required_argument, 0, OPT_SOLVER_CUTS},
+	{"root-only",              no_argument,       0, OPT_ROOT_ONLY},
+	{"root-lp",                required_argument, 0, OPT_ROOT_LP},
+
+	// Bound options
+	{"no-bounds",              no_argument,       0, OPT_NO_BOUNDS},
+	{"lag-prop",               no_argument,       0, OPT_LAG_PROP},
+	{"lag-nvarsfrac",          required_argument, 0, OPT_LAG_NVARSFRAC},
+	{"lag-nvars",              required_argument, 0, OPT_LAG_NVARS},
+	{"lag-nvars-min",          required_argument, 0, OPT_LAG_NVARS_MIN},
+	{"lag-time-limit",         required_argument, 0, OPT_LAG_TIMELIMIT},
+	{"lag-primal",             no_argument,       0, OPT_LAG_PRIMAL},
+	{"lag-validate",           no_argument,       0, OPT_LAG_VALIDATE},
+	{"lag-primal-pruning",     no_argument,       0, OPT_LAG_PRIMAL_PRUNING},
+	{"lag-iter-limit",         required_argument, 0, OPT_LAG_ITERLIMIT},
+	{"lag-compute-only",       no_argument,       0, OPT_LAG_COMPUTE_ONLY},
+	{"lag-pure-bp",            no_argument,       0, OPT_LAG_PURE_BP},
+	{"lag-dual-pruning",       no_argument,       0, OPT_LAG_DUAL_PRUNING},
+	{"lag-add-linear",         no_argument,       0, OPT_LAG_ADD_LINEAR},
+	{"lag-primal-nrp",         no_argument,       0, OPT_LAG_PRIMAL_NRP},
+	{"lag-initial-dd",         no_argument,       0, OPT_LAG_INITIAL_DD},
+	{"lag-pure-bp-nolinprop",  no_argument,       0, OPT_LAG_PURE_BP_NOLINPROP},
+	{"lag-run-once",           no_argument,       0, OPT_LAG_RUN_ONCE},
+	{"lag-rc-fixing",          no_argument,       0, OPT_LAG_RC_FIXING},
+	{"lag-warm-start",         no_argument,       0, OPT_LAG_WARM_START},
+	{"lag-bundle",             no_argument,       0, OPT_LAG_BUNDLE},
+	{"lag-coarse-width",       required_argument, 0, OPT_LAG_COARSE_WIDTH},
+	{"lag-nsubgradients",      required_argument, 0, OPT_LAG_NSUBGRADIENTS},
+	{"lag-decompose",          no_argument,       0, OPT_LAG_DECOMPOSE},
+	{"lag-decompose-threads",  required_argument, 0, OPT_LAG_DECOMPOSE_THREADS},
+	{"lag-decompose-enum-size",required_argument, 0, OPT_LAG_DECOMPOSE_ENUM_SIZE},
+	{"lag-async",              no_argument,       0, OPT_LAG_ASYNC},
+	{"lag-async-threads",      required_argument, 0, OPT_LAG_ASYNC_THREADS},
 
+	{"dd-bb",                  no_argument,       0, OPT_DD_BB},
+	{"dd-bb-threads",          required_argument, 0, OPT_DD_BB_THREADS},
+	{"dd-bb-time-limit",       required_argument, 0, OPT_DD_BB_TIME_LIMIT},
+
+	{"heur-dd",                no_argument,       0, OPT_HEUR_DD},
+	{"heur-dd-width",          required_argument, 0, OPT_HEUR_DD_WIDTH},
+
+	{"batch",                  required_argument, 0, OPT_BATCH},
+	{"batch-threads",          required_argument, 0, OPT_BATCH_THREADS},
+	{"batch-output",           required_argument, 0, OPT_BATCH_OUTPUT},
+	{"batch-time-limit",       required_argument, 0, OPT_BATCH_TIME_LIMIT},
+	{"batch-memory-limit",     required_argument, 0, OPT_BATCH_MEMORY_LIMIT},
+
+	{"instance-cache",         no_argument,       0, OPT_INSTANCE_CACHE},
+	{"profile-trace",          required_argument, 0, OPT_PROFILE_TRACE},
+	{"dd-telemetry",           required_argument, 0, OPT_DD_TELEMETRY},
+
+	{"mip-time-limit",         required_argument, 0, OPT_MIP_TIME_LIMIT},
+	{"mip-seed",               required_argument, 0, OPT_MIP_SEED},
+	{0, 0, 0, 0}
+};
+
+
+/** Parse command line options into options and return the index of the first argument that is not an option */
+int parse_options(int argc, char* argv[], Options* options)
+{
 	int c;
 	int option_index = 0;
+	optind = 0; // reinitialize getopt, which may have been used for other arguments
 	while ((c = getopt_long(argc, argv, "bc:m:o:w:v", long_options, &option_index)) != -1) {
 		switch (c) {
 		case 'm':
-			options.merge_id = atoi(optarg);
+			options->merge_id = atoi(optarg);
 			break;
 		case 'o':
-			options.order_id = atoi(optarg);
+			options->order_id = atoi(optarg);
 			break;
 		case 'w':
-			options.width = atoi(optarg);
-			if (options.width <= 0) {
+			options->width = atoi(optarg);
+			if (options->width <= 0) {
 				cout << "Error: Invalid parameter - width must be positive" << endl;
 				exit(1);
 			}
 			break;
 		case 'v':
-			options.bounds_verbose = true;
+			options->bounds_verbose = true;
 			break;
 		case OPT_OUTPUT_STATS_VERBOSE:
-			options.output_stats_verbose = true;
+			options->output_stats_verbose = true;
 			break;
 		case OPT_NO_LONG_ARCS:
-			options.use_long_arcs = false;
+			options->use_long_arcs = false;
+			break;
+		case OPT_DD_MEMORY_LIMIT:
+			options->dd_memory_limit = atof(optarg);
 			break;
 		case OPT_SOLVER_CUTS:
-			options.mip_cuts = atoi(optarg);
+			options->mip_cuts = atoi(optarg);
 			break;
 		case OPT_ROOT_ONLY:
-			options.stop_after_root = true;
+			options->stop_after_root = true;
 			break;
 		case OPT_ROOT_LP:
-			options.root_lp = atoi(optarg);
-			if (options.root_lp < 0) {
+			options->root_lp = atoi(optarg);
+			if (options->root_lp < 0) {
 				cout << "Error: Invalid parameter - LP root algorithm" << endl;
 				exit(1);
 			}
 			break;
 		case OPT_NO_BOUNDS:
-			options.generate_bounds = false;
+			options->generate_bounds = false;
 			break;
 		case OPT_LAG_PROP:
-			options.lag_prop = true;
+			options->lag_prop = true;
 			break;
 		case OPT_LAG_NVARSFRAC:
-			options.lag_nvars_frac_to_apply = atof(optarg);
-			if (options.lag_nvars_frac_to_apply < 0 || options.lag_nvars_frac_to_apply > 1) {
+			options->lag_nvars_frac_to_apply = atof(optarg);
+			if (options->lag_nvars_frac_to_apply < 0 || options->lag_nvars_frac_to_apply > 1) {
 				cout << "Error: Invalid parameter - fraction of variables to apply DD bound" << endl;
 				exit(1);
 			}
-			if (options.lag_nvars_to_apply >= 0) {
+			if (options->lag_nvars_to_apply >= 0) {
 				cout << "Error: Cannot set both fraction of variables and number of variables to apply DD bound" << endl;
 				exit(1);
 			}
 			break;
 		case OPT_LAG_NVARS:
-			options.lag_nvars_to_apply = atoi(optarg);
-			if (options.lag_nvars_to_apply < 0) {
+			options->lag_nvars_to_apply = atoi(optarg);
+			if (options->lag_nvars_to_apply < 0) {
 				cout << "Error: Invalid parameter - number of variables to apply DD bound" << endl;
 				exit(1);
 			}
-			if (options.lag_nvars_frac_to_apply != 1) {
+			if (options->lag_nvars_frac_to_apply != 1) {
 				cout << "Error: Cannot set both fraction of variables and number of variables to apply DD bound" << endl;
 				exit(1);
 			}
 			break;
 		case OPT_LAG_NVARS_MIN:
-			options.lag_nvars_to_apply_min = atoi(optarg);
-			if (options.lag_nvars_to_apply_min < 0) {
+			options->lag_nvars_to_apply_min = atoi(optarg);
+			if (options->lag_nvars_to_apply_min < 0) {
 				cout << "Error: Invalid parameter - number of variables to apply DD bound" << endl;
 				exit(1);
 			}
-			if (options.lag_nvars_frac_to_apply != 1) {
+			if (options->lag_nvars_frac_to_apply != 1) {
 				cout << "Error: Cannot set both fraction of variables and number of variables to apply DD bound" << endl;
 				exit(1);
 			}
 			break;
 		case OPT_LAG_TIMELIMIT:
-			options.lag_cb_time_limit = atof(optarg);
+			options->lag_cb_time_limit = atof(optarg);
 			break;
 		case OPT_LAG_ITERLIMIT:
-			options.lag_cb_iter_limit = atoi(optarg);
+			options->lag_cb_iter_limit = atoi(optarg);
 			break;
 		case OPT_LAG_PURE_BP:
-			options.lag_pure_bp = true;
+			options->lag_pure_bp = true;
 			break;
 		case OPT_LAG_PRIMAL:
-			options.lag_generate_primal = true;
+			options->lag_generate_primal = true;
 			break;
 		case OPT_LAG_PRIMAL_NRP:
-			options.lag_generate_primal_nrp = true;
+			options->lag_generate_primal_nrp = true;
 			break;
 		case OPT_LAG_VALIDATE:
-			options.lag_validate_bounds = true;
+			options->lag_validate_bounds = true;
 			break;
 		case OPT_LAG_PRIMAL_PRUNING:
-			options.lag_primal_pruning = true;
+			options->lag_primal_pruning = true;
 			break;
 		case OPT_LAG_DUAL_PRUNING:
-			options.lag_dual_pruning = true;
+			options->lag_dual_pruning = true;
 			break;
 		case OPT_LAG_COMPUTE_ONLY:
-			options.lag_compute_only = true;
+			options->lag_compute_only = true;
 			break;
 		case OPT_LAG_ADD_LINEAR:
-			options.lag_add_linear = true;
+			options->lag_add_linear = true;
 			break;
 		case OPT_LAG_INITIAL_DD:
-			options.lag_initial_dd = true;
+			options->lag_initial_dd = true;
 			break;
 		case OPT_LAG_PURE_BP_NOLINPROP:
-			options.lag_pure_bp_linprop = false;
+			options->lag_pure_bp_linprop = false;
 			break;
 		case OPT_LAG_RUN_ONCE:
-			options.lag_run_once = true;
+			options->lag_run_once = true;
+			break;
+		case OPT_LAG_RC_FIXING:
+			options->lag_rc_fixing = true;
+			break;
+		case OPT_LAG_WARM_START:
+			options->lag_warm_start = true;
+			break;
+		case OPT_LAG_BUNDLE:
+			options->lag_bundle = true;
+			break;
+		case OPT_LAG_COARSE_WIDTH:
+			options->lag_coarse_width = atoi(optarg);
+			if (options->lag_coarse_width < 0) {
+				cout << "Error: Invalid parameter - coarse width must be nonnegative" << endl;
+				exit(1);
+			}
+			break;
+		case OPT_LAG_NSUBGRADIENTS:
+			options->lag_nsubgradients = atoi(optarg);
+			if (options->lag_nsubgradients < 1) {
+				cout << "Error: Invalid parameter - number of subgradients must be positive" << endl;
+				exit(1);
+			}
+			break;
+		case OPT_LAG_DECOMPOSE:
+			options->lag_decompose = true;
+			break;
+		case OPT_LAG_DECOMPOSE_THREADS:
+			options->lag_decompose_nthreads = atoi(optarg);
+			if (options->lag_decompose_nthreads < 1) {
+				cout << "Error: Invalid parameter - number of block threads must be positive" << endl;
+				exit(1);
+			}
+			break;
+		case OPT_LAG_DECOMPOSE_ENUM_SIZE:
+			options->lag_decompose_enum_size = atoi(optarg);
+			if (options->lag_decompose_enum_size < 0 || options->lag_decompose_enum_size > 20) {
+				cout << "Error: Invalid parameter - enumerated component size must be between 0 and 20" << endl;
+				exit(1);
+			}
+			break;
+		case OPT_LAG_ASYNC:
+			options->lag_async = true;
+			break;
+		case OPT_LAG_ASYNC_THREADS:
+			options->lag_async_nthreads = atoi(optarg);
+			if (options->lag_async_nthreads < 0) {
+				cout << "Error: Invalid parameter - number of threads must be nonnegative" << endl;
+				exit(1);
+			}
+			break;
+		case OPT_DD_BB:
+			options->run_dd_bb = true;
+			break;
+		case OPT_DD_BB_THREADS:
+			options->bb_nthreads = atoi(optarg);
+			if (options->bb_nthreads < 0) {
+				cout << "Error: Invalid parameter - number of threads must be nonnegative" << endl;
+				exit(1);
+			}
+			break;
+		case OPT_DD_BB_TIME_LIMIT:
+			options->bb_time_limit = atof(optarg);
+			break;
+		case OPT_HEUR_DD:
+			options->heur_dd = true;
+			break;
+		case OPT_HEUR_DD_WIDTH:
+			options->heur_dd_width = atoi(optarg);
+			if (options->heur_dd_width <= 0) {
+				cout << "Error: Invalid parameter - heuristic width must be positive" << endl;
+				exit(1);
+			}
+			break;
+		case OPT_INSTANCE_CACHE:
+			options->instance_cache = true;
+			break;
+		case OPT_BATCH:
+			options->batch_manifest_file = optarg;
+			break;
+		case OPT_BATCH_THREADS:
+			options->batch_nthreads = atoi(optarg);
+			if (options->batch_nthreads < 0) {
+				cout << "Error: Invalid parameter - number of threads must be nonnegative" << endl;
+				exit(1);
+			}
+			break;
+		case OPT_BATCH_OUTPUT:
+			options->batch_output_file = optarg;
+			break;
+		case OPT_BATCH_TIME_LIMIT:
+			options->batch_time_limit = atof(optarg);
+			break;
+		case OPT_BATCH_MEMORY_LIMIT:
+			options->batch_memory_limit = atof(optarg);
+			break;
+		case OPT_PROFILE_TRACE:
+			options->profile_trace_file = optarg;
+			break;
+		case OPT_DD_TELEMETRY:
+			options->dd_telemetry_file = optarg;
 			break;
 		case OPT_MIP_TIME_LIMIT:
-			options.mip_time_limit = atof(optarg);
+			options->mip_time_limit = atof(optarg);
 			break;
 		case OPT_MIP_SEED:
-			options.mip_seed = atoi(optarg);
+			options->mip_seed = atoi(optarg);
 			break;
 		default:
 			exit(1);
 		}
 	}
 
-	// Check if input file is specified and exists
-	if (optind >= argc) {
-		cout << "Error: Input file not specified" << endl;
+	// Multiple subgradients require exact subproblem solves, while the coarse DD only solves them inexactly
+	if (options->lag_nsubgradients > 1 && options->lag_coarse_width > 0) {
+		cout << "Error: Cannot use both multiple subgradients and a coarse DD in the Lagrangian relaxation" << endl;
 		exit(1);
 	}
-	ifstream input(argv[optind]);
-	if (!input.good()) {
-		cout << "Error: Input file cannot be opened" << endl;
+
+	// The oracle over the DDs of the blocks only returns a single solution per subproblem
+	if (options->lag_nsubgradients > 1 && options->lag_decompose) {
+		cout << "Error: Cannot use both multiple subgradients and a decomposed DD in the Lagrangian relaxation" << endl;
 		exit(1);
 	}
 
-	// Identify problem through instance file extension
-	string instance_path = string(argv[optind]);
-	string instance_filename = instance_path.substr(instance_path.find_last_of("\\/") + 1);
-	string instance_extension = instance_filename.substr(instance_filename.find_last_of(".") + 1);
-	if (instance_extension == "mps") {
-#ifdef SOLVER_SCIP
-		BPModelScip model_builder(instance_path);
-		solve_ip(&model_builder, &options);
-#else
-		cout << "Error: Compilation was done without SCIP; cannot read MPS file" << endl;
-#endif
-	} else if (instance_extension == "clq") {
-		IndepSetInstance* inst = new IndepSetInstance();
-		inst->read_DIMACS(instance_path.c_str());
-		cout << "\n\n*** Independent set - " << instance_filename << " ***" << endl;
-#ifdef SOLVER_SCIP
-		IndepSetOptions indepset_options;
-		IndepSetModelScip model_builder(inst, &indepset_options);
-		options.max_rounds_root = 10;
-		solve_ip(&model_builder, &options);
-#else
-		cout << "Error: Compilation was done without SCIP; cannot run IP model" << endl;
-#endif
-		delete inst;
-	} else {
-		cout << "Error: Problem type (" << instance_extension << ") not identified" << endl;
+	return optind;
+}
+
+
+/** Run every instance of a batch manifest with every option set, on top of the command line options */
+void run_batch_manifest(const char* program, Options* options)
+{
+	vector<string> instances;
+	vector<BatchOptionSet> option_sets;
+	read_batch_manifest(options->batch_manifest_file.c_str(), instances, option_sets);
+	if (option_sets.empty()) {
+		option_sets.push_back({"default", vector<string>()});
+	}
+
+	vector<Options> set_options(option_sets.size(), *options);
+	for (int k = 0; k < (int) option_sets.size(); ++k) {
+		vector<char*> set_argv;
+		set_argv.push_back((char*) program);
+		for (string& arg : option_sets[k].args) {
+			set_argv.push_back(&arg[0]);
+		}
+		int set_argc = set_argv.size();
+		if (parse_options(set_argc, set_argv.data(), &set_options[k]) < set_argc) {
+			cout << "Error: Option set " << option_sets[k].name << " has an argument that is not an option" << endl;
+			exit(1);
+		}
+		// Profile and telemetry are shared by all jobs
+		if (set_options[k].profile_trace_file != options->profile_trace_file
+		        || set_options[k].dd_telemetry_file != options->dd_telemetry_file
+		        || set_options[k].batch_manifest_file != options->batch_manifest_file) {
+			cout << "Error: Option set " << option_sets[k].name << " sets output or batch options, which apply to the whole batch" << endl;
+			exit(1);
+		}
+	}
+
+	vector<BatchJob> jobs;
+	for (const string& instance_path : instances) {
+		for (int k = 0; k < (int) option_sets.size(); ++k) {
+			check_instance(instance_path, &set_options[k]);
+			BatchJob job;
+			job.instance_path = instance_path;
+			job.set_name = option_sets[k].name;
+			job.options = set_options[k];
+			jobs.push_back(job);
+		}
+	}
+
+	run_batch(jobs, options->batch_nthreads, options->batch_output_file.c_str());
+}
+
+
+int main(int argc, char* argv[])
+{
+
+	Options options;
+
+	if (argc < 2) {
+		print_usage(argv[0]);
+		exit(1);
+	}
+
+	int first_arg = parse_options(argc, argv, &options);
+
+	if (!options.profile_trace_file.empty()) {
+		profiler_enable(true);
+	}
+	if (!options.dd_telemetry_file.empty()) {
+		dd_telemetry = new DDTelemetrySink(options.dd_telemetry_file.c_str());
+		if (!dd_telemetry->is_open()) {
+			cout << "Error: Telemetry file cannot be opened" << endl;
+			exit(1);
+		}
+	}
+
+	if (!options.batch_manifest_file.empty()) {
+		if (first_arg < argc) {
+			cout << "Error: Input file cannot be given in batch mode" << endl;
+			exit(1);
+		}
+		run_batch_manifest(argv[0], &options);
+		finish_output(&options);
+		return 0;
+	}
+
+	// Check if input file is specified and exists
+	if (first_arg >= argc) {
+		cout << "Error: Input file not specified" << endl;
 		exit(1);
 	}
+	string instance_path = string(argv[first_arg]);
+	check_instance(instance_path, &options);
+
+	solve_instance(instance_path, &options);
+
+	finish_output(&options);
 
 	return 0;
 }
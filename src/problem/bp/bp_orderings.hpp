@@ -34,6 +34,7 @@ struct CuthillMcKeePairOrdering : Ordering {
 
 	CuthillMcKeePairOrdering(BPInstance* _inst) : inst(_inst)
 	{
+		sprintf(name, "cuthill_mckee_pair");
 		construct_ordering();
 	}
 
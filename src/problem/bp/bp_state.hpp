@@ -50,6 +50,11 @@ public:
 
 	std::ostream& stream_write(std::ostream& os) const;
 
+	size_t memory_size() const
+	{
+		return sizeof(BPState) + rhs.capacity() * sizeof(double) + domains.domains.capacity() * sizeof(BPDomainNode);
+	}
+
 	void print();
 
 	BPState& operator=(const BPState& rhs_state);
@@ -0,0 +1,38 @@
+/**
+ * Clique table functions for the standalone DD branch-and-bound
+ */
+
+#ifndef CLIQUETABLE_BB_HPP_
+#define CLIQUETABLE_BB_HPP_
+
+#include "cliquetable_problem.hpp"
+#include "cliquetable_completion.hpp"
+#include "../../core/bb_parallel.hpp"
+
+
+class CliqueTableBBProblemFactory : public BBProblemFactory
+{
+public:
+	CliqueTableInstance* inst;     /**< instance shared by all problems (read-only during DD construction) */
+
+	CliqueTableBBProblemFactory(CliqueTableInstance* _inst) : inst(_inst) {}
+
+	Problem* create_problem(Options* options, bool restricted)
+	{
+		CliqueTableProblem* problem = new CliqueTableProblem(inst, options);
+		if (restricted) {
+			delete problem->merger;
+			problem->merger = new MinLongestPathRestrictedMerger(options->width);
+		}
+		problem->completion = new CliqueTableDomainCompletionBound();
+		return problem;
+	}
+
+	State* copy_state(State* state)
+	{
+		return new CliqueTableState(*dynamic_cast<CliqueTableState*>(state));
+	}
+};
+
+
+#endif /* CLIQUETABLE_BB_HPP_ */
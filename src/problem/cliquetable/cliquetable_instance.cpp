@@ -18,7 +18,7 @@ CliqueTableInstance::CliqueTableInstance(SCIP* scip, bool include_ct_rows, bool
 	SCIP_CALL_ABORT(SCIPgetLPColsData(scip, &cols, &nvars));
 
 	vector<int> scipvar_to_ctvar(nvars);
-	for (int i = 0; i < nvars; ++nvars) {
+	for (int i = 0; i < nvars; ++i) {
 		scipvar_to_ctvar[i] = i; // Identity map
 	}
 
@@ -39,14 +39,14 @@ CliqueTableInstance::CliqueTableInstance(SCIP* scip, bool include_ct_rows, bool
 
 
 CliqueTableInstance::CliqueTableInstance(SCIP* scip, SCIP_COL** cols, int ncols, const vector<int>& scipvar_to_ctvar,
-        bool include_ct_rows, bool mask_transitive)
+        bool include_ct_rows, bool mask_transitive, bool global_rows_only)
 {
 	nvars = ncols;
 
 	init_adj(cols, scipvar_to_ctvar);
 	convert_clique_table(cols, scipvar_to_ctvar);
 	if (include_ct_rows) {
-		convert_clique_table_rows(scip, scipvar_to_ctvar);
+		convert_clique_table_rows(scip, scipvar_to_ctvar, global_rows_only);
 	}
 	update_nonnegated_only();
 
@@ -59,6 +59,101 @@ CliqueTableInstance::CliqueTableInstance(SCIP* scip, SCIP_COL** cols, int ncols,
 }
 
 
+CliqueTableInstance::CliqueTableInstance(Graph* graph, const double* graph_weights, bool mask_transitive)
+{
+	nvars = graph->n_vertices;
+
+	adj.resize(2 * nvars);
+	for (int c = 0; c < 2 * nvars; ++c) {
+		adj[c].resize(0, (2 * nvars)-1, false);
+	}
+
+	// Make the negated variable adjacent to the positive one and vice versa
+	for (int c = 0; c < nvars; ++c) {
+		adj[c].add(c + nvars);
+		adj[c+nvars].add(c);
+	}
+
+	// Edges of the graph are conflicts between nonnegated variables
+	for (int v = 0; v < nvars; ++v) {
+		for (int u : graph->neighbors(v)) {
+			assert(u != v);
+			adj[v].add(u);
+			adj[u].add(v);
+		}
+	}
+	update_nonnegated_only();
+	assert(nonnegated_only);
+
+	if (mask_transitive) {
+		create_complement_mask_with_transitivities();
+	} else {
+		create_complement_mask();
+	}
+
+	weights = new double[nvars];
+	for (int i = 0; i < nvars; ++i) {
+		weights[i] = graph_weights[i];
+	}
+}
+
+
+CliqueTableInstance::CliqueTableInstance(const CliqueTableInstance& full, const vector<int>& subvar_to_var)
+{
+	nvars = subvar_to_var.size();
+	int size = 2 * nvars;
+
+	// Vertex in the full instance corresponding to each vertex of the restriction
+	vector<int> sub_to_full(size);
+	for (int i = 0; i < nvars; ++i) {
+		assert(subvar_to_var[i] >= 0 && subvar_to_var[i] < full.nvars);
+		sub_to_full[i] = subvar_to_var[i];
+		sub_to_full[i + nvars] = subvar_to_var[i] + full.nvars;
+	}
+
+	// Adjacencies are sparse: iterate through the neighbors in the full instance
+	vector<int> full_to_sub(2 * full.nvars, -1);
+	for (int v = 0; v < size; ++v) {
+		full_to_sub[sub_to_full[v]] = v;
+	}
+
+	adj.resize(size);
+	for (int v = 0; v < size; ++v) {
+		adj[v].resize(0, size-1, false);
+		const IntSet& full_adj = full.adj[sub_to_full[v]];
+		for (int u = full_adj.get_first(); u != full_adj.get_end(); u = full_adj.get_next(u)) {
+			if (full_to_sub[u] >= 0) {
+				adj[v].add(full_to_sub[u]);
+			}
+		}
+	}
+	update_nonnegated_only();
+
+	// Complement masks are dense: start from all vertices and remove those missing from the full mask, which are
+	// found a word at a time in its complement
+	int mask_size = nonnegated_only ? nvars : size;
+	assert(nonnegated_only || !full.nonnegated_only); // full masks then cover all vertices of the restricted masks
+	boost::dynamic_bitset<> missing;
+	adj_mask_compl.resize(size);
+	for (int v = 0; v < size; ++v) {
+		adj_mask_compl[v].resize(0, mask_size-1, true);
+		missing = full.adj_mask_compl[sub_to_full[v]].set;
+		missing.flip();
+		for (size_t full_u = missing.find_first(); full_u != missing.npos; full_u = missing.find_next(full_u)) {
+			int u = full_to_sub[full_u];
+			if (u >= 0 && u < mask_size) {
+				adj_mask_compl[v].remove(u);
+			}
+		}
+	}
+
+	weights = new double[nvars];
+	for (int i = 0; i < nvars; ++i) {
+		weights[i] = full.weights[subvar_to_var[i]];
+	}
+}
+
+
 void CliqueTableInstance::init_adj(SCIP_COL** cols, const vector<int>& scipvar_to_ctvar)
 {
 	adj.resize(2 * nvars);
@@ -146,7 +241,7 @@ void CliqueTableInstance::convert_clique_table(SCIP_COL** cols, const vector<int
 }
 
 
-void CliqueTableInstance::convert_clique_table_rows(SCIP* scip, const vector<int>& scipvar_to_ctvar)
+void CliqueTableInstance::convert_clique_table_rows(SCIP* scip, const vector<int>& scipvar_to_ctvar, bool global_rows_only)
 {
 	SCIP_ROW** rows;
 	int nrows;
@@ -155,6 +250,9 @@ void CliqueTableInstance::convert_clique_table_rows(SCIP* scip, const vector<int
 
 	for (int i = 0; i < nrows; ++i) {
 		SCIP_ROW* row = rows[i];
+		if (global_rows_only && SCIProwIsLocal(row)) {
+			continue;
+		}
 		bool lhs_ctform;
 		bool rhs_ctform;
 		is_row_clique_table_form(scip, row, &lhs_ctform, &rhs_ctform);
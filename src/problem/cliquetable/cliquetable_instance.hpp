@@ -34,9 +34,25 @@ public:
 	/** Create a clique table instance for the full space of variables */
 	CliqueTableInstance(SCIP* scip, bool include_ct_rows=false, bool mask_transitive=true);
 
-	/** Create a clique table instance for the given space of variables */
+	/**
+	 * Create a clique table instance for the given space of variables. If global_rows_only, rows that are only valid
+	 * locally are not added, e.g. if the instance is reused at other nodes.
+	 */
 	CliqueTableInstance(SCIP* scip, SCIP_COL** cols, int ncols, const vector<int>& var_to_subvar, bool include_ct_rows=false,
-	                    bool mask_transitive=true);
+	                    bool mask_transitive=true, bool global_rows_only=false);
+
+	/**
+	 * Create a clique table instance from a conflict graph, without SCIP (e.g. for independent set instances).
+	 * Only nonnegated nodes are used; weights are copied.
+	 */
+	CliqueTableInstance(Graph* graph, const double* graph_weights, bool mask_transitive=true);
+
+	/**
+	 * Create the restriction of an instance to a subspace of its variables, relabeled to 0..n-1 by position in
+	 * subvar_to_var. Adjacencies and complement masks are copied instead of recomputed; transitive masks may thus also
+	 * contain implications through variables outside the subspace, which remain valid.
+	 */
+	CliqueTableInstance(const CliqueTableInstance& full, const vector<int>& subvar_to_var);
 
 	~CliqueTableInstance()
 	{
@@ -47,7 +63,7 @@ public:
 	void convert_clique_table(SCIP_COL** cols, const vector<int>& var_to_subvar);
 
 	/** Add edges from rows that have the clique table format, even if not present in clique table */
-	void convert_clique_table_rows(SCIP* scip, const vector<int>& scipvar_to_ctvar);
+	void convert_clique_table_rows(SCIP* scip, const vector<int>& scipvar_to_ctvar, bool global_rows_only=false);
 
 	/** Copy weights from SCIP */
 	void extract_weights(SCIP* scip, SCIP_COL** cols, const vector<int>& var_to_subvar);
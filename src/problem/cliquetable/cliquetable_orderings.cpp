@@ -8,10 +8,37 @@
 
 #include "cliquetable_orderings.hpp"
 #include "cliquetable_scc.hpp"
+#include "../../core/orderings.hpp"
 
 using namespace std;
 
 
+Ordering* get_ordering_by_id_ct(int id, CliqueTableInstance* inst, Options& options)
+{
+	if (id < 0) {
+		id = DEFAULT_CT_ORDERING;
+	}
+	// Read ordering type
+	switch (id) {
+	case 0:
+		return new MinInStateCliqueTableOrdering(inst);
+	case 1:
+		return new RandomOrdering(inst);
+	case 2:
+		return new MinDegreeCliqueTableOrdering(inst);
+	case 3:
+		if (options.fixed_order_filename.empty()) {
+			cout << "Error: text file required for ordering\n\n";
+			exit(1);
+		}
+		return new FixedOrdering(inst, options.fixed_order_filename);
+	case 4:
+		return new NoOrdering();
+	}
+	return NULL;
+}
+
+
 // minimum degree ordering
 void MinDegreeCliqueTableOrdering::construct_ordering()
 {
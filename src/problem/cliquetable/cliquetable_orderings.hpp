@@ -13,10 +13,17 @@
 #include "../../core/order.hpp"
 #include "cliquetable_instance.hpp"
 #include "cliquetable_state.hpp"
+#include "../../util/options.hpp"
+
+#define DEFAULT_CT_ORDERING 0
 
 using namespace std;
 
 
+/** Return an ordering for a clique table problem given an id */
+Ordering* get_ordering_by_id_ct(int id, CliqueTableInstance* inst, Options& options);
+
+
 // Minimum degree ordering for clique table
 struct MinDegreeCliqueTableOrdering : Ordering {
 
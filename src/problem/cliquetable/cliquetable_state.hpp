@@ -28,6 +28,11 @@ public:
 		return intset.equals_to(rhsi->intset);
 	}
 
+	size_t memory_size() const
+	{
+		return sizeof(CliqueTableState) + intset.set.num_blocks() * sizeof(boost::dynamic_bitset<>::block_type);
+	}
+
 	bool less(const State& rhs) const
 	{
 		const CliqueTableState& rhsi = dynamic_cast<const CliqueTableState&>(rhs);
@@ -19,11 +19,12 @@ void CliqueTablePropLinearcons::update_layer_end(int current_ddvar)
 		}
 	}
 	processed_ddvars[current_ddvar] = true;
+	nprocessed_ddvars++;
 }
 
 
-bool CliqueTablePropLinearcons::propagate(CliqueTableState* state, int bpvar, vector<double>& minactivity, vector<double>& maxactivity,
-        vector<double>& rhs)
+bool CliqueTablePropLinearcons::propagate(CliqueTableState* state, int bpvar, const vector<double>& mindelta,
+        const vector<double>& maxdelta, vector<double>& rhs, vector<int>& fixed_ddvars)
 {
 	// Gather all unfixed variables sharing a constraint with bpvar in order to avoid revisiting variables
 	assert(fixed_vars.empty() || fixed_vars[bpvar] == DD_UNFIXED_VAR);
@@ -43,6 +44,7 @@ bool CliqueTablePropLinearcons::propagate(CliqueTableState* state, int bpvar, ve
 
 		BPVar* var = vars[bpvar_u];
 		int nrows_var = var->rows.size();
+		bool fixed = false;
 
 		for (int i = 0; i < nrows_var; ++i) {
 			int row_idx = var->rows[i];
@@ -50,7 +52,8 @@ bool CliqueTablePropLinearcons::propagate(CliqueTableState* state, int bpvar, ve
 
 			// Try to reduce domain
 			BPDomain domain = get_smallest_domain(coeff, rows[row_idx]->sense, rhs[row_idx],
-			                                      minactivity[row_idx], maxactivity[row_idx]);
+			                                      minactivity_global[row_idx] + mindelta[row_idx],
+			                                      maxactivity_global[row_idx] + maxdelta[row_idx]);
 
 			if (domain != DOM_ZERO_ONE) {
 				assert(domain == 0 || domain == 1);
@@ -60,9 +63,14 @@ bool CliqueTablePropLinearcons::propagate(CliqueTableState* state, int bpvar, ve
 					// cout << "Infeasible from propagation" << endl;
 					return true; // infeasible
 				}
+				fixed = true;
 				// One pass of propagation; could continue updating everything else here but we do not
 			}
 		}
+
+		if (fixed) {
+			fixed_ddvars.push_back(ddvar_u);
+		}
 	}
 
 	return false; // feasible
@@ -130,31 +138,37 @@ void CliqueTablePropLinearcons::update_activity_from_domain(CliqueTableState* st
 		}
 		assert(fixed_vars.empty() || fixed_vars[ddvar_to_bpvar[ddvar]] == DD_UNFIXED_VAR); // if fixed, should fail test above
 
-		BPDomain dom = state->get_domain(inst, ddvar);
-
-		if (dom == DOM_ZERO || dom == DOM_ONE) {
-			BPVar* var = vars[ddvar_to_bpvar[ddvar]];
-			int nrows = var->rows.size();
-			for (int j = 0; j < nrows; ++j) {
-				int cons = var->rows[j];
-				double coeff = var->row_coeffs[j];
-
-				if (coeff < 0) {
-					if (dom == DOM_ONE) {
-						maxactivity[cons] += coeff;
-					} else {
-						assert(dom == DOM_ZERO);
-						minactivity[cons] -= coeff;
-					}
-				} else {
-					if (dom == DOM_ONE) {
-						minactivity[cons] += coeff;
-					} else {
-						assert(dom == DOM_ZERO);
-						maxactivity[cons] -= coeff;
-					}
-				}
+		update_activity_from_var_domain(ddvar, state->get_domain(inst, ddvar), minactivity, maxactivity);
+	}
+}
+
+
+void CliqueTablePropLinearcons::update_activity_from_var_domain(int ddvar, BPDomain domain, vector<double>& minactivity,
+        vector<double>& maxactivity, double sign /*= 1.0*/)
+{
+	if (domain != DOM_ZERO && domain != DOM_ONE) {
+		return;
+	}
 
+	BPVar* var = vars[ddvar_to_bpvar[ddvar]];
+	int nrows = var->rows.size();
+	for (int j = 0; j < nrows; ++j) {
+		int cons = var->rows[j];
+		double coeff = sign * var->row_coeffs[j];
+
+		if (var->row_coeffs[j] < 0) {
+			if (domain == DOM_ONE) {
+				maxactivity[cons] += coeff;
+			} else {
+				assert(domain == DOM_ZERO);
+				minactivity[cons] -= coeff;
+			}
+		} else {
+			if (domain == DOM_ONE) {
+				minactivity[cons] += coeff;
+			} else {
+				assert(domain == DOM_ZERO);
+				maxactivity[cons] -= coeff;
 			}
 		}
 	}
@@ -163,10 +177,13 @@ void CliqueTablePropLinearcons::update_activity_from_domain(CliqueTableState* st
 
 // CliqueTablePropLinearconsData
 
-CliqueTablePropLinearconsData::CliqueTablePropLinearconsData(CliqueTablePropLinearcons* _prop) : prop(_prop)
+CliqueTablePropLinearconsData::CliqueTablePropLinearconsData(CliqueTablePropLinearcons* _prop) :
+	prop(_prop), synced_state(NULL), synced_nprocessed(-1)
 {
 	int nrows = prop->rows.size();
 	rhs.resize(nrows, 0.0);
+	mindelta.resize(nrows, 0.0);
+	maxdelta.resize(nrows, 0.0);
 	for (int i = 0; i < nrows; ++i) {
 		rhs[i] = prop->rows[i]->rhs;
 	}
@@ -190,6 +207,10 @@ CliqueTablePropLinearconsData::CliqueTablePropLinearconsData(const CliqueTablePr
 {
 	prop = data.prop;
 	rhs = data.rhs;
+	mindelta = data.mindelta;
+	maxdelta = data.maxdelta;
+	synced_state = data.synced_state;
+	synced_nprocessed = data.synced_nprocessed;
 	infeasible = data.infeasible;
 }
 
@@ -213,12 +234,20 @@ void CliqueTablePropLinearconsData::transition_in_place(Problem* prob, Node* nod
 		return;
 	}
 
-	// Copy minactivity and maxactivity from global
-	vector<double> minactivity = prop->minactivity_global;
-	vector<double> maxactivity = prop->maxactivity_global;
-
 	assert(prop->processed_ddvars[ddvar] == false);
-	prop->update_activity_from_domain(state, minactivity, maxactivity, ddvar);
+
+	// Bring deltas to the new state, excluding ddvar; they are recomputed from the state only if they are not valid for
+	// the parent state at this layer
+	if (node != NULL && synced_nprocessed == prop->nprocessed_ddvars) {
+		assert(synced_state == node->state);
+		update_deltas_from_transition(dynamic_cast<CliqueTableState*>(node->state), state, ddvar);
+	} else {
+		fill(mindelta.begin(), mindelta.end(), 0.0);
+		fill(maxdelta.begin(), maxdelta.end(), 0.0);
+		prop->update_activity_from_domain(state, mindelta, maxdelta, ddvar);
+	}
+	synced_state = new_state;
+	synced_nprocessed = prop->nprocessed_ddvars + 1; // ddvar is processed at the end of this layer
 
 	assert(val == 0 || val == 1);
 	BPDomain domain = (val == 0) ? DOM_ZERO : DOM_ONE;
@@ -230,20 +259,11 @@ void CliqueTablePropLinearconsData::transition_in_place(Problem* prob, Node* nod
 		int cons = vars[bpvar]->rows[i];
 		double coeff = vars[bpvar]->row_coeffs[i];
 
-		// // Debugging info
-		// cout << "Row " << cons << ": [" << minactivity[cons] << ", " << maxactivity[cons] << "] ";
-		// if (rows[cons]->sense == SENSE_GE) {
-		//     cout << " >= ";
-		// } else {
-		//     cout << " <= ";
-		// }
-		// cout << rhs[cons] << endl;
-
-		// Update minactivity/maxactivity
+		// Update minactivity/maxactivity; this is undone below since the global ones are updated at the end of the layer
 		if (coeff < 0) {
-			minactivity[cons] -= coeff;
+			mindelta[cons] -= coeff;
 		} else {
-			maxactivity[cons] -= coeff;
+			maxdelta[cons] -= coeff;
 		}
 
 		// Update rhs
@@ -251,8 +271,11 @@ void CliqueTablePropLinearconsData::transition_in_place(Problem* prob, Node* nod
 			rhs[cons] -= coeff;
 		}
 
+		double minactivity = prop->minactivity_global[cons] + mindelta[cons];
+		double maxactivity = prop->maxactivity_global[cons] + maxdelta[cons];
+
 		// // Debugging info
-		// cout << " to " << cons << ": [" << minactivity[cons] << ", " << maxactivity[cons] << "] ";
+		// cout << "Row " << cons << ": [" << minactivity << ", " << maxactivity << "] ";
 		// if (rows[cons]->sense == SENSE_GE) {
 		//     cout << " >= ";
 		// } else {
@@ -262,31 +285,75 @@ void CliqueTablePropLinearconsData::transition_in_place(Problem* prob, Node* nod
 
 		// Check for infeasibility
 		if (rows[cons]->sense == SENSE_GE) {
-			if (DBL_LT(maxactivity[cons], rhs[cons])) {
-				// cout << "Infeasible: " << maxactivity[cons] << " < " << rhs[cons] << endl;
+			if (DBL_LT(maxactivity, rhs[cons])) {
+				// cout << "Infeasible: " << maxactivity << " < " << rhs[cons] << endl;
 				infeasible = true;
 				return;
 			}
-			// if (DBL_GE(prop->minactivity_global[cons], rhs[cons])) {
-			//     rhs[cons] = prop->minactivity_global[cons];
-			// }
 		} else { // rows[cons]->sense == SENSE_LE
-			if (DBL_GT(minactivity[cons], rhs[cons])) {
-				// cout << "Infeasible: " << minactivity[cons] << " > " << rhs[cons] << endl;
+			if (DBL_GT(minactivity, rhs[cons])) {
+				// cout << "Infeasible: " << minactivity << " > " << rhs[cons] << endl;
 				infeasible = true;
 				return;
 			}
-			// if (DBL_LE(prop->maxactivity_global[cons], rhs[cons])) {
-			//     rhs[cons] = prop->maxactivity_global[cons];
-			// }
 		}
 	}
 
 	// Run one pass of propagation
 	assert(!infeasible);
-	infeasible = prop->propagate(state, bpvar, minactivity, maxactivity, rhs);
+	vector<int> fixed_ddvars;
+	infeasible = prop->propagate(state, bpvar, mindelta, maxdelta, rhs, fixed_ddvars);
+	if (infeasible) {
+		return;
+	}
+
+	for (int i = 0; i < nrows; ++i) {
+		int cons = vars[bpvar]->rows[i];
+		double coeff = vars[bpvar]->row_coeffs[i];
+		if (coeff < 0) {
+			mindelta[cons] += coeff;
+		} else {
+			maxdelta[cons] += coeff;
+		}
+	}
+
+	// Account for the variables fixed by propagation
+	for (int ddvar_u : fixed_ddvars) {
+		prop->update_activity_from_var_domain(ddvar_u, state->get_domain(prop->inst, ddvar_u), mindelta, maxdelta);
+	}
+}
+
+
+void CliqueTablePropLinearconsData::update_deltas_from_transition(CliqueTableState* parent_state, CliqueTableState* state,
+        int ddvar)
+{
+	CliqueTableInstance* inst = prop->inst;
+	int nvars = inst->nvars;
+
+	// Variable of the transition is no longer counted
+	prop->update_activity_from_var_domain(ddvar, parent_state->get_domain(inst, ddvar), mindelta, maxdelta, -1.0);
+
+	// Transitions only remove elements from the state, so the domains that changed are those of the removed elements
+	boost::dynamic_bitset<> removed = parent_state->intset.set - state->intset.set;
+	removed.reset(ddvar);
+	if (!inst->nonnegated_only) {
+		removed.reset(ddvar + nvars);
+	}
+
+	for (size_t i = removed.find_first(); i != boost::dynamic_bitset<>::npos; i = removed.find_next(i)) {
+		int var = i % nvars;
+		if ((int) i >= nvars && removed.test(var)) {
+			continue; // both elements of the variable were removed; already handled with the nonnegated one
+		}
+		if (prop->processed_ddvars[var]) {
+			continue;
+		}
+		prop->update_activity_from_var_domain(var, parent_state->get_domain(inst, var), mindelta, maxdelta, -1.0);
+		prop->update_activity_from_var_domain(var, state->get_domain(inst, var), mindelta, maxdelta);
+	}
 }
 
+
 void CliqueTablePropLinearconsData::merge(Problem* prob, NodeData* data, State* state)
 {
 	CliqueTablePropLinearconsData* ctdata = dynamic_cast<CliqueTablePropLinearconsData*>(data);
@@ -298,5 +365,14 @@ void CliqueTablePropLinearconsData::merge(Problem* prob, NodeData* data, State*
 			rhs[i] = ctdata->rhs[i];
 		}
 	}
-}
 
+	// Deltas are those of the other data if the merged state is its state (in particular, for equivalent states);
+	// otherwise, the merged state has fewer fixed variables and deltas are recomputed at the next transition
+	if (state != NULL && synced_state != NULL && synced_state->equals_to(state)) {
+		mindelta = ctdata->mindelta;
+		maxdelta = ctdata->maxdelta;
+		synced_nprocessed = ctdata->synced_nprocessed;
+	} else {
+		synced_nprocessed = -1;
+	}
+}
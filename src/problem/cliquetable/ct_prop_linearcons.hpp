@@ -26,6 +26,7 @@ public:
 	vector<double> maxactivity_global;    /**< maxactivity updated at each layer */
 	vector<bool> processed_ddvars;        /**< marker for variables already processed by DD (in subspace); equivalent to those
                                             *  with domain DOM_PROCESSED when instance is not using nonnegated_only */
+	int nprocessed_ddvars;                /**< number of variables already processed by DD; identifies the current layer */
 
 	// Structures used if working on a restricted subspace
 	const vector<int>& bpvar_to_ddvar;   /**< mapping from index from vars (BPVar) to index from DD (subspace) */
@@ -38,7 +39,7 @@ public:
 
 	CliqueTablePropLinearcons(CliqueTableInstance* _inst, vector<BPVar*>& _vars, vector<BPRow*>& _rows,
 	                          const vector<int>& _bpvar_to_ddvar, const vector<int>& _ddvar_to_bpvar, const vector<int>& _fixed_vars) :
-		inst(_inst), vars(_vars), rows(_rows), processed_ddvars(_ddvar_to_bpvar.size(), false),
+		inst(_inst), vars(_vars), rows(_rows), processed_ddvars(_ddvar_to_bpvar.size(), false), nprocessed_ddvars(0),
 		bpvar_to_ddvar(_bpvar_to_ddvar), ddvar_to_bpvar(_ddvar_to_bpvar), fixed_vars(_fixed_vars)
 	{
 		int nrows = rows.size();
@@ -65,14 +66,22 @@ public:
 	CliqueTablePropLinearcons(CliqueTableInstance* _inst, vector<BPVar*>& _vars, vector<BPRow*>& _rows) :
 		CliqueTablePropLinearcons(_inst, _vars, _rows, full_mapping(rows.size()), full_mapping(rows.size()), {}) {}
 
-	bool propagate(CliqueTableState* state, int bpvar, vector<double>& minactivity, vector<double>& maxactivity,
-	               vector<double>& rhs);
+	/**
+	 * Run one pass of propagation on the neighbors of bpvar. Activities of a node are minactivity_global + mindelta and
+	 * maxactivity_global + maxdelta. Variables whose domain is reduced are added to fixed_ddvars. Return true if infeasible.
+	 */
+	bool propagate(CliqueTableState* state, int bpvar, const vector<double>& mindelta, const vector<double>& maxdelta,
+	               vector<double>& rhs, vector<int>& fixed_ddvars);
 
 	void update_layer_end(int current_ddvar);
 
 	void update_activity_from_domain(CliqueTableState* state, vector<double>& minactivity, vector<double>& maxactivity,
 	                                 int ddvar_to_skip);
 
+	/** Add sign times the change in activities caused by fixing ddvar to domain (zero unless DOM_ZERO or DOM_ONE) */
+	void update_activity_from_var_domain(int ddvar, BPDomain domain, vector<double>& minactivity,
+	                                     vector<double>& maxactivity, double sign = 1.0);
+
 private:
 	/** Return all variables participating in the constraints bpvar is in. */
 	unordered_set<int> create_neighbor_set(int bpvar);
@@ -94,11 +103,21 @@ private:
 };
 
 
+/**
+ * Node data for propagation of linear constraints. Besides the right-hand sides, it keeps the change in activities caused
+ * by the variables fixed in the state of the node, so that a transition only updates the rows affected by the variables
+ * whose domain changes instead of rescanning the state.
+ */
 class CliqueTablePropLinearconsData : public NodeData
 {
 public:
 	CliqueTablePropLinearcons* prop;
 	vector<double> rhs;
+	vector<double> mindelta;              /**< minactivity of the node minus minactivity_global */
+	vector<double> maxdelta;              /**< maxactivity of the node minus maxactivity_global */
+	State* synced_state;                  /**< state of the node, for which deltas were computed */
+	int synced_nprocessed;                /**< number of processed variables the deltas are valid for; -1 if they must be
+	                                        *  recomputed from the state (root, long arcs and merges of different states) */
 
 	/** Constructor for initial data */
 	CliqueTablePropLinearconsData(CliqueTablePropLinearcons* _prop);
@@ -114,6 +133,16 @@ public:
 	/** Merge with another data */
 	void merge(Problem* prob, NodeData* rhs, State* state);
 
+	size_t memory_size() const
+	{
+		return sizeof(CliqueTablePropLinearconsData)
+		       + (rhs.capacity() + mindelta.capacity() + maxdelta.capacity()) * sizeof(double);
+	}
+
+private:
+	/** Update deltas with the domain changes of the other variables from the parent state to the new state */
+	void update_deltas_from_transition(CliqueTableState* parent_state, CliqueTableState* state, int ddvar);
+
 };
 
 
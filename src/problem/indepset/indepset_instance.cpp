@@ -2,11 +2,19 @@
  * Independent set instance
  */
 
+#include <cstdint>
+#include <cstdio>
 #include <cstdlib>
+#include <functional>
 #include <iostream>
+#include <string>
+#include <thread>
 #include <vector>
+#include <sys/stat.h>
+#include <unistd.h>
 
 #include "indepset_instance.hpp"
+#include "../../util/mapped_file.hpp"
 
 using namespace std;
 
@@ -37,10 +45,8 @@ void IndepSetInstance::create_from_graph(Graph* orig_graph, const vector<double>
 	for (int v = 0; v < graph->n_vertices; v++) {
 
 		adj_mask_compl[v].resize(0, graph->n_vertices-1, true);
-		for (int w = 0; w < graph->n_vertices; w++) {
-			if (graph->is_adj(v,w)) {
-				adj_mask_compl[v].remove(w);
-			}
+		for (int w : graph->neighbors(v)) {
+			adj_mask_compl[v].remove(w);
 		}
 
 		// a vertex is adjacent to itself
@@ -50,14 +56,183 @@ void IndepSetInstance::create_from_graph(Graph* orig_graph, const vector<double>
 }
 
 
+/**
+ * Binary instance cache: header, followed by the edges (i < j) as pairs of 32-bit vertex indices and, if there is a
+ * weights file, one double per vertex. The header records the size and modification time of the source files so that a
+ * cache is only reused while its sources are unchanged.
+ */
+struct IndepSetCacheHeader {
+	char     magic[8];
+	uint32_t version;
+	uint32_t has_weights;
+	int64_t  graph_size;
+	int64_t  graph_mtime;
+	int64_t  weights_size;
+	int64_t  weights_mtime;
+	int64_t  n_vertices;
+	int64_t  n_edges;
+};
+
+static const char INDEPSET_CACHE_MAGIC[8] = {'D', 'D', 'O', 'P', 'T', 'C', 'L', 'Q'};
+static const uint32_t INDEPSET_CACHE_VERSION = 1;
+
+
+/** Fill in the source file fields of a cache header; return false if a source file cannot be accessed */
+static bool set_cache_sources(IndepSetCacheHeader& header, const char* filename, const char* weights_file)
+{
+	memset(&header, 0, sizeof(header));
+	memcpy(header.magic, INDEPSET_CACHE_MAGIC, sizeof(header.magic));
+	header.version = INDEPSET_CACHE_VERSION;
+
+	struct stat file_stat;
+	if (stat(filename, &file_stat) != 0) {
+		return false;
+	}
+	header.graph_size = file_stat.st_size;
+	header.graph_mtime = file_stat.st_mtime;
+
+	if (weights_file != NULL) {
+		if (stat(weights_file, &file_stat) != 0) {
+			return false;
+		}
+		header.has_weights = 1;
+		header.weights_size = file_stat.st_size;
+		header.weights_mtime = file_stat.st_mtime;
+	}
+	return true;
+}
+
+
+/** Read the graph and weights from a cache file if it matches the sources in expected; return false otherwise */
+static bool read_cache(const string& cache_file, const IndepSetCacheHeader& expected, Graph*& graph,
+                       vector<double>& obj)
+{
+	MappedFile input(cache_file.c_str());
+	if (!input.is_open() || input.size() < sizeof(IndepSetCacheHeader)) {
+		return false;
+	}
+
+	IndepSetCacheHeader header;
+	memcpy(&header, input.begin(), sizeof(header));
+	if (memcmp(header.magic, expected.magic, sizeof(header.magic)) != 0 || header.version != expected.version
+	        || header.has_weights != expected.has_weights || header.graph_size != expected.graph_size
+	        || header.graph_mtime != expected.graph_mtime || header.weights_size != expected.weights_size
+	        || header.weights_mtime != expected.weights_mtime || header.n_vertices < 0 || header.n_edges < 0) {
+		return false;
+	}
+
+	size_t nweights = header.has_weights ? header.n_vertices : 0;
+	size_t expected_size = sizeof(header) + 2 * sizeof(uint32_t) * header.n_edges + sizeof(double) * nweights;
+	if (input.size() != expected_size) {
+		return false;
+	}
+
+	const char* pos = input.begin() + sizeof(header);
+	graph = new Graph(header.n_vertices);
+	for (int64_t e = 0; e < header.n_edges; ++e) {
+		uint32_t edge[2];
+		memcpy(edge, pos, sizeof(edge));
+		pos += sizeof(edge);
+		if (edge[0] >= header.n_vertices || edge[1] >= header.n_vertices || edge[0] == edge[1]) {
+			delete graph;
+			graph = NULL;
+			return false;
+		}
+		graph->add_edge(edge[0], edge[1]);
+	}
+
+	obj.resize(nweights);
+	if (nweights > 0) {
+		memcpy(obj.data(), pos, sizeof(double) * nweights);
+	}
+	return true;
+}
+
+
+/** Write the graph and weights to a cache file; failures are reported but not fatal */
+static void write_cache(const string& cache_file, IndepSetCacheHeader header, Graph* graph, const double* weights)
+{
+	header.n_vertices = graph->n_vertices;
+	header.n_edges = graph->n_edges;
+
+	// Write to a temporary file and rename it so that concurrent runs never see a partial cache; runs may be threads of
+	// the same process in batch mode
+	string tmp_file = cache_file + ".tmp." + to_string(getpid()) + "." + to_string(hash<thread::id>()(this_thread::get_id()));
+	FILE* output = fopen(tmp_file.c_str(), "wb");
+	if (output == NULL) {
+		cout << "\tcould not write instance cache " << cache_file << endl;
+		return;
+	}
+
+	bool ok = (fwrite(&header, sizeof(header), 1, output) == 1);
+	for (int i = 0; ok && i < graph->n_vertices; ++i) {
+		for (int j : graph->neighbors(i)) {
+			if (j > i) {
+				uint32_t edge[2] = {(uint32_t) i, (uint32_t) j};
+				ok = ok && (fwrite(edge, sizeof(edge), 1, output) == 1);
+			}
+		}
+	}
+	if (ok && header.has_weights) {
+		ok = (fwrite(weights, sizeof(double), graph->n_vertices, output) == (size_t) graph->n_vertices);
+	}
+	ok = (fclose(output) == 0) && ok;
+
+	if (!ok || rename(tmp_file.c_str(), cache_file.c_str()) != 0) {
+		remove(tmp_file.c_str());
+		cout << "\tcould not write instance cache " << cache_file << endl;
+	}
+}
+
+
+/** Read weights, one per vertex, from a text file */
+static void read_weights(const char* weights_file, int n_vertices, double* weights)
+{
+	MappedFile input(weights_file);
+	if (!input.is_open()) {
+		cout << "Error: could not open weights file " << weights_file << endl;
+		exit(1);
+	}
+
+	TextScanner scanner(input.begin(), input.end());
+	for (int i = 0; i < n_vertices; i++) {
+		if (!scanner.read_double(weights[i])) {
+			cout << "Error: weights file " << weights_file << " has fewer than " << n_vertices
+			     << " valid weights" << endl;
+			exit(1);
+		}
+	}
+}
+
+
 /**
  * Read DIMACS independent set instance with optional weights file
  */
-void IndepSetInstance::read_DIMACS(const char* filename, const char* weights_file)
+void IndepSetInstance::read_DIMACS(const char* filename, const char* weights_file, bool use_cache)
 {
 
 	cout << "Reading instance " << filename << endl;
 
+	string cache_file = string(filename) + ".cache";
+	IndepSetCacheHeader cache_header;
+	bool cache_valid = use_cache && set_cache_sources(cache_header, filename, weights_file);
+
+	// Read graph and weights from cache if available
+	vector<double> cached_obj;
+	Graph* cached_graph = NULL;
+	if (cache_valid && read_cache(cache_file, cache_header, cached_graph, cached_obj)) {
+		cout << "\tread from cache " << cache_file << endl;
+		cout << "\tnumber of vertices: " << cached_graph->n_vertices << endl;
+		cout << "\tnumber of edges: " << cached_graph->n_edges << endl;
+		if (weights_file != NULL) {
+			create_from_graph(cached_graph, cached_obj);
+		} else {
+			create_from_graph(cached_graph);
+		}
+		cout << "\tdone." << endl;
+		return;
+	}
+
 	// Read graph
 	graph = new Graph;
 	graph->read_dimacs(filename);
@@ -69,11 +244,11 @@ void IndepSetInstance::read_DIMACS(const char* filename, const char* weights_fil
 
 	// Assign weights
 	if (weights_file != NULL) {
-		ifstream weightsfile(weights_file);
-		for (int i = 0; i < graph->n_vertices; i++) {
-			weightsfile >> weights[i];
-		}
-		weightsfile.close();
+		read_weights(weights_file, graph->n_vertices, weights);
+	}
+
+	if (cache_valid) {
+		write_cache(cache_file, cache_header, graph, weights);
 	}
 
 	cout << "\tdone." << endl;
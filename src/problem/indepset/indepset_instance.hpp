@@ -40,8 +40,12 @@ public:
 	/** Create independent set instance with weights from obj */
 	void create_from_graph(Graph* orig_graph, const vector<double>& obj);
 
-	/** Read DIMACS independent set instance with optional weights file */
-	void read_DIMACS(const char* filename, const char* weights_file = NULL);
+	/**
+	 * Read DIMACS independent set instance with optional weights file. If use_cache is set, the instance is read from
+	 * a binary cache next to the instance file (filename.cache) when one matches the source files, and the cache is
+	 * written otherwise.
+	 */
+	void read_DIMACS(const char* filename, const char* weights_file = NULL, bool use_cache = false);
 };
 
 
@@ -74,8 +74,8 @@ SCIP_RETCODE add_edge_constraints(
 	/* edge constraints */
 	SCIP_CALL(SCIPallocBufferArray(scip, &consvars, 2));
 	for (int i = 0; i < graph->n_vertices; ++i) {
-		for (int j = i+1; j < graph->n_vertices; ++j) {
-			if (graph->is_adj(i, j)) {
+		for (int j : graph->neighbors(i)) {
+			if (j > i) {
 				consvars[0] = vars[i];
 				consvars[1] = vars[j];
 				(void) SCIPsnprintf(consname, SCIP_MAXSTRLEN, "e%d_%d", i, j);
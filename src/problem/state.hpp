@@ -31,6 +31,12 @@ public:
 	/** Function for printing the state */
 	virtual std::ostream& stream_write(std::ostream& os) const = 0;
 
+	/** Approximate number of bytes held by the state, including its dynamically allocated members */
+	virtual size_t memory_size() const
+	{
+		return sizeof(State);
+	}
+
 
 	/* Operators */
 	friend bool operator<(const State& lhs, const State& rhs);
@@ -0,0 +1,86 @@
+/**
+ * Event counters for hot paths of DD construction and Lagrangian relaxation, compiled in with USE_EVENT_COUNTERS
+ */
+
+#include <mutex>
+#include <vector>
+#include "event_counters.hpp"
+
+
+static const char* event_counter_names[NUM_EVENT_COUNTERS] = {
+	"node_lookups",
+	"node_equivalent",
+	"transitions",
+	"transitions_infeasible",
+	"node_data_infeasible",
+	"node_merges",
+	"long_arc_skips",
+	"lag_iterations",
+	"lag_evaluations",
+	"lag_oracle_calls"
+};
+
+
+const char* event_counter_name(EventCounter event)
+{
+	return event_counter_names[event];
+}
+
+
+#ifdef USE_EVENT_COUNTERS
+
+static mutex                       blocks_lock;
+static vector<EventCounterBlock*>  blocks;      /**< counters of all threads that counted events; never freed */
+
+thread_local EventCounterBlock* event_counter_block = NULL;
+
+
+EventCounterBlock* event_counter_block_register()
+{
+	event_counter_block = new EventCounterBlock();
+	for (int i = 0; i < NUM_EVENT_COUNTERS; ++i) {
+		event_counter_block->counts[i].store(0, memory_order_relaxed);
+	}
+	lock_guard<mutex> guard(blocks_lock);
+	blocks.push_back(event_counter_block);
+	return event_counter_block;
+}
+
+
+void event_counters_collect(long long totals[NUM_EVENT_COUNTERS])
+{
+	for (int i = 0; i < NUM_EVENT_COUNTERS; ++i) {
+		totals[i] = 0;
+	}
+	lock_guard<mutex> guard(blocks_lock);
+	for (EventCounterBlock* block : blocks) {
+		for (int i = 0; i < NUM_EVENT_COUNTERS; ++i) {
+			totals[i] += block->counts[i].load(memory_order_relaxed);
+		}
+	}
+}
+
+
+void event_counters_reset()
+{
+	lock_guard<mutex> guard(blocks_lock);
+	for (EventCounterBlock* block : blocks) {
+		for (int i = 0; i < NUM_EVENT_COUNTERS; ++i) {
+			block->counts[i].store(0, memory_order_relaxed);
+		}
+	}
+}
+
+#else
+
+void event_counters_collect(long long totals[NUM_EVENT_COUNTERS])
+{
+	for (int i = 0; i < NUM_EVENT_COUNTERS; ++i) {
+		totals[i] = 0;
+	}
+}
+
+
+void event_counters_reset() {}
+
+#endif
@@ -0,0 +1,87 @@
+/**
+ * Event counters for hot paths of DD construction and Lagrangian relaxation, compiled in with USE_EVENT_COUNTERS
+ */
+
+#ifndef EVENT_COUNTERS_HPP_
+#define EVENT_COUNTERS_HPP_
+
+#include <atomic>
+#include <cstddef>
+
+using namespace std;
+
+
+/** Counted events */
+enum EventCounter {
+	EVENT_NODE_LOOKUPS,               /**< lookups of a new state in the node table during construction */
+	EVENT_NODE_EQUIVALENT,            /**< lookups that found an equivalent node */
+	EVENT_TRANSITIONS,                /**< state transitions */
+	EVENT_TRANSITIONS_INFEASIBLE,     /**< state transitions that returned an infeasible state */
+	EVENT_NODE_DATA_INFEASIBLE,       /**< node data transitions that were infeasible */
+	EVENT_NODE_MERGES,                /**< nodes merged into another node to respect the width */
+	EVENT_LONG_ARC_SKIPS,             /**< nodes skipping a layer through a long arc */
+	EVENT_LAG_ITERATIONS,             /**< iterations of the Lagrangian master problem */
+	EVENT_LAG_EVALUATIONS,            /**< evaluations of the Lagrangian subproblem */
+	EVENT_LAG_ORACLE_CALLS,           /**< oracle calls of a Lagrangian subproblem (counted once, not again by nested oracles) */
+	NUM_EVENT_COUNTERS
+};
+
+
+#ifdef USE_EVENT_COUNTERS
+
+/** Counters of a single thread; only that thread writes them */
+struct EventCounterBlock {
+	atomic<long long> counts[NUM_EVENT_COUNTERS];
+};
+
+extern thread_local EventCounterBlock* event_counter_block;    /**< counters of the calling thread (NULL until first use) */
+
+/** Create and register the counters of the calling thread */
+EventCounterBlock* event_counter_block_register();
+
+/** Add n to a counter of the calling thread; a plain load and store since no other thread writes it */
+inline void count_event(EventCounter event, long long n = 1)
+{
+	EventCounterBlock* block = event_counter_block;
+	if (block == NULL) {
+		block = event_counter_block_register();
+	}
+	atomic<long long>& count = block->counts[event];
+	count.store(count.load(memory_order_relaxed) + n, memory_order_relaxed);
+}
+
+#define COUNT_EVENT(event)        count_event(event)
+#define COUNT_EVENTS(event, n)    count_event(event, n)
+
+#else
+
+#define COUNT_EVENT(event)        ((void) 0)
+#define COUNT_EVENTS(event, n)    ((void) 0)
+
+#endif
+
+
+/** Return whether event counters were compiled in */
+inline bool event_counters_enabled()
+{
+#ifdef USE_EVENT_COUNTERS
+	return true;
+#else
+	return false;
+#endif
+}
+
+/** Return the name of a counter */
+const char* event_counter_name(EventCounter event);
+
+/**
+ * Store in totals the counts summed over all threads, including threads that have finished. Counts of threads that are
+ * still running may be slightly behind. All zero if counters were not compiled in.
+ */
+void event_counters_collect(long long totals[NUM_EVENT_COUNTERS]);
+
+/** Reset the counts of all threads; must not be called while other threads are counting */
+void event_counters_reset();
+
+
+#endif /* EVENT_COUNTERS_HPP_ */
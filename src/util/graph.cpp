@@ -9,6 +9,7 @@
 #include <vector>
 
 #include "graph.hpp"
+#include "mapped_file.hpp"
 
 #define MIN(a,b) a < b ? a : b
 #define MAX(a,b) a > b ? a : b
@@ -18,71 +19,68 @@ using namespace std;
 
 void Graph::read_dimacs(const char* filename)
 {
-
-	string buffer;
-	char   command;
-
-	ifstream input(filename);
+	MappedFile input(filename);
 
 	if (!input.is_open()) {
 		cerr << "Error: could not open DIMACS graph file " << filename << endl << endl;
 		exit(1);
 	}
 
+	TextScanner scanner(input.begin(), input.end());
+
 	int read_edges = 0;
 	n_edges = -1;
 
-	int source, target;
+	long long source, target;
 
-	while (read_edges != n_edges) {
+	while (read_edges != n_edges && !scanner.at_end()) {
 
-		input >> command;
+		char command = scanner.read_char();
 
 		if (command == 'c') {
 			// read comment
-			getline(input, buffer);
+			scanner.skip_line();
 
 		} else if (command == 'p') {
 			// read 'edge' or 'col'
-			input >> buffer;
+			scanner.skip_token();
 
 			// read number of vertices and edges
-			input >> n_vertices;
-			input >> n_edges;
-
-			// allocate adjacent matrix
-			adj_m = new bool*[n_vertices];
-			for (int i = 0; i < n_vertices; i++) {
-				adj_m[i] = new bool[n_vertices];
-				memset(adj_m[i], false, sizeof(bool)*n_vertices);
+			long long nv, ne;
+			if (!scanner.read_int(nv) || !scanner.read_int(ne)) {
+				cerr << "Error: invalid problem line in DIMACS graph file " << filename << endl << endl;
+				exit(1);
 			}
+			n_edges = ne;
 
-			// allocate adjacent list
-			adj_list.resize(n_vertices);
-
+			// allocate adjacent matrix
+			allocate(nv);
 
 		} else if (command == 'e') {
 			// read edge
-			input >> source;
+			if (!scanner.read_int(source) || !scanner.read_int(target) || source < 1 || target < 1
+			        || source > n_vertices || target > n_vertices) {
+				cerr << "Error: invalid edge in DIMACS graph file " << filename << endl << endl;
+				exit(1);
+			}
 			source--;
-
-			input >> target;
 			target--;
 
 			set_adj(source, target);
 			set_adj(target, source);
 
 			read_edges++;
+
+		} else {
+			scanner.skip_line();
 		}
 
 	}
 
-	input.close();
-
 	int count_edges = 0;
 	for (int i = 0; i < n_vertices; i++) {
-		for (int j = i+1; j < n_vertices; j++) {
-			if (is_adj(i,j)) {
+		for (int j : neighbors(i)) {
+			if (j > i) {
 				count_edges++;
 			}
 		}
@@ -114,8 +112,8 @@ void Graph::export_to_gml(const char* output)
 	}
 	int total_edges = 0;
 	for (int i = 0; i < n_vertices; i++) {
-		for (int j = i+1; j < n_vertices; j++) {
-			if (!is_adj(i, j)) {
+		for (int j : neighbors(i)) {
+			if (j <= i) {
 				continue;
 			}
 			file << "edge [\n";
@@ -136,34 +134,44 @@ void Graph::export_to_gml(const char* output)
  * Mapping description: mapping[i] = position where vertex i is in new ordering
  */
 Graph::Graph(Graph* graph, vector<int>& mapping)
-	: n_vertices(graph->n_vertices), n_edges(graph->n_edges)
+	: n_edges(graph->n_edges)
 {
-	// allocate adjacent matrix
-	adj_m = new bool*[n_vertices];
-	for (int i = 0; i < n_vertices; i++) {
-		adj_m[i] = new bool[n_vertices];
-		memset(adj_m[i], false, sizeof(bool)*n_vertices);
-	}
-
-	// allocate adjacent list
-	adj_list.resize(n_vertices);
+	allocate(graph->n_vertices);
 
 	// construct graph according to mapping
 	for (int i = 0; i < graph->n_vertices; i++) {
-		for (int j : graph->adj_list[i]) {
+		for (int j : graph->neighbors(i)) {
 			set_adj(mapping[i], mapping[j]);
 		}
 	}
 }
 
 
+void Graph::build_neighbors()
+{
+	nbr_start.resize(n_vertices + 1);
+	nbr_ind.clear();
+	for (int v = 0; v < n_vertices; ++v) {
+		nbr_start[v] = nbr_ind.size();
+		const uint64_t* row = adj_row(v);
+		for (int w = 0; w < nwords; ++w) {
+			for (uint64_t bits = row[w]; bits != 0; bits &= bits - 1) {
+				nbr_ind.push_back(w * 64 + __builtin_ctzll(bits));
+			}
+		}
+	}
+	nbr_start[n_vertices] = nbr_ind.size();
+	nbr_valid = true;
+}
+
+
 void Graph::print()
 {
 	cout << "Graph" << endl;
 	for (int v = 0; v < n_vertices; ++v) {
-		if (adj_list[v].size() != 0) {
+		if (degree(v) != 0) {
 			cout << "\t" << v << " --> ";
-			for (int u : adj_list[v]) {
+			for (int u : neighbors(v)) {
 				cout << u << " ";
 			}
 			cout << endl;
@@ -176,9 +184,14 @@ void Graph::print()
 Graph* Graph::create_subgraph(vector<int> subgraph_vertices)
 {
 	Graph* subgraph = new Graph(subgraph_vertices.size());
+	vector<int> vertex_to_sub(n_vertices, -1);
+	for (int u = 0; u < subgraph->n_vertices; ++u) {
+		vertex_to_sub[subgraph_vertices[u]] = u;
+	}
 	for (int u = 0; u < subgraph->n_vertices; ++u) {
-		for (int v = u; v < subgraph->n_vertices; ++v) {
-			if (is_adj(subgraph_vertices[u], subgraph_vertices[v])) {
+		for (int w : neighbors(subgraph_vertices[u])) {
+			int v = vertex_to_sub[w];
+			if (v >= u) {
 				subgraph->add_edge(u, v);
 			}
 		}
@@ -188,105 +201,100 @@ Graph* Graph::create_subgraph(vector<int> subgraph_vertices)
 }
 
 
-/** Extract a clique from the graph. If graph has no edges, return NULL. */
-Graph* extract_clique(Graph* graph, vector<vector<int>>& cliques)
+/**
+ * Extract a clique from the remaining edges, given as a bit matrix with nwords words per row and the degree of each
+ * vertex. Return false if there are no edges left.
+ */
+static
+bool extract_clique(int n_vertices, int nwords, vector<uint64_t>& remaining, vector<int>& degree,
+                    vector<vector<int>>& cliques)
 {
 	// find vertex with largest degree
 	int vertex = -1;
 	int max_degree = 0;
-	for (int v = 0; v < graph->n_vertices; ++v) {
-		if (graph->degree(v) > max_degree) {
+	for (int v = 0; v < n_vertices; ++v) {
+		if (degree[v] > max_degree) {
 			vertex = v;
-			max_degree = graph->degree(v);
+			max_degree = degree[v];
 		}
 	}
 
 	// if maximum degree is zero, graph has no edges
 	if (max_degree == 0) {
-		return NULL;
+		return false;
 	}
 
-	// vertices already in clique (using bool* might be slightly more efficient)
-	vector<bool> in_clique(graph->n_vertices, false);
 	vector<int> clique;
 	clique.push_back(vertex);
-	in_clique[vertex] = true;
-
-	// grow clique by taking vertices that are adjacent to 'vertex' with maximum degree
-	while (true) {
 
-		vector<int> subgraph;
-		for (int u : graph->adj_list[vertex]) {
-			// check if vertex is adjacent to all vertices in clique
-			bool is_adj_all = !in_clique[u];
-			for (int j = 1; j < (int)clique.size() && is_adj_all; ++j) {
-				is_adj_all = graph->is_adj(clique[j], u);
-			}
-			if (is_adj_all) {
-				subgraph.push_back(u);
-			}
-		}
-
-		if (subgraph.empty()) {
-			break;
-		}
+	// candidates are the vertices adjacent to all vertices in the clique
+	vector<uint64_t> candidates(remaining.begin() + (size_t) vertex * nwords,
+	                            remaining.begin() + (size_t) (vertex + 1) * nwords);
+	candidates[vertex / 64] &= ~((uint64_t) 1 << (vertex % 64));
 
-		max_degree = -1;
+	// grow clique by taking the candidate adjacent to the most other candidates
+	while (true) {
 		int selected_u = -1;
-		for (int i = 0; i < (int)subgraph.size(); ++i) {
-			int degree = 0;
-			for (int j = 0; j < (int)subgraph.size(); ++j) {
-				if (i == j) {
-					continue;
+		max_degree = -1;
+		for (int w = 0; w < nwords; ++w) {
+			for (uint64_t bits = candidates[w]; bits != 0; bits &= bits - 1) {
+				int u = w * 64 + __builtin_ctzll(bits);
+				const uint64_t* row = &remaining[(size_t) u * nwords];
+				int u_degree = 0;
+				for (int k = 0; k < nwords; ++k) {
+					u_degree += __builtin_popcountll(candidates[k] & row[k]);
 				}
-				if (graph->is_adj(subgraph[i], subgraph[j])) {
-					degree++;
+				if (u_degree > max_degree) {
+					selected_u = u;
+					max_degree = u_degree;
 				}
 			}
-			if (degree > max_degree) {
-				selected_u = subgraph[i];
-				max_degree = degree;
-			}
+		}
+
+		if (selected_u < 0) {
+			break;
 		}
 
 		// add vertex to clique
 		clique.push_back(selected_u);
-		in_clique[selected_u] = true;
+		const uint64_t* row = &remaining[(size_t) selected_u * nwords];
+		for (int k = 0; k < nwords; ++k) {
+			candidates[k] &= row[k];
+		}
+		candidates[selected_u / 64] &= ~((uint64_t) 1 << (selected_u % 64));
 	}
 
-	// build graph representing clique, and remove clique from original graph
+	// remove clique from remaining edges
 	for (int i = 0; i < (int)clique.size(); ++i) {
-		for (int j = i+1; j < (int)clique.size(); ++j) {
-			graph->remove_edge(clique[i], clique[j]);
+		for (int j = 0; j < (int)clique.size(); ++j) {
+			if (i != j) {
+				remaining[(size_t) clique[i] * nwords + clique[j] / 64] &= ~((uint64_t) 1 << (clique[j] % 64));
+			}
 		}
+		degree[clique[i]] -= clique.size() - 1;
 	}
 
 	// add clique to set of cliques
 	cliques.push_back(clique);
 
-	return graph;
+	return true;
 }
 
 
 /** Decompose the graph into cliques */
 void clique_decomposition(Graph* graph, vector<vector<int>>& cliques)
 {
-	// Create copy of the graph
-	Graph* graph_copy = new Graph(graph->n_vertices);
+	// Edges not yet covered by a clique
+	vector<uint64_t> remaining(graph->adj_bits);
+	vector<int> degree(graph->n_vertices);
 	for (int v = 0; v < graph->n_vertices; ++v) {
-		if (graph->adj_list[v].size() != 0) {
-			for (int u : graph->adj_list[v]) {
-				graph_copy->add_edge(v, u);
-			}
-		}
+		degree[v] = graph->degree(v) - (graph->is_adj(v, v) ? 1 : 0);
 	}
-	Graph* graph_copy_ptr = graph_copy; // only to keep pointer for deletion
 
 	cliques.clear();
 
 	// Extract cliques
-	while (graph_copy != NULL) {
-		graph_copy = extract_clique(graph_copy, cliques);
+	while (extract_clique(graph->n_vertices, graph->nwords, remaining, degree, cliques)) {
 
 		// cout << "Clique " << cliques.size() << ": ";
 		// for( int i = 0; i < (int)cliques.back().size(); ++i ) {
@@ -294,6 +302,4 @@ void clique_decomposition(Graph* graph, vector<vector<int>>& cliques)
 		// }
 		// cout << endl;
 	}
-
-	delete graph_copy_ptr;
 }
@@ -6,20 +6,45 @@
 #define GRAPH_HPP_
 
 #include <cassert>
+#include <cstdint>
 #include <cstring>
 #include <vector>
 
 using namespace std;
 
 
+/** Range of neighbors of a vertex, as stored in the neighbor arrays of a graph */
+struct NeighborRange {
+	const int* first;
+	const int* last;
+
+	const int* begin() const
+	{
+		return first;
+	}
+
+	const int* end() const
+	{
+		return last;
+	}
+
+	int size() const
+	{
+		return last - first;
+	}
+};
+
+
 /**
- * Simple graph structure that assumes that arcs/nodes are not removed once inserted. It keeps a redundant representation
- * as an adjacent matrix and list for fast iteration and adjacency check.
+ * Simple graph structure that assumes that nodes are not removed once inserted. It keeps a redundant representation
+ * as a packed bit matrix for fast adjacency checks and word-parallel neighborhood operations, and as neighbor arrays in
+ * compressed sparse row form for fast iteration. Neighbor arrays are rebuilt on the first query after edges change, so
+ * a graph being modified must not be queried concurrently.
  */
 struct Graph {
 
-	bool**                      adj_m;              /**< adjacent matrix */
-	vector< vector<int> >       adj_list;           /**< adjacent list */
+	vector<uint64_t>            adj_bits;           /**< adjacency matrix, one bit per pair, nwords words per row */
+	int                         nwords;             /**< number of 64-bit words per row of adj_bits */
 
 	int                         n_vertices;         /**< |V| */
 	int                         n_edges;            /**< |E| */
@@ -28,7 +53,7 @@ struct Graph {
 	void set_adj(int i, int j);
 
 	/** Check if two vertices are adjancent */
-	bool is_adj(int i, int j);
+	bool is_adj(int i, int j) const;
 
 	/** Empty constructor */
 	Graph();
@@ -36,9 +61,6 @@ struct Graph {
 	/** Create an isomorphic graph according to a vertex mapping */
 	Graph(Graph* graph, vector<int>& mapping);
 
-	/** Destructor */
-	~Graph();
-
 	/** Read graph from a DIMACS format */
 	void read_dimacs(const char* filename);
 
@@ -54,12 +76,27 @@ struct Graph {
 	/** Remove edge */
 	void remove_edge(int i, int j);
 
+	/** Return the neighbors of a vertex in increasing order */
+	NeighborRange neighbors(int v);
+
 	/** Return degree of a vertex */
 	int degree(int v)
 	{
-		return adj_list[v].size();
+		return neighbors(v).size();
 	}
 
+	/** Return the row of the bit matrix of a vertex (nwords words) */
+	const uint64_t* adj_row(int v) const
+	{
+		return &adj_bits[(size_t) v * nwords];
+	}
+
+	/** Intersect a bitset over the vertices (nwords words) with the neighborhood of a vertex */
+	void intersect_neighbors(vector<uint64_t>& set, int v) const;
+
+	/** Return the number of common neighbors of two vertices */
+	int count_common_neighbors(int u, int v) const;
+
 	/** Return the density of the graph */
 	double density();
 
@@ -71,6 +108,18 @@ struct Graph {
 	 * The vertices will be mapped corresponding to the order in the original graph.
 	 */
 	Graph* create_subgraph(vector<int> subgraph_vertices);
+
+private:
+
+	vector<int>                 nbr_start;          /**< neighbors of v are nbr_ind[nbr_start[v]..nbr_start[v+1]-1] */
+	vector<int>                 nbr_ind;            /**< neighbors of all vertices */
+	bool                        nbr_valid;          /**< if false, neighbor arrays are outdated */
+
+	/** Allocate an empty bit matrix for the given number of vertices */
+	void allocate(int num_vertices);
+
+	/** Rebuild neighbor arrays from the bit matrix */
+	void build_neighbors();
 };
 
 
@@ -83,32 +132,32 @@ struct Graph {
 /**
  * Empty constructor
  */
-inline Graph::Graph() : n_vertices(0), n_edges(0)
+inline Graph::Graph() : nwords(0), n_vertices(0), n_edges(0), nbr_valid(false)
 {
 
 }
 
 /**
- * Destructor
+ * Allocate an empty bit matrix for the given number of vertices
  */
-inline Graph::~Graph()
+inline void Graph::allocate(int num_vertices)
 {
-	for (int i = 0; i < n_vertices; ++i) {
-		delete[] adj_m[i];
-	}
-	delete[] adj_m;
+	n_vertices = num_vertices;
+	nwords = (num_vertices + 63) / 64;
+	adj_bits.assign((size_t) num_vertices * nwords, 0);
+	nbr_valid = false;
 }
 
 /**
  * Check if two vertices are adjacent
  */
-inline bool Graph::is_adj(int i, int j)
+inline bool Graph::is_adj(int i, int j) const
 {
 	assert(i >= 0);
 	assert(j >= 0);
 	assert(i < n_vertices);
 	assert(j < n_vertices);
-	return adj_m[i][j];
+	return (adj_bits[(size_t) i * nwords + j / 64] >> (j % 64)) & 1;
 }
 
 
@@ -122,14 +171,8 @@ inline void Graph::set_adj(int i, int j)
 	assert(i < n_vertices);
 	assert(j < n_vertices);
 
-	// check if already adjacent
-	if (adj_m[i][j]) {
-		return;
-	}
-
-	// add to adjacent matrix and list
-	adj_m[i][j] = true;
-	adj_list[i].push_back(j);
+	adj_bits[(size_t) i * nwords + j / 64] |= (uint64_t) 1 << (j % 64);
+	nbr_valid = false;
 }
 
 
@@ -137,14 +180,9 @@ inline void Graph::set_adj(int i, int j)
  * Constructor with number of vertices
  */
 inline Graph::Graph(int num_vertices)
-	: n_vertices(num_vertices), n_edges(0)
+	: n_edges(0)
 {
-	adj_m = new bool*[ num_vertices ];
-	for (int i = 0; i < num_vertices; ++i) {
-		adj_m[i] = new bool[ num_vertices ];
-		memset(adj_m[i], false, sizeof(bool) * num_vertices);
-	}
-	adj_list.resize(num_vertices);
+	allocate(num_vertices);
 }
 
 /**
@@ -152,21 +190,13 @@ inline Graph::Graph(int num_vertices)
  */
 inline void Graph::add_edge(int i, int j)
 {
-	assert(i >= 0);
-	assert(j >= 0);
-	assert(i < n_vertices);
-	assert(j < n_vertices);
-
 	// check if already adjacent
-	if (adj_m[i][j]) {
+	if (is_adj(i, j)) {
 		return;
 	}
 
-	// add to adjacent matrix and list
-	adj_m[i][j] = true;
-	adj_m[j][i] = true;
-	adj_list[i].push_back(j);
-	adj_list[j].push_back(i);
+	set_adj(i, j);
+	set_adj(j, i);
 
 	n_edges++;
 }
@@ -176,37 +206,58 @@ inline void Graph::add_edge(int i, int j)
  */
 inline void Graph::remove_edge(int i, int j)
 {
-	assert(i >= 0);
-	assert(j >= 0);
-	assert(i < n_vertices);
-	assert(j < n_vertices);
-
 	// check if already adjacent
-	if (!adj_m[i][j]) {
+	if (!is_adj(i, j)) {
 		return;
 	}
 
-	// add to adjacent matrix and list
-	adj_m[i][j] = false;
-	adj_m[j][i] = false;
+	adj_bits[(size_t) i * nwords + j / 64] &= ~((uint64_t) 1 << (j % 64));
+	adj_bits[(size_t) j * nwords + i / 64] &= ~((uint64_t) 1 << (i % 64));
+	nbr_valid = false;
 
-	for (int v = 0; v < (int)adj_list[i].size(); ++v) {
-		if (adj_list[i][v] == j) {
-			adj_list[i][v] = adj_list[i].back();
-			adj_list[i].pop_back();
-			break;
-		}
+	n_edges--;
+}
+
+/**
+ * Return the neighbors of a vertex in increasing order
+ */
+inline NeighborRange Graph::neighbors(int v)
+{
+	if (!nbr_valid) {
+		build_neighbors();
 	}
+	NeighborRange range;
+	range.first = nbr_ind.data() + nbr_start[v];
+	range.last = nbr_ind.data() + nbr_start[v + 1];
+	return range;
+}
 
-	for (int v = 0; v < (int)adj_list[j].size(); ++v) {
-		if (adj_list[j][v] == i) {
-			adj_list[j][v] = adj_list[j].back();
-			adj_list[j].pop_back();
-			break;
-		}
+/**
+ * Intersect a bitset over the vertices with the neighborhood of a vertex
+ */
+inline void Graph::intersect_neighbors(vector<uint64_t>& set, int v) const
+{
+	assert((int) set.size() == nwords);
+	const uint64_t* row = adj_row(v);
+	for (int w = 0; w < nwords; ++w) {
+		set[w] &= row[w];
 	}
 }
 
+/**
+ * Return the number of common neighbors of two vertices
+ */
+inline int Graph::count_common_neighbors(int u, int v) const
+{
+	const uint64_t* row_u = adj_row(u);
+	const uint64_t* row_v = adj_row(v);
+	int count = 0;
+	for (int w = 0; w < nwords; ++w) {
+		count += __builtin_popcountll(row_u[w] & row_v[w]);
+	}
+	return count;
+}
+
 /**
  * Return the density of the graph
  */
@@ -219,4 +270,3 @@ inline double Graph::density()
 void clique_decomposition(Graph* graph, vector<vector<int>>& cliques);
 
 #endif
-
@@ -0,0 +1,85 @@
+/**
+ * Read-only memory-mapped files and a scanner for hand-rolled parsing of text files
+ */
+
+#include <cstdlib>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "mapped_file.hpp"
+
+
+MappedFile::MappedFile(const char* filename) : open(false), data(NULL), length(0)
+{
+	int fd = ::open(filename, O_RDONLY);
+	if (fd < 0) {
+		return;
+	}
+
+	struct stat file_stat;
+	if (fstat(fd, &file_stat) == 0) {
+		length = file_stat.st_size;
+		if (length == 0) {
+			open = true;
+		} else {
+			void* mapped = mmap(NULL, length, PROT_READ, MAP_PRIVATE, fd, 0);
+			if (mapped != MAP_FAILED) {
+				data = (char*) mapped;
+				open = true;
+				madvise(mapped, length, MADV_SEQUENTIAL);
+			} else {
+				length = 0;
+			}
+		}
+	}
+	close(fd);
+}
+
+
+MappedFile::~MappedFile()
+{
+	if (data != NULL) {
+		munmap(data, length);
+	}
+}
+
+
+bool TextScanner::read_int(long long& value)
+{
+	skip_space();
+	bool negative = false;
+	if (pos < end && (*pos == '-' || *pos == '+')) {
+		negative = (*pos == '-');
+		++pos;
+	}
+	if (pos >= end || *pos < '0' || *pos > '9') {
+		return false;
+	}
+	value = 0;
+	while (pos < end && *pos >= '0' && *pos <= '9') {
+		value = 10 * value + (*pos - '0');
+		++pos;
+	}
+	if (negative) {
+		value = -value;
+	}
+	return true;
+}
+
+
+bool TextScanner::read_double(double& value)
+{
+	// Copy the token since strtod requires a null-terminated string
+	skip_space();
+	char buffer[64];
+	int len = 0;
+	while (pos < end && len < 63 && *pos != ' ' && *pos != '\t' && *pos != '\n' && *pos != '\r') {
+		buffer[len++] = *pos++;
+	}
+	buffer[len] = '\0';
+	char* parsed_end;
+	value = strtod(buffer, &parsed_end);
+	return (len > 0 && parsed_end == buffer + len);
+}
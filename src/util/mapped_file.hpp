@@ -0,0 +1,106 @@
+/**
+ * Read-only memory-mapped files and a scanner for hand-rolled parsing of text files
+ */
+
+#ifndef MAPPED_FILE_HPP_
+#define MAPPED_FILE_HPP_
+
+#include <cstddef>
+
+using namespace std;
+
+
+/** Read-only memory mapping of a whole file */
+class MappedFile
+{
+public:
+	/** Map the given file; check is_open for success */
+	MappedFile(const char* filename);
+
+	~MappedFile();
+
+	bool is_open() const
+	{
+		return open;
+	}
+
+	const char* begin() const
+	{
+		return data;
+	}
+
+	const char* end() const
+	{
+		return data + length;
+	}
+
+	size_t size() const
+	{
+		return length;
+	}
+
+private:
+	bool open;
+	char* data;
+	size_t length;
+
+	MappedFile(const MappedFile&);
+	MappedFile& operator=(const MappedFile&);
+};
+
+
+/** Cursor over a text buffer (not necessarily null-terminated) of whitespace-separated tokens */
+struct TextScanner {
+	const char* pos;
+	const char* end;
+
+	TextScanner(const char* _begin, const char* _end) : pos(_begin), end(_end) {}
+
+	/** Skip whitespace; return true if the end of the buffer is reached */
+	bool at_end()
+	{
+		skip_space();
+		return pos >= end;
+	}
+
+	/** Skip whitespace, including newlines */
+	void skip_space()
+	{
+		while (pos < end && (*pos == ' ' || *pos == '\t' || *pos == '\n' || *pos == '\r')) {
+			++pos;
+		}
+	}
+
+	/** Skip the rest of the current line */
+	void skip_line()
+	{
+		while (pos < end && *pos != '\n') {
+			++pos;
+		}
+	}
+
+	/** Skip the next token */
+	void skip_token()
+	{
+		skip_space();
+		while (pos < end && *pos != ' ' && *pos != '\t' && *pos != '\n' && *pos != '\r') {
+			++pos;
+		}
+	}
+
+	/** Read the first character of the next token without consuming the rest of it; return 0 at the end */
+	char read_char()
+	{
+		skip_space();
+		return (pos < end) ? *pos++ : 0;
+	}
+
+	/** Read a decimal integer; return false if the next token does not start with one */
+	bool read_int(long long& value);
+
+	/** Read a floating-point number; return false if the next token is not one */
+	bool read_double(double& value);
+};
+
+
+#endif /* MAPPED_FILE_HPP_ */
@@ -22,6 +22,7 @@ struct Options {
 	int    max_rounds_root                      = -1;      /**< maximum rounds of general MIP cuts at root (-1: SCIP default) */
 	double mip_time_limit                       = 3600;    /**< time limit for the MIP solver */
 	int    mip_seed                             = 0;       /**< if nonzero, random seed for MIP solver */
+	double mip_memory_limit                     = -1;      /**< memory limit for the MIP solver in MB (negative: solver default) */
 
 	// DD bound options
 	bool   lag_prop                             = false;   /**< propagation in Lagrangian relaxation */
@@ -43,6 +44,20 @@ struct Options {
 	bool   lag_add_linear                       = false;   /**< if true, run heuristics to incorporate linear constraints into DD */
 	bool   lag_initial_dd                       = false;   /**< if true, prepare Lagrangian rows and decision diagrams before first LP */
 	bool   lag_run_once                         = false;   /**< if true, abort immediately at the end of the first relaxation */
+	bool   lag_rc_fixing                        = false;   /**< if true, fix variables with DD reduced-cost bounds via propagator */
+	bool   lag_bundle                           = false;   /**< if true, solve Lagrangian dual with the native bundle method instead of ConicBundle */
+	int    lag_coarse_width                     = 0;       /**< if positive, early Lagrangian iterations use a coarsening of the DD with this width */
+	int    lag_nsubgradients                    = 1;       /**< number of best DD paths returned as subgradients per Lagrangian oracle call */
+	bool   lag_decompose                        = false;   /**< if true, build one DD per independent block of the DD constraints and sum their bounds */
+	int    lag_decompose_nthreads               = 1;       /**< number of threads solving the blocks of a decomposed Lagrangian subproblem */
+	int    lag_decompose_enum_size              = 6;       /**< components of a decomposed subproblem with at most this many variables are enumerated instead of building a DD */
+	bool   lag_warm_start                       = false;   /**< if true, start Lagrangian relaxation from the multipliers of the closest ancestor node */
+	bool   lag_async                            = false;   /**< if true, compute DD bounds in background threads while SCIP continues */
+	int    lag_async_nthreads                   = 0;       /**< number of background threads for asynchronous DD bounds (0: number of cores - 1) */
+
+	// DD primal heuristic options
+	bool   heur_dd                              = false;   /**< run primal heuristic based on restricted DDs */
+	int    heur_dd_width                        = 100;     /**< width limit for restricted DDs in primal heuristic */
 
 	// DD construction
 	int    order_id                             = -1;      /**< id corresponding to ordering rule */
@@ -52,6 +67,20 @@ struct Options {
 	string fixed_order_filename                 = "fixed_order.txt";  /**< input file for a fixed order for the DD */
 	double order_rand_min_state_prob            = 0.8;     /**< probability for the randomized min in state ordering */
 	bool   delete_old_states                    = true;    /**< free states from nodes of previous layers to reduce memory usage */
+	double dd_memory_limit                      = -1;      /**< approximate memory limit of a DD construction in MB: past it the width is halved,
+	                                                         *  or construction is aborted with a partial bound if it cannot be (negative: no limit) */
+
+	// Standalone DD branch-and-bound options
+	bool   run_dd_bb                            = false;   /**< solve with the parallel DD branch-and-bound instead of the MIP solver */
+	int    bb_nthreads                          = 0;       /**< number of threads for DD branch-and-bound (0: number of cores) */
+	double bb_time_limit                        = 3600;    /**< time limit for DD branch-and-bound (wall clock) */
+
+	// Batch options
+	string batch_manifest_file                  = "";      /**< if nonempty, run the jobs of this manifest instead of a single instance */
+	int    batch_nthreads                       = 0;       /**< number of jobs run concurrently in batch mode (0: number of cores) */
+	string batch_output_file                    = "batch_results.csv";  /**< consolidated results table of batch mode */
+	double batch_time_limit                     = -1;      /**< time limit per batch job in seconds (negative: use the limits of the job's options) */
+	double batch_memory_limit                   = -1;      /**< approximate memory limit per batch job in MB (negative: no limit) */
 
 	// BP options
 	bool   bp_prop_only_set_packing             = false;   /**< does not add set packing constraints as RHSs in state; instead, propagate them only */
@@ -60,10 +89,15 @@ struct Options {
 	// Clique table options
 	bool   ct_process_initial_state             = true;    /**< ensure that initial state is domain consistent */
 
+	// Input options
+	bool   instance_cache                       = false;   /**< read instances from a binary cache next to the instance file, creating it if needed */
+
 	// Output options
 	bool   quiet                                = false;   /**< do not output DD construction information */
 	bool   bounds_verbose                       = false;   /**< print information on bounds */
 	bool   output_stats_verbose                 = false;   /**< print a verbose version of output_stats */
+	string profile_trace_file                   = "";      /**< if nonempty, profile DD construction and bounds and write a Chrome trace to this file */
+	string dd_telemetry_file                    = "";      /**< if nonempty, write per-layer DD construction statistics to this file (CSV if .csv, NDJSON otherwise) */
 
 };
 
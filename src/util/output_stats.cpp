@@ -3,6 +3,7 @@
  */
 
 #include "output_stats.hpp"
+#include "event_counters.hpp"
 
 #include <iostream>
 
@@ -18,7 +19,23 @@ void print_output_stats(OutputStats* output_stats)
 	cout << "  Number of improved runs: " << output_stats->num_runs_improved << endl;
 	cout << "  Number of pruned runs: " << output_stats->num_runs_pruned << endl;
 	cout << "  Number of primal improvements: " << output_stats->num_primal_improved << endl;
+	cout << "  Number of primal checks: " << output_stats->num_primal_checks << endl;
+	cout << "  Number of primal checks skipped (cached): " << output_stats->num_primal_cached << endl;
+	cout << "  Number of primal checks skipped (filtered): " << output_stats->num_primal_filtered << endl;
 	cout << "  Number of exact BDDs: " << output_stats->num_bdd_exact << endl;
+	cout << "  Number of reduced-cost fixings: " << output_stats->num_rc_fixings << endl;
+	cout << "  Number of warm-started Lagrangian relaxations: " << output_stats->num_lag_warm_starts << endl;
+	cout << "  Number of asynchronous jobs: " << output_stats->num_async_jobs << endl;
+	cout << "  Number of asynchronous jobs cancelled: " << output_stats->num_async_cancelled << endl;
+	cout << "  Peak BDD memory (bytes): " << output_stats->dd_peak_bytes << " [nodes " << output_stats->dd_peak_node_bytes
+	     << " / states " << output_stats->dd_peak_state_bytes << " / node data " << output_stats->dd_peak_data_bytes
+	     << " / node tables " << output_stats->dd_peak_table_bytes << "]" << endl;
+	cout << "  Total final BDD memory (bytes): " << output_stats->dd_final_bytes_total << endl;
+	cout << "  Number of BDDs reaching the memory limit: " << output_stats->num_dd_memory_limit << endl;
+	cout << "  Number of BDDs aborted at the memory limit: " << output_stats->num_dd_memory_aborted << endl;
+	cout << "  Total restricted BDD heuristic time: " << output_stats->heur_dd_time << endl;
+	cout << "  Number of restricted BDD heuristic runs: " << output_stats->num_heur_dd_runs << endl;
+	cout << "  Number of restricted BDD heuristic improvements: " << output_stats->num_heur_dd_improved << endl;
 }
 
 void print_output_stats_extra(OutputStats* output_stats)
@@ -38,4 +55,51 @@ void print_output_stats_extra(OutputStats* output_stats)
 		cout << "(" << it.first << "," << it.second << ") ";
 	}
 	cout << endl;
+
+	// Event counters are process-wide totals over all threads
+	if (event_counters_enabled()) {
+		long long counts[NUM_EVENT_COUNTERS];
+		event_counters_collect(counts);
+		cout << "  Event counters:";
+		for (int i = 0; i < NUM_EVENT_COUNTERS; ++i) {
+			cout << " " << event_counter_name((EventCounter) i) << "=" << counts[i];
+		}
+		cout << endl;
+		if (counts[EVENT_NODE_LOOKUPS] > 0) {
+			cout << "  Node table equivalence hit rate: "
+			     << (double) counts[EVENT_NODE_EQUIVALENT] / counts[EVENT_NODE_LOOKUPS] << endl;
+		}
+		if (counts[EVENT_TRANSITIONS] > 0) {
+			cout << "  Infeasible transition rate: "
+			     << (double) counts[EVENT_TRANSITIONS_INFEASIBLE] / counts[EVENT_TRANSITIONS] << endl;
+		}
+		if (counts[EVENT_LAG_ITERATIONS] > 0) {
+			cout << "  Oracle calls per Lagrangian iteration: "
+			     << (double) counts[EVENT_LAG_ORACLE_CALLS] / counts[EVENT_LAG_ITERATIONS] << endl;
+		}
+	}
+}
+
+
+void write_output_stats_csv_header(ostream& out)
+{
+	out << "bdd_time,bound_time,num_attempts,num_runs,num_runs_improved,num_runs_pruned,num_bdd_exact,"
+	    << "num_primal_improved,num_primal_checks,num_primal_cached,num_primal_filtered,num_rc_fixings,"
+	    << "num_lag_warm_starts,num_async_jobs,num_async_cancelled,dd_peak_bytes,dd_final_bytes_total,"
+	    << "num_dd_memory_limit,num_dd_memory_aborted,heur_dd_time,num_heur_dd_runs,num_heur_dd_improved";
+}
+
+
+void write_output_stats_csv(ostream& out, OutputStats* output_stats)
+{
+	out << output_stats->bdd_time << "," << output_stats->bound_time << "," << output_stats->num_attempts << ","
+	    << output_stats->num_runs << "," << output_stats->num_runs_improved << "," << output_stats->num_runs_pruned << ","
+	    << output_stats->num_bdd_exact << "," << output_stats->num_primal_improved << ","
+	    << output_stats->num_primal_checks << "," << output_stats->num_primal_cached << ","
+	    << output_stats->num_primal_filtered << "," << output_stats->num_rc_fixings << ","
+	    << output_stats->num_lag_warm_starts << "," << output_stats->num_async_jobs << ","
+	    << output_stats->num_async_cancelled << "," << output_stats->dd_peak_bytes << ","
+	    << output_stats->dd_final_bytes_total << "," << output_stats->num_dd_memory_limit << ","
+	    << output_stats->num_dd_memory_aborted << "," << output_stats->heur_dd_time << ","
+	    << output_stats->num_heur_dd_runs << "," << output_stats->num_heur_dd_improved;
 }
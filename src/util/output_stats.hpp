@@ -6,6 +6,8 @@
 #define OUTPUT_STATS_HPP_
 
 #include <map>
+#include <ostream>
+#include <string>
 
 using namespace std;
 
@@ -20,6 +22,26 @@ struct OutputStats {
 	int    num_runs_pruned = 0;           /**< number of runs where a node was pruned */
 	int    num_bdd_exact = 0;             /**< number of runs in which decision diagram is exact */
 	int    num_primal_improved = 0;       /**< number of improvements of the primal bound */
+	int    num_primal_checks = 0;         /**< number of candidate primal solutions checked by the solver */
+	int    num_primal_cached = 0;         /**< number of candidate primal solutions skipped since already checked */
+	int    num_primal_filtered = 0;       /**< number of candidate primal solutions rejected before calling the solver */
+	int    num_rc_fixings = 0;            /**< number of variables fixed by DD reduced-cost fixing */
+	int    num_lag_warm_starts = 0;       /**< number of Lagrangian relaxations started from an ancestor's multipliers */
+	int    num_async_jobs = 0;            /**< number of bound jobs dispatched in asynchronous mode */
+	int    num_async_cancelled = 0;       /**< number of bound jobs cancelled because their nodes were pruned */
+
+	long long dd_peak_bytes = 0;          /**< largest peak memory of a decision diagram construction (approximate) */
+	long long dd_peak_node_bytes = 0;     /**< memory of nodes at the largest peak */
+	long long dd_peak_state_bytes = 0;    /**< memory of states at the largest peak */
+	long long dd_peak_data_bytes = 0;     /**< memory of node data at the largest peak */
+	long long dd_peak_table_bytes = 0;    /**< memory of node tables at the largest peak */
+	long long dd_final_bytes_total = 0;   /**< total memory of decision diagrams after construction */
+	int    num_dd_memory_limit = 0;       /**< number of constructions that reached the memory limit */
+	int    num_dd_memory_aborted = 0;     /**< number of constructions aborted at the memory limit */
+
+	double heur_dd_time = 0.0;            /**< total time to build restricted decision diagrams in primal heuristic */
+	int    num_heur_dd_runs = 0;          /**< number of runs of the restricted DD primal heuristic */
+	int    num_heur_dd_improved = 0;      /**< number of runs of the restricted DD primal heuristic that improved the incumbent */
 
 	// Warning: Synchronizing these maps with the above total values is done manually.
 	// These maps are only maintained if output_stats_verbose in Options is set to true.
@@ -28,8 +50,24 @@ struct OutputStats {
 	map<int,int> nvars_num_runs_pruned;           /**< number of vars to number of runs where a node was pruned */
 };
 
+/** Summary of the solve of an instance, as reported in batch mode */
+struct SolveResult {
+	string      status = "unknown";   /**< final status of the solver (e.g. optimal, timelimit, memlimit) */
+	double      primal_bound = 0;     /**< value of the best solution found */
+	double      dual_bound = 0;       /**< final dual bound */
+	double      time = 0;             /**< solving time in seconds (wall clock) */
+	long long   nnodes = 0;           /**< number of branch-and-bound nodes or subproblems processed */
+	OutputStats output_stats;         /**< statistics of the DD components */
+};
+
 void print_output_stats(OutputStats* output_stats);
 
 void print_output_stats_extra(OutputStats* output_stats);
 
+/** Write the names of the totals of output statistics as comma-separated columns, without a line break */
+void write_output_stats_csv_header(ostream& out);
+
+/** Write the totals of output statistics as comma-separated columns, in the order of the header */
+void write_output_stats_csv(ostream& out, OutputStats* output_stats);
+
 #endif /* OUTPUT_STATS_HPP_ */
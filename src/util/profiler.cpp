@@ -0,0 +1,205 @@
+/**
+ * Hierarchical profiler: nested timing scopes recorded per thread and exported as a Chrome trace
+ */
+
+#include <cassert>
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+#include <vector>
+#include "profiler.hpp"
+#include "stats.hpp"
+
+
+/** Scope recorded by the profiler; times in nanoseconds */
+struct ProfileEvent {
+	const char* name;
+	int64_t     start;          /**< wall-clock time at opening */
+	int64_t     wall;           /**< wall-clock duration, or -1 while open */
+	int64_t     cpu;            /**< thread CPU time at opening while open, then CPU duration */
+	long long   node;           /**< branch-and-bound node at opening */
+	int         parent;         /**< index of the enclosing scope, or -1 */
+};
+
+/** Events of a single thread; only that thread appends to it */
+struct ProfileThreadBuffer {
+	int                  tid;
+	vector<ProfileEvent> events;
+	int                  current;   /**< index of the innermost open scope, or -1 */
+};
+
+
+atomic<bool> profiler_active(false);
+
+static mutex                         buffers_lock;
+static vector<ProfileThreadBuffer*>  buffers;          /**< buffers of all threads that recorded scopes; never freed */
+static int64_t                       origin = -1;      /**< wall-clock time of the first start */
+
+static thread_local ProfileThreadBuffer* local_buffer = NULL;
+static thread_local long long            local_node = -1;
+
+
+/** Return the buffer of the calling thread, registering it on first use */
+static ProfileThreadBuffer* get_local_buffer()
+{
+	if (local_buffer == NULL) {
+		local_buffer = new ProfileThreadBuffer();
+		local_buffer->current = -1;
+		lock_guard<mutex> guard(buffers_lock);
+		local_buffer->tid = buffers.size();
+		buffers.push_back(local_buffer);
+	}
+	return local_buffer;
+}
+
+
+void profiler_enable(bool enable)
+{
+	if (enable) {
+		lock_guard<mutex> guard(buffers_lock);
+		if (origin < 0) {
+			origin = wall_clock_ns();
+		}
+	}
+	profiler_active.store(enable);
+}
+
+
+void profiler_set_node(long long node)
+{
+	local_node = node;
+}
+
+
+long long profiler_get_node()
+{
+	return local_node;
+}
+
+
+void ProfileScope::begin(const char* name)
+{
+	ProfileThreadBuffer* buffer = get_local_buffer();
+	ProfileEvent event;
+	event.name = name;
+	event.wall = -1;
+	event.node = local_node;
+	event.parent = buffer->current;
+	event.cpu = thread_cpu_ns();
+	event.start = wall_clock_ns();
+	index = buffer->events.size();
+	buffer->events.push_back(event);
+	buffer->current = index;
+}
+
+
+void ProfileScope::finish()
+{
+	int64_t now = wall_clock_ns();
+	int64_t cpu_now = thread_cpu_ns();
+	ProfileThreadBuffer* buffer = local_buffer;
+	assert(buffer != NULL && index < (int) buffer->events.size());
+	ProfileEvent& event = buffer->events[index];
+	event.wall = now - event.start;
+	event.cpu = cpu_now - event.cpu;
+	buffer->current = event.parent;
+}
+
+
+bool profiler_write_chrome_trace(const char* filename)
+{
+	FILE* out = fopen(filename, "w");
+	if (out == NULL) {
+		return false;
+	}
+
+	lock_guard<mutex> guard(buffers_lock);
+	fprintf(out, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[");
+	bool first = true;
+
+	// Name each process after its branch-and-bound node; scopes outside of any node go to process 0
+	set<long long> nodes;
+	for (ProfileThreadBuffer* buffer : buffers) {
+		for (const ProfileEvent& event : buffer->events) {
+			nodes.insert(event.node);
+		}
+	}
+	for (long long node : nodes) {
+		fprintf(out, "%s\n{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":%lld,\"args\":{\"name\":", first ? "" : ",",
+		        node < 0 ? 0 : node);
+		if (node < 0) {
+			fprintf(out, "\"no node\"}}");
+		} else {
+			fprintf(out, "\"B&B node %lld\"}}", node);
+		}
+		fprintf(out, ",\n{\"name\":\"process_sort_index\",\"ph\":\"M\",\"pid\":%lld,\"args\":{\"sort_index\":%lld}}",
+		        node < 0 ? 0 : node, node < 0 ? 0 : node);
+		first = false;
+	}
+
+	for (ProfileThreadBuffer* buffer : buffers) {
+		for (const ProfileEvent& event : buffer->events) {
+			if (event.wall < 0) {
+				continue; // still open
+			}
+			fprintf(out, "%s\n{\"name\":\"%s\",\"cat\":\"ddopt\",\"ph\":\"X\",\"pid\":%lld,\"tid\":%d,\"ts\":%.3f,"
+			        "\"dur\":%.3f,\"args\":{\"cpu_us\":%.3f}}", first ? "" : ",", event.name,
+			        event.node < 0 ? 0 : event.node, buffer->tid, (event.start - origin) / 1e3, event.wall / 1e3,
+			        event.cpu / 1e3);
+			first = false;
+		}
+	}
+
+	fprintf(out, "\n]}\n");
+	bool ok = !ferror(out);
+	fclose(out);
+	return ok;
+}
+
+
+void profiler_print_summary(FILE* out)
+{
+	struct ScopeTotals {
+		long    count = 0;
+		int64_t wall = 0;
+		int64_t cpu = 0;
+	};
+	map<string, ScopeTotals> totals;
+
+	lock_guard<mutex> guard(buffers_lock);
+	for (ProfileThreadBuffer* buffer : buffers) {
+		// Parents precede their children in the buffer, so paths can be built in order
+		vector<string> paths(buffer->events.size());
+		for (int i = 0; i < (int) buffer->events.size(); ++i) {
+			const ProfileEvent& event = buffer->events[i];
+			paths[i] = (event.parent >= 0) ? paths[event.parent] + "/" + event.name : event.name;
+			if (event.wall >= 0) {
+				ScopeTotals& t = totals[paths[i]];
+				t.count++;
+				t.wall += event.wall;
+				t.cpu += event.cpu;
+			}
+		}
+	}
+
+	if (totals.empty()) {
+		return;
+	}
+	fprintf(out, "Profile:\n");
+	fprintf(out, "  %-48s %10s %12s %12s\n", "scope", "calls", "wall (s)", "cpu (s)");
+	for (const auto& entry : totals) {
+		fprintf(out, "  %-48s %10ld %12.6f %12.6f\n", entry.first.c_str(), entry.second.count, entry.second.wall / 1e9,
+		        entry.second.cpu / 1e9);
+	}
+}
+
+
+void profiler_clear()
+{
+	lock_guard<mutex> guard(buffers_lock);
+	for (ProfileThreadBuffer* buffer : buffers) {
+		assert(buffer->current < 0);
+		buffer->events.clear();
+	}
+}
@@ -0,0 +1,86 @@
+/**
+ * Hierarchical profiler: nested timing scopes recorded per thread and exported as a Chrome trace
+ */
+
+#ifndef PROFILER_HPP_
+#define PROFILER_HPP_
+
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+
+using namespace std;
+
+
+extern atomic<bool> profiler_active;     /**< whether scopes are being recorded */
+
+/** Start or stop recording scopes; the first start sets the origin of the timeline */
+void profiler_enable(bool enable);
+
+/** Return whether scopes are being recorded */
+inline bool profiler_enabled()
+{
+	return profiler_active.load(memory_order_relaxed);
+}
+
+/** Set the branch-and-bound node that scopes opened by the calling thread are attributed to (-1 if none) */
+void profiler_set_node(long long node);
+
+/** Return the branch-and-bound node of the calling thread */
+long long profiler_get_node();
+
+/**
+ * Write all recorded scopes in the Chrome trace event format (viewable in chrome://tracing or Perfetto). Each
+ * branch-and-bound node is shown as a separate process and each thread as a thread of it, so every node has its own
+ * timeline. Must not be called while other threads are recording. Returns false if the file cannot be written.
+ */
+bool profiler_write_chrome_trace(const char* filename);
+
+/** Print wall-clock and CPU time aggregated over each path of nested scopes */
+void profiler_print_summary(FILE* out = stdout);
+
+/** Discard all recorded scopes; must not be called while other threads are recording */
+void profiler_clear();
+
+
+/**
+ * Timing scope that records its wall-clock and thread CPU time from construction until end() or destruction, nested
+ * under the innermost open scope of the same thread. Names must be string literals (or otherwise outlive the profiler)
+ * since only the pointer is stored. Scopes cost a single flag check while the profiler is disabled.
+ */
+class ProfileScope
+{
+public:
+	ProfileScope(const char* name) : index(-1)
+	{
+		if (profiler_enabled()) {
+			begin(name);
+		}
+	}
+
+	~ProfileScope()
+	{
+		end();
+	}
+
+	/** Close the scope before its destruction; no effect if already closed */
+	void end()
+	{
+		if (index >= 0) {
+			finish();
+			index = -1;
+		}
+	}
+
+private:
+	int index;                 /**< index of the event in the buffer of the thread, or -1 if not recording */
+
+	void begin(const char* name);
+	void finish();
+
+	ProfileScope(const ProfileScope&) = delete;
+	ProfileScope& operator=(const ProfileScope&) = delete;
+};
+
+
+#endif /* PROFILER_HPP_ */
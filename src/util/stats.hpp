@@ -6,6 +6,8 @@
 #define STATS_HPP_
 
 #include <cassert>
+#include <chrono>
+#include <cstdint>
 #include <cstdlib>
 #include <cstring>
 #include <ctime>
@@ -37,8 +39,27 @@ struct data_t {
 };
 
 
+/** Return monotonic wall-clock time in nanoseconds */
+inline int64_t wall_clock_ns()
+{
+	return chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/** Return CPU time consumed by the calling thread in nanoseconds */
+inline int64_t thread_cpu_ns()
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+	return (int64_t) ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+
 /**
- * Class to collect general statistics on the code
+ * Class to collect general statistics on the code. Timers measure wall-clock time with a steady clock, and the CPU time
+ * of the thread running them is accumulated alongside. A timer must be started and ended by the same thread.
+ *
+ * Statistics are identified by the id returned by register_name; lookups by name go through a map and are meant for
+ * code outside of hot paths.
  */
 class Stats
 {
@@ -49,22 +70,24 @@ public:
 	Stats()
 	{
 		timer_start.reserve(INITIAL_STAT_SIZE);
+		cpu_start.reserve(INITIAL_STAT_SIZE);
 		value.reserve(INITIAL_STAT_SIZE);
+		cpu_value.reserve(INITIAL_STAT_SIZE);
 	}
 
-	/** Register a new statistic. The initial value is 0 by default */
+	/** Register a new statistic and return its id. The initial value is 0 by default */
 	int register_name(const char* name, long int initial_value = 0);
 
 	/** Start timer for a time statistic */
 	void start_timer(const char* name);
 
-	/** End timer for a time statistic, accumulating the result (in seconds) */
+	/** End timer for a time statistic, accumulating the result */
 	void end_timer(const char* name);
 
 	/** Start timer (by id) for a time statistic */
 	void start_timer(int id);
 
-	/** End timer (by id) for a time statistic, accumulating the result (in seconds) */
+	/** End timer (by id) for a time statistic, accumulating the result */
 	void end_timer(int id);
 
 	/** Add value for a numerical statistic by name. Default value to add is 1. */
@@ -79,16 +102,19 @@ public:
 	/** Get value for a statistic*/
 	long int get_value(int id);
 
-	/** Return value (by name) interpreted as time */
+	/** Return value (by name) interpreted as wall-clock time in seconds */
 	double get_time(const char* name);
 
-	/** Return value (by id) interpreted as time */
+	/** Return value (by id) interpreted as wall-clock time in seconds */
 	double get_time(int id);
 
-	/** Return value (by name) interpreted as time, taking current time clock for measure */
+	/** Return accumulated thread CPU time (by id) of a time statistic in seconds */
+	double get_cpu_time(int id);
+
+	/** Return wall-clock time (by name) in seconds since the timer was last started */
 	double get_current_time(const char* name);
 
-	/** Return value (by id) interpreted as time, taking current time clock for measure */
+	/** Return wall-clock time (by id) in seconds since the timer was last started */
 	double get_current_time(int id);
 
 	/** Return id of name */
@@ -97,8 +123,10 @@ public:
 private:
 
 	map<const char*, data_t, ltstr>  name_to_id;     /**< map from name to stat identifier */
-	vector<clock_t>                  timer_start;    /**< timer start for statistic */
-	vector<long int>                 value;          /**< statistic value */
+	vector<int64_t>                  timer_start;    /**< wall-clock timer start for statistic (ns) */
+	vector<int64_t>                  cpu_start;      /**< thread CPU timer start for statistic (ns) */
+	vector<long int>                 value;          /**< statistic value; wall-clock time in ns for timers */
+	vector<int64_t>                  cpu_value;      /**< accumulated thread CPU time for timers (ns) */
 };
 
 
@@ -116,7 +144,9 @@ inline int Stats::register_name(const char* name, long int initial_value)
 {
 	name_to_id[name].id = value.size();
 	value.push_back(initial_value);
-	timer_start.push_back(clock());
+	cpu_value.push_back(0);
+	timer_start.push_back(wall_clock_ns());
+	cpu_start.push_back(0);
 	return value.size()-1;
 }
 
@@ -136,11 +166,12 @@ inline void Stats::start_timer(const char* name)
 inline void Stats::start_timer(int id)
 {
 	assert(id >= 0 && id < (int)value.size());
-	timer_start[id] = clock();
+	cpu_start[id] = thread_cpu_ns();
+	timer_start[id] = wall_clock_ns();
 }
 
 /**
- * End the timer for a statistic, accumulating the result (in seconds)
+ * End the timer for a statistic, accumulating the result
  */
 inline void Stats::end_timer(const char* name)
 {
@@ -148,12 +179,13 @@ inline void Stats::end_timer(const char* name)
 }
 
 /**
- * End the timer for a statistic (by id), accumulating the result (in seconds)
+ * End the timer for a statistic (by id), accumulating the result
  */
 inline void Stats::end_timer(int id)
 {
 	assert(id >= 0 && id < (int)value.size());
-	value[id] += clock() - timer_start[id];
+	value[id] += wall_clock_ns() - timer_start[id];
+	cpu_value[id] += thread_cpu_ns() - cpu_start[id];
 }
 
 /**
@@ -218,7 +250,7 @@ inline double Stats::get_current_time(const char* name)
 inline double Stats::get_current_time(int id)
 {
 	assert(id >= 0 && id < (int)value.size());
-	return ((double)(clock() - timer_start[id])) / (double)CLOCKS_PER_SEC;
+	return ((double)(wall_clock_ns() - timer_start[id])) / 1e9;
 }
 
 
@@ -228,7 +260,17 @@ inline double Stats::get_current_time(int id)
 inline double Stats::get_time(int id)
 {
 	assert(id >= 0 && id < (int)value.size());
-	return ((double)(value[id])) / (double)CLOCKS_PER_SEC;
+	return ((double)(value[id])) / 1e9;
+}
+
+
+/**
+ * Get accumulated thread CPU time of a time statistic
+ */
+inline double Stats::get_cpu_time(int id)
+{
+	assert(id >= 0 && id < (int)value.size());
+	return ((double)(cpu_value[id])) / 1e9;
 }
 
 
@@ -237,8 +279,9 @@ inline double Stats::get_time(int id)
  */
 inline int Stats::get_id(const char* name)
 {
-	assert(name_to_id[name].id != UNITIALIZED_STAT);
-	return (name_to_id[name].id);
+	map<const char*, data_t, ltstr>::iterator it = name_to_id.find(name);
+	assert(it != name_to_id.end());
+	return (it->second.id);
 }
 
 
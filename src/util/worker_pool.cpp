@@ -0,0 +1,91 @@
+/**
+ * Pool of persistent threads for running batches of small independent tasks
+ */
+
+#include <cassert>
+#include "worker_pool.hpp"
+
+
+WorkerPool::WorkerPool(int nthreads) : task(NULL), ntasks(0), next_task(0), nbusy(0), batch(0), shutdown(false)
+{
+	assert(nthreads >= 0);
+	for (int i = 0; i < nthreads; ++i) {
+		workers.push_back(thread(&WorkerPool::run_worker, this));
+	}
+}
+
+
+WorkerPool::~WorkerPool()
+{
+	{
+		lock_guard<mutex> guard(lock);
+		shutdown = true;
+	}
+	batch_available.notify_all();
+
+	for (thread& worker : workers) {
+		worker.join();
+	}
+}
+
+
+void WorkerPool::run(int _ntasks, const function<void(int)>& _task)
+{
+	if (workers.empty() || _ntasks <= 1) {
+		for (int i = 0; i < _ntasks; ++i) {
+			_task(i);
+		}
+		return;
+	}
+
+	{
+		lock_guard<mutex> guard(lock);
+		task = &_task;
+		ntasks = _ntasks;
+		next_task = 0;
+		nbusy = workers.size();
+		batch++;
+	}
+	batch_available.notify_all();
+
+	run_tasks();
+
+	unique_lock<mutex> guard(lock);
+	batch_done.wait(guard, [this] { return nbusy == 0; });
+	task = NULL;
+}
+
+
+void WorkerPool::run_tasks()
+{
+	int i;
+	while ((i = next_task++) < ntasks) {
+		(*task)(i);
+	}
+}
+
+
+void WorkerPool::run_worker()
+{
+	long last_batch = 0;
+	while (true) {
+		{
+			unique_lock<mutex> guard(lock);
+			batch_available.wait(guard, [this, last_batch] { return shutdown || batch != last_batch; });
+			if (shutdown) {
+				return;
+			}
+			last_batch = batch;
+		}
+
+		run_tasks();
+
+		{
+			lock_guard<mutex> guard(lock);
+			nbusy--;
+			if (nbusy == 0) {
+				batch_done.notify_one();
+			}
+		}
+	}
+}
@@ -0,0 +1,54 @@
+/**
+ * Pool of persistent threads for running batches of small independent tasks
+ */
+
+#ifndef WORKER_POOL_HPP_
+#define WORKER_POOL_HPP_
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+
+/**
+ * Runs batches of tasks indexed 0..ntasks-1 on a fixed set of threads, which wait between batches instead of being
+ * created for each batch. The calling thread also runs tasks, so a pool with zero threads runs them sequentially.
+ */
+class WorkerPool
+{
+public:
+	/** Create a pool with the given number of threads besides the calling thread */
+	WorkerPool(int nthreads);
+
+	~WorkerPool();
+
+	/** Run task(i) for every i in 0..ntasks-1 and return when all are done; not reentrant */
+	void run(int ntasks, const function<void(int)>& task);
+
+private:
+	vector<thread>                workers;
+	mutex                         lock;
+	condition_variable            batch_available;
+	condition_variable            batch_done;
+
+	const function<void(int)>*    task;          /**< task of the current batch */
+	int                           ntasks;        /**< number of tasks of the current batch */
+	atomic<int>                   next_task;     /**< next task index to be taken */
+	int                           nbusy;         /**< number of workers still in the current batch */
+	long                          batch;         /**< number of batches started */
+	bool                          shutdown;
+
+	/** Run tasks of the current batch until none is left */
+	void run_tasks();
+
+	/** Main loop of a worker */
+	void run_worker();
+};
+
+
+#endif /* WORKER_POOL_HPP_ */